@@ -0,0 +1,212 @@
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Archive.hpp"
+#include <algorithm>
+#include <zlib.h>
+
+using namespace Gek;
+
+struct FileEntry
+{
+    FileSystem::Path filePath;
+    std::string name;
+    FileSystem::Archive::Entry entry;
+};
+
+int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const * const environmentVariableList)
+{
+    LockedWrite{ std::cout } << "GEK Archive Creator";
+
+    auto rootPath(FileSystem::GetModuleFilePath().getParentPath().getParentPath());
+    FileSystem::Path inputPath(FileSystem::GetFileName(rootPath, "data"));
+    FileSystem::Path outputPath(FileSystem::GetFileName(rootPath, "data.pak"));
+    uint32_t alignment = 4096;
+    bool compress = true;
+    for (int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+    {
+        std::string argument(String::Narrow(argumentList[argumentIndex]));
+        std::vector<std::string> arguments(String::Split(String::GetLower(argument), ':'));
+        if (arguments.empty())
+        {
+            LockedWrite{ std::cerr } << "No arguments specified for command line parameter";
+            return -__LINE__;
+        }
+
+        if (arguments[0] == "-input" && ++argumentIndex < argumentCount)
+        {
+            inputPath = argumentList[argumentIndex];
+        }
+        else if (arguments[0] == "-output" && ++argumentIndex < argumentCount)
+        {
+            outputPath = argumentList[argumentIndex];
+        }
+        else if (arguments[0] == "-align")
+        {
+            if (arguments.size() != 2)
+            {
+                LockedWrite{ std::cerr } << "Missing parameters for align";
+                return -__LINE__;
+            }
+
+            alignment = String::Convert(arguments[1], 4096U);
+            if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+            {
+                LockedWrite{ std::cerr } << "Alignment must be a power of two";
+                return -__LINE__;
+            }
+        }
+        else if (arguments[0] == "-nocompress")
+        {
+            compress = false;
+        }
+    }
+
+    if (!inputPath.isDirectory())
+    {
+        LockedWrite{ std::cerr } << String::Format("Input directory not found: %v", inputPath.u8string());
+        return -__LINE__;
+    }
+
+    // Names are stored relative to the parent of the input, the engine mounts archives at its root
+    auto baseName(FileSystem::Archive::GetNormalizedName(inputPath.getParentPath().u8string()));
+    auto outputName(FileSystem::Archive::GetNormalizedName(outputPath.u8string()));
+
+    std::vector<FileEntry> fileList;
+    std::function<bool(FileSystem::Path const &)> findFiles;
+    findFiles = [&](FileSystem::Path const &filePath) -> bool
+    {
+        if (filePath.isDirectory())
+        {
+            FileSystem::Find(filePath, findFiles);
+        }
+        else if (filePath.isFile())
+        {
+            auto fileName(FileSystem::Archive::GetNormalizedName(filePath.u8string()));
+            if (fileName != outputName && String::GetLower(filePath.getExtension()) != ".pak")
+            {
+                FileEntry fileEntry;
+                fileEntry.filePath = filePath;
+                fileEntry.name = (baseName.empty() ? fileName : fileName.substr(baseName.size() + 1));
+                fileList.push_back(fileEntry);
+            }
+        }
+
+        return true;
+    };
+
+    FileSystem::Find(inputPath, findFiles);
+    if (fileList.empty())
+    {
+        LockedWrite{ std::cerr } << String::Format("No files found in input directory: %v", inputPath.u8string());
+        return -__LINE__;
+    }
+
+    // Keep files from the same directory next to each other in the data
+    std::sort(std::begin(fileList), std::end(fileList), [](FileEntry const &leftEntry, FileEntry const &rightEntry) -> bool
+    {
+        return (leftEntry.name < rightEntry.name);
+    });
+
+    std::string nameTable;
+    for (auto &fileEntry : fileList)
+    {
+        fileEntry.entry.hash = FileSystem::Archive::GetNameHash(fileEntry.name);
+        fileEntry.entry.nameOffset = uint32_t(nameTable.size());
+        nameTable.append(fileEntry.name);
+        nameTable.push_back('\0');
+    }
+
+    FileSystem::Archive::Header header;
+    header.alignment = alignment;
+    header.entryCount = uint32_t(fileList.size());
+    header.nameTableSize = uint32_t(nameTable.size());
+
+    auto alignOffset = [alignment](uint64_t offset) -> uint64_t
+    {
+        return ((offset + (alignment - 1)) & ~uint64_t(alignment - 1));
+    };
+
+    uint64_t indexSize = (sizeof(FileSystem::Archive::Header) + (sizeof(FileSystem::Archive::Entry) * fileList.size()) + nameTable.size());
+    uint64_t dataOffset = alignOffset(indexSize);
+
+    FileSystem::MakeDirectoryChain(outputPath.getParentPath());
+    FILE *file = fopen(outputPath.u8string().c_str(), "wb");
+    if (file == nullptr)
+    {
+        LockedWrite{ std::cerr } << String::Format("Unable to create output file: %v", outputPath.u8string());
+        return -__LINE__;
+    }
+
+    // Leave room for the index, it's written once all the entry offsets are known
+    static const std::vector<uint8_t> Padding(alignment, 0);
+    std::vector<uint8_t> indexPadding(size_t(dataOffset), 0);
+    fwrite(indexPadding.data(), indexPadding.size(), 1, file);
+
+    uint64_t totalSize = 0;
+    uint64_t totalPackedSize = 0;
+    for (auto &fileEntry : fileList)
+    {
+        static const std::vector<uint8_t> EmptyBuffer;
+        std::vector<uint8_t> buffer(FileSystem::Load(fileEntry.filePath, EmptyBuffer));
+
+        std::vector<uint8_t> packedBuffer;
+        auto extension(String::GetLower(fileEntry.filePath.getExtension()));
+        bool alreadyCompressed = (extension == ".png" || extension == ".jpg" || extension == ".jpeg");
+        if (compress && !alreadyCompressed && !buffer.empty())
+        {
+            uLongf packedSize = compressBound(uLong(buffer.size()));
+            packedBuffer.resize(packedSize);
+            if (compress2(packedBuffer.data(), &packedSize, buffer.data(), uLong(buffer.size()), Z_BEST_COMPRESSION) == Z_OK &&
+                packedSize < (buffer.size() - (buffer.size() / 10)))
+            {
+                packedBuffer.resize(packedSize);
+                fileEntry.entry.flags |= FileSystem::Archive::Entry::Flags::Compressed;
+            }
+            else
+            {
+                packedBuffer.clear();
+            }
+        }
+
+        auto const &data = (packedBuffer.empty() ? buffer : packedBuffer);
+        fileEntry.entry.offset = dataOffset;
+        fileEntry.entry.size = buffer.size();
+        fileEntry.entry.packedSize = data.size();
+        if (!data.empty())
+        {
+            fwrite(data.data(), data.size(), 1, file);
+        }
+
+        auto nextOffset = alignOffset(dataOffset + data.size());
+        if (nextOffset > (dataOffset + data.size()))
+        {
+            fwrite(Padding.data(), size_t(nextOffset - (dataOffset + data.size())), 1, file);
+        }
+
+        dataOffset = nextOffset;
+        totalSize += fileEntry.entry.size;
+        totalPackedSize += fileEntry.entry.packedSize;
+        LockedWrite{ std::cout } << String::Format("> %v: %v bytes, %v packed%v", fileEntry.name, fileEntry.entry.size, fileEntry.entry.packedSize, (fileEntry.entry.flags & FileSystem::Archive::Entry::Flags::Compressed ? ", compressed" : ""));
+    }
+
+    std::vector<FileSystem::Archive::Entry> entryList;
+    entryList.reserve(fileList.size());
+    for (auto const &fileEntry : fileList)
+    {
+        entryList.push_back(fileEntry.entry);
+    }
+
+    std::stable_sort(std::begin(entryList), std::end(entryList), [](FileSystem::Archive::Entry const &leftEntry, FileSystem::Archive::Entry const &rightEntry) -> bool
+    {
+        return (leftEntry.hash < rightEntry.hash);
+    });
+
+    fseek(file, 0, SEEK_SET);
+    fwrite(&header, sizeof(FileSystem::Archive::Header), 1, file);
+    fwrite(entryList.data(), sizeof(FileSystem::Archive::Entry), entryList.size(), file);
+    fwrite(nameTable.data(), nameTable.size(), 1, file);
+    fclose(file);
+
+    LockedWrite{ std::cout } << String::Format("Archive created: %v, %v files, %v bytes, %v packed", outputPath.u8string(), fileList.size(), totalSize, totalPackedSize);
+    return 0;
+}
@@ -0,0 +1,248 @@
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Context.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include "GEK/Engine/Core.hpp"
+#include "GEK/Engine/Population.hpp"
+#include <algorithm>
+#include <limits>
+#include <map>
+
+using namespace Gek;
+
+struct Statistics
+{
+    uint64_t total = 0;
+    uint64_t minimum = std::numeric_limits<uint64_t>::max();
+    uint64_t maximum = 0;
+
+    void add(uint64_t value)
+    {
+        total += value;
+        minimum = std::min(minimum, value);
+        maximum = std::max(maximum, value);
+    }
+
+    JSON::Object getObject(uint32_t frameCount) const
+    {
+        JSON::Object object;
+        object["total"] = total;
+        object["average"] = (frameCount > 0 ? (double(total) / double(frameCount)) : 0.0);
+        object["minimum"] = (frameCount > 0 ? minimum : 0);
+        object["maximum"] = maximum;
+        return object;
+    }
+};
+
+int wmain(int argumentCount, wchar_t const * const argumentList[], wchar_t const * const environmentVariableList)
+{
+    LockedWrite{ std::cout } << "GEK Headless Engine";
+
+    std::string sceneName;
+    FileSystem::Path outputPath;
+    uint32_t frameCount = 600;
+    uint32_t warmupCount = 60;
+    float frameTime = (1.0f / 60.0f);
+    for (int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+    {
+        std::string argument(String::Narrow(argumentList[argumentIndex]));
+        std::vector<std::string> arguments(String::Split(String::GetLower(argument), ':'));
+        if (arguments.empty())
+        {
+            LockedWrite{ std::cerr } << "No arguments specified for command line parameter";
+            return -__LINE__;
+        }
+
+        if (arguments[0] == "-scene" && ++argumentIndex < argumentCount)
+        {
+            sceneName = String::Narrow(argumentList[argumentIndex]);
+        }
+        else if (arguments[0] == "-output" && ++argumentIndex < argumentCount)
+        {
+            outputPath = argumentList[argumentIndex];
+        }
+        else if (arguments[0] == "-frames")
+        {
+            if (arguments.size() != 2)
+            {
+                LockedWrite{ std::cerr } << "Missing parameters for frames";
+                return -__LINE__;
+            }
+
+            frameCount = String::Convert(arguments[1], frameCount);
+        }
+        else if (arguments[0] == "-warmup")
+        {
+            if (arguments.size() != 2)
+            {
+                LockedWrite{ std::cerr } << "Missing parameters for warmup";
+                return -__LINE__;
+            }
+
+            warmupCount = String::Convert(arguments[1], warmupCount);
+        }
+        else if (arguments[0] == "-frametime")
+        {
+            if (arguments.size() != 2)
+            {
+                LockedWrite{ std::cerr } << "Missing parameters for frameTime";
+                return -__LINE__;
+            }
+
+            frameTime = String::Convert(arguments[1], frameTime);
+        }
+    }
+
+    if (sceneName.empty())
+    {
+        LockedWrite{ std::cerr } << "No scene specified, use -scene <name> to run a scene from data/scenes";
+        return -__LINE__;
+    }
+
+    auto pluginPath(FileSystem::GetModuleFilePath().getParentPath());
+    auto rootPath(pluginPath.getParentPath());
+
+    std::vector<FileSystem::Path> searchPathList;
+    searchPathList.push_back(pluginPath);
+
+    ContextPtr context(Context::Create(rootPath, searchPathList));
+    if (outputPath.empty())
+    {
+        outputPath = context->getRootFileName(String::Format("%v.performance.json", sceneName));
+    }
+
+    JSON::Object results;
+    if (true)
+    {
+        // The core takes ownership of the window it's given
+        Window::Description description;
+        description.initialWidth = 1920;
+        description.initialHeight = 1080;
+        auto window = context->createClass<Window>("Null::System::Window", description);
+        Plugin::CorePtr core(context->createClass<Plugin::Core>("Engine::Core", window.release()));
+        auto recordingDevice = dynamic_cast<Video::Recording::Device *>(core->getVideoDevice());
+        if (!recordingDevice)
+        {
+            LockedWrite{ std::cerr } << "Headless engine isn't using a recording video device";
+            return -__LINE__;
+        }
+
+        // Deterministic populations advance by the fixed frame time whatever the measured frame time is
+        core->setOption("population", "deterministic", true);
+        core->setOption("population", "frameTime", frameTime);
+
+        auto population = core->getPopulation();
+        population->load(sceneName);
+        while (population->isLoading())
+        {
+            core->update();
+        };
+
+        // Resources finish loading in the background, give them a few frames before measuring
+        for (uint32_t frame = 0; frame < warmupCount; ++frame)
+        {
+            core->update();
+        }
+
+        LockedWrite{ std::cout } << String::Format("Running %v frames of %v", frameCount, sceneName);
+
+        Profiler::SetEnabled(true);
+        Profiler::Clear();
+        recordingDevice->resetCounters();
+
+        // Summaries are collected every frame, so long runs aren't limited by the size of the profiler's buffers
+        std::map<std::string, Profiler::ZoneSummary> zoneMap;
+        Statistics drawCallStatistics, instanceStatistics, primitiveStatistics, dispatchStatistics;
+        Statistics allocationStatisticsList[static_cast<uint8_t>(Memory::Tag::Count)];
+        uint32_t framesRun = 0;
+        for (; framesRun < frameCount; ++framesRun)
+        {
+            if (!core->update())
+            {
+                break;
+            }
+
+            for (auto const &summary : Profiler::GetZoneSummary())
+            {
+                auto &zone = zoneMap[summary.name];
+                zone.count += summary.count;
+                zone.totalTime += summary.totalTime;
+                zone.maximumTime = std::max(zone.maximumTime, summary.maximumTime);
+            }
+
+            Profiler::Clear();
+
+            auto const &counters = recordingDevice->getFrameCounters();
+            drawCallStatistics.add(counters.drawCallCount);
+            instanceStatistics.add(counters.instanceCount);
+            primitiveStatistics.add(counters.primitiveCount);
+            dispatchStatistics.add(counters.dispatchCount);
+
+            for (uint8_t tag = 0; tag < static_cast<uint8_t>(Memory::Tag::Count); ++tag)
+            {
+                allocationStatisticsList[tag].add(Memory::GetCounters(static_cast<Memory::Tag>(tag)).frameAllocationCount);
+            }
+        }
+
+        Profiler::SetEnabled(false);
+
+        // Every frame runs at least the core's zones, results without any would compare as free
+        if (zoneMap.empty())
+        {
+            LockedWrite{ std::cerr } << String::Format("No profiler zones recorded after %v frames of %v", framesRun, sceneName);
+            return -__LINE__;
+        }
+
+        JSON::Object zones;
+        for (auto const &zonePair : zoneMap)
+        {
+            auto const &zone = zonePair.second;
+            JSON::Object zoneNode;
+            zoneNode["count"] = zone.count;
+            zoneNode["totalTime"] = zone.totalTime;
+            zoneNode["frameTime"] = (framesRun > 0 ? (zone.totalTime / framesRun) : 0.0);
+            zoneNode["maximumTime"] = zone.maximumTime;
+            zones[zonePair.first] = zoneNode;
+
+            LockedWrite{ std::cout } << String::Format("%v: %vms per frame, %vms maximum", zonePair.first, (framesRun > 0 ? (zone.totalTime / framesRun) : 0.0), zone.maximumTime);
+        }
+
+        JSON::Object video;
+        video["drawCalls"] = drawCallStatistics.getObject(framesRun);
+        video["instances"] = instanceStatistics.getObject(framesRun);
+        video["primitives"] = primitiveStatistics.getObject(framesRun);
+        video["dispatches"] = dispatchStatistics.getObject(framesRun);
+
+        LockedWrite{ std::cout } << String::Format("Draw calls: %v per frame, Instances: %v per frame",
+            (framesRun > 0 ? (drawCallStatistics.total / framesRun) : 0),
+            (framesRun > 0 ? (instanceStatistics.total / framesRun) : 0));
+
+        JSON::Object memory;
+        for (uint8_t tag = 0; tag < static_cast<uint8_t>(Memory::Tag::Count); ++tag)
+        {
+            auto counters = Memory::GetCounters(static_cast<Memory::Tag>(tag));
+            JSON::Object tagNode;
+            tagNode["currentSize"] = counters.currentSize;
+            tagNode["peakSize"] = counters.peakSize;
+            tagNode["allocations"] = allocationStatisticsList[tag].getObject(framesRun);
+            memory[Memory::GetTagName(static_cast<Memory::Tag>(tag))] = tagNode;
+
+            LockedWrite{ std::cout } << String::Format("%v memory: %vKB, %vKB peak", Memory::GetTagName(static_cast<Memory::Tag>(tag)), (counters.currentSize / 1024), (counters.peakSize / 1024));
+        }
+
+        results["scene"] = sceneName;
+        results["frames"] = framesRun;
+        results["frameTime"] = frameTime;
+        results["zones"] = zones;
+        results["video"] = video;
+        results["memory"] = memory;
+        results["globalAllocationsTracked"] = Memory::IsTrackingGlobalAllocations();
+    }
+
+    JSON::Reference(results).save(outputPath);
+    LockedWrite{ std::cout } << String::Format("Results saved to %v", outputPath.u8string());
+    return 0;
+}
@@ -0,0 +1,558 @@
+#include "GEK/Math/Batch.hpp"
+#include <immintrin.h>
+#include <intrin.h>
+#include <algorithm>
+#include <cmath>
+
+namespace Gek
+{
+    namespace Math
+    {
+        namespace Batch
+        {
+            // Each lane type wraps one register width with the operators the kernels use, so a single
+            // kernel body produces the scalar, SSE4 and AVX2 versions with an identical order of operations
+            struct ScalarLane
+            {
+                static const size_t Width = 1;
+                using Mask = bool;
+
+                float value;
+
+                static ScalarLane Load(float const *data)
+                {
+                    return { *data };
+                }
+
+                static ScalarLane Set(float value)
+                {
+                    return { value };
+                }
+
+                void store(float *data) const
+                {
+                    *data = value;
+                }
+
+                static ScalarLane Sqrt(ScalarLane const &lane)
+                {
+                    return { std::sqrt(lane.value) };
+                }
+
+                static ScalarLane Abs(ScalarLane const &lane)
+                {
+                    return { std::abs(lane.value) };
+                }
+
+                static Mask LessThan(ScalarLane const &left, ScalarLane const &right)
+                {
+                    return (left.value < right.value);
+                }
+
+                static Mask Equal(ScalarLane const &left, ScalarLane const &right)
+                {
+                    return (left.value == right.value);
+                }
+
+                static ScalarLane Select(Mask mask, ScalarLane const &trueLane, ScalarLane const &falseLane)
+                {
+                    return (mask ? trueLane : falseLane);
+                }
+
+                static void LoadMatrices(Float4x4 const *matrixList, ScalarLane element[16])
+                {
+                    for (size_t index = 0; index < 16; ++index)
+                    {
+                        element[index].value = matrixList->data[index];
+                    }
+                }
+
+                static void StoreMatrices(ScalarLane const element[16], Float4x4 *matrixList)
+                {
+                    for (size_t index = 0; index < 16; ++index)
+                    {
+                        matrixList->data[index] = element[index].value;
+                    }
+                }
+
+                ScalarLane operator - (void) const { return { -value }; }
+                ScalarLane operator + (ScalarLane const &lane) const { return { value + lane.value }; }
+                ScalarLane operator - (ScalarLane const &lane) const { return { value - lane.value }; }
+                ScalarLane operator * (ScalarLane const &lane) const { return { value * lane.value }; }
+                ScalarLane operator / (ScalarLane const &lane) const { return { value / lane.value }; }
+            };
+
+            struct SSELane
+            {
+                static const size_t Width = 4;
+                using Mask = __m128;
+
+                __m128 value;
+
+                static SSELane Load(float const *data)
+                {
+                    return { _mm_loadu_ps(data) };
+                }
+
+                static SSELane Set(float value)
+                {
+                    return { _mm_set_ps1(value) };
+                }
+
+                void store(float *data) const
+                {
+                    _mm_storeu_ps(data, value);
+                }
+
+                static SSELane Sqrt(SSELane const &lane)
+                {
+                    return { _mm_sqrt_ps(lane.value) };
+                }
+
+                static SSELane Abs(SSELane const &lane)
+                {
+                    return { _mm_andnot_ps(_mm_set_ps1(-0.0f), lane.value) };
+                }
+
+                static Mask LessThan(SSELane const &left, SSELane const &right)
+                {
+                    return _mm_cmplt_ps(left.value, right.value);
+                }
+
+                static Mask Equal(SSELane const &left, SSELane const &right)
+                {
+                    return _mm_cmpeq_ps(left.value, right.value);
+                }
+
+                static SSELane Select(Mask mask, SSELane const &trueLane, SSELane const &falseLane)
+                {
+                    return { _mm_blendv_ps(falseLane.value, trueLane.value, mask) };
+                }
+
+                // Four matrices transposed so each register holds one element of all four
+                static void LoadMatrices(Float4x4 const *matrixList, SSELane element[16])
+                {
+                    for (size_t row = 0; row < 4; ++row)
+                    {
+                        __m128 first = _mm_loadu_ps(matrixList[0].rows[row].data);
+                        __m128 second = _mm_loadu_ps(matrixList[1].rows[row].data);
+                        __m128 third = _mm_loadu_ps(matrixList[2].rows[row].data);
+                        __m128 fourth = _mm_loadu_ps(matrixList[3].rows[row].data);
+                        _MM_TRANSPOSE4_PS(first, second, third, fourth);
+                        element[(row * 4) + 0].value = first;
+                        element[(row * 4) + 1].value = second;
+                        element[(row * 4) + 2].value = third;
+                        element[(row * 4) + 3].value = fourth;
+                    }
+                }
+
+                static void StoreMatrices(SSELane const element[16], Float4x4 *matrixList)
+                {
+                    for (size_t row = 0; row < 4; ++row)
+                    {
+                        __m128 first = element[(row * 4) + 0].value;
+                        __m128 second = element[(row * 4) + 1].value;
+                        __m128 third = element[(row * 4) + 2].value;
+                        __m128 fourth = element[(row * 4) + 3].value;
+                        _MM_TRANSPOSE4_PS(first, second, third, fourth);
+                        _mm_storeu_ps(matrixList[0].rows[row].data, first);
+                        _mm_storeu_ps(matrixList[1].rows[row].data, second);
+                        _mm_storeu_ps(matrixList[2].rows[row].data, third);
+                        _mm_storeu_ps(matrixList[3].rows[row].data, fourth);
+                    }
+                }
+
+                SSELane operator - (void) const { return { _mm_xor_ps(value, _mm_set_ps1(-0.0f)) }; }
+                SSELane operator + (SSELane const &lane) const { return { _mm_add_ps(value, lane.value) }; }
+                SSELane operator - (SSELane const &lane) const { return { _mm_sub_ps(value, lane.value) }; }
+                SSELane operator * (SSELane const &lane) const { return { _mm_mul_ps(value, lane.value) }; }
+                SSELane operator / (SSELane const &lane) const { return { _mm_div_ps(value, lane.value) }; }
+            };
+
+            struct AVXLane
+            {
+                static const size_t Width = 8;
+                using Mask = __m256;
+
+                __m256 value;
+
+                static AVXLane Load(float const *data)
+                {
+                    return { _mm256_loadu_ps(data) };
+                }
+
+                static AVXLane Set(float value)
+                {
+                    return { _mm256_set1_ps(value) };
+                }
+
+                void store(float *data) const
+                {
+                    _mm256_storeu_ps(data, value);
+                }
+
+                static AVXLane Sqrt(AVXLane const &lane)
+                {
+                    return { _mm256_sqrt_ps(lane.value) };
+                }
+
+                static AVXLane Abs(AVXLane const &lane)
+                {
+                    return { _mm256_andnot_ps(_mm256_set1_ps(-0.0f), lane.value) };
+                }
+
+                static Mask LessThan(AVXLane const &left, AVXLane const &right)
+                {
+                    return _mm256_cmp_ps(left.value, right.value, _CMP_LT_OQ);
+                }
+
+                static Mask Equal(AVXLane const &left, AVXLane const &right)
+                {
+                    return _mm256_cmp_ps(left.value, right.value, _CMP_EQ_OQ);
+                }
+
+                static AVXLane Select(Mask mask, AVXLane const &trueLane, AVXLane const &falseLane)
+                {
+                    return { _mm256_blendv_ps(falseLane.value, trueLane.value, mask) };
+                }
+
+                // Two groups of four transposed matrices, one in each half of the registers
+                static void LoadMatrices(Float4x4 const *matrixList, AVXLane element[16])
+                {
+                    SSELane lower[16];
+                    SSELane upper[16];
+                    SSELane::LoadMatrices(&matrixList[0], lower);
+                    SSELane::LoadMatrices(&matrixList[4], upper);
+                    for (size_t index = 0; index < 16; ++index)
+                    {
+                        element[index].value = _mm256_insertf128_ps(_mm256_castps128_ps256(lower[index].value), upper[index].value, 1);
+                    }
+                }
+
+                static void StoreMatrices(AVXLane const element[16], Float4x4 *matrixList)
+                {
+                    SSELane lower[16];
+                    SSELane upper[16];
+                    for (size_t index = 0; index < 16; ++index)
+                    {
+                        lower[index].value = _mm256_castps256_ps128(element[index].value);
+                        upper[index].value = _mm256_extractf128_ps(element[index].value, 1);
+                    }
+
+                    SSELane::StoreMatrices(lower, &matrixList[0]);
+                    SSELane::StoreMatrices(upper, &matrixList[4]);
+                }
+
+                AVXLane operator - (void) const { return { _mm256_xor_ps(value, _mm256_set1_ps(-0.0f)) }; }
+                AVXLane operator + (AVXLane const &lane) const { return { _mm256_add_ps(value, lane.value) }; }
+                AVXLane operator - (AVXLane const &lane) const { return { _mm256_sub_ps(value, lane.value) }; }
+                AVXLane operator * (AVXLane const &lane) const { return { _mm256_mul_ps(value, lane.value) }; }
+                AVXLane operator / (AVXLane const &lane) const { return { _mm256_div_ps(value, lane.value) }; }
+            };
+
+            Instructions GetSupportedInstructions(void)
+            {
+                static const Instructions supportedInstructions = [](void) -> Instructions
+                {
+                    int registers[4];
+                    __cpuid(registers, 0);
+                    auto highestFunction = registers[0];
+
+                    __cpuid(registers, 1);
+                    bool hasSSE4 = ((registers[2] & (1 << 19)) != 0);
+                    bool hasOSXSave = ((registers[2] & (1 << 27)) != 0);
+                    bool hasAVX = ((registers[2] & (1 << 28)) != 0);
+
+                    // The operating system has to save the upper halves of the registers for AVX to be usable
+                    bool hasAVX2 = false;
+                    if (hasOSXSave && hasAVX && highestFunction >= 7 && (_xgetbv(0) & 6) == 6)
+                    {
+                        __cpuidex(registers, 7, 0);
+                        hasAVX2 = ((registers[1] & (1 << 5)) != 0);
+                    }
+
+                    return (hasAVX2 ? Instructions::AVX2 : (hasSSE4 ? Instructions::SSE4 : Instructions::Scalar));
+                }();
+
+                return supportedInstructions;
+            }
+
+            // Runs the kernel over the widest blocks available, then narrower ones for whatever is left,
+            // the kernel receives a default constructed lane to select its width
+            template <typename KERNEL>
+            void Dispatch(size_t count, Instructions instructions, KERNEL &&kernel)
+            {
+                auto supportedInstructions = GetSupportedInstructions();
+                if (instructions == Instructions::Best || instructions > supportedInstructions)
+                {
+                    instructions = supportedInstructions;
+                }
+
+                size_t index = 0;
+                if (instructions == Instructions::AVX2)
+                {
+                    for (; (index + AVXLane::Width) <= count; index += AVXLane::Width)
+                    {
+                        kernel(AVXLane(), index);
+                    }
+
+                    _mm256_zeroupper();
+                }
+
+                if (instructions >= Instructions::SSE4)
+                {
+                    for (; (index + SSELane::Width) <= count; index += SSELane::Width)
+                    {
+                        kernel(SSELane(), index);
+                    }
+                }
+
+                for (; index < count; ++index)
+                {
+                    kernel(ScalarLane(), index);
+                }
+            }
+
+            // Matches Float4x4::setRotation followed by MakeScaling(scale) * matrix
+            template <typename LANE>
+            void MakeMatrices(TransformStreams const &transformStreams, size_t index, LANE element[16])
+            {
+                const auto Zero = LANE::Set(0.0f);
+                const auto One = LANE::Set(1.0f);
+                const auto Two = LANE::Set(2.0f);
+
+                auto x = LANE::Load(&transformStreams.rotationX[index]);
+                auto y = LANE::Load(&transformStreams.rotationY[index]);
+                auto z = LANE::Load(&transformStreams.rotationZ[index]);
+                auto w = LANE::Load(&transformStreams.rotationW[index]);
+
+                auto xx = (x * x);
+                auto yy = (y * y);
+                auto zz = (z * z);
+                auto ww = (w * w);
+                auto length = (xx + yy + zz + ww);
+                auto determinant = (One / length);
+                auto xy = (x * y);
+                auto xz = (x * z);
+                auto xw = (x * w);
+                auto yz = (y * z);
+                auto yw = (y * w);
+                auto zw = (z * w);
+
+                // A zero length rotation becomes the identity, like the scalar version
+                auto isZero = LANE::Equal(length, Zero);
+                element[0] = LANE::Select(isZero, One, ((xx - yy - zz + ww) * determinant));
+                element[1] = LANE::Select(isZero, Zero, (Two * (xy + zw) * determinant));
+                element[2] = LANE::Select(isZero, Zero, (Two * (xz - yw) * determinant));
+                element[4] = LANE::Select(isZero, Zero, (Two * (xy - zw) * determinant));
+                element[5] = LANE::Select(isZero, One, ((-xx + yy - zz + ww) * determinant));
+                element[6] = LANE::Select(isZero, Zero, (Two * (yz + xw) * determinant));
+                element[8] = LANE::Select(isZero, Zero, (Two * (xz + yw) * determinant));
+                element[9] = LANE::Select(isZero, Zero, (Two * (yz - xw) * determinant));
+                element[10] = LANE::Select(isZero, One, ((-xx - yy + zz + ww) * determinant));
+                element[3] = element[7] = element[11] = Zero;
+
+                if (transformStreams.scaleX)
+                {
+                    auto scaleX = LANE::Load(&transformStreams.scaleX[index]);
+                    auto scaleY = LANE::Load(&transformStreams.scaleY[index]);
+                    auto scaleZ = LANE::Load(&transformStreams.scaleZ[index]);
+                    for (size_t column = 0; column < 3; ++column)
+                    {
+                        element[column + 0] = (scaleX * element[column + 0]);
+                        element[column + 4] = (scaleY * element[column + 4]);
+                        element[column + 8] = (scaleZ * element[column + 8]);
+                    }
+                }
+
+                element[12] = LANE::Load(&transformStreams.positionX[index]);
+                element[13] = LANE::Load(&transformStreams.positionY[index]);
+                element[14] = LANE::Load(&transformStreams.positionZ[index]);
+                element[15] = One;
+            }
+
+            void MakeMatrices(size_t count, TransformStreams const &transformStreams, Float4x4 *matrixList, Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    LANE element[16];
+                    MakeMatrices(transformStreams, index, element);
+                    LANE::StoreMatrices(element, &matrixList[index]);
+                });
+            }
+
+            void MakeMatrices(size_t count, TransformStreams const &transformStreams, float *matrixStreams[16], Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    LANE element[16];
+                    MakeMatrices(transformStreams, index, element);
+                    for (size_t elementIndex = 0; elementIndex < 16; ++elementIndex)
+                    {
+                        element[elementIndex].store(&matrixStreams[elementIndex][index]);
+                    }
+                });
+            }
+
+            // Matches Float4x4::operator *, which sums the four products of each element in pairs
+            template <typename LANE>
+            void Multiply(LANE const left[16], LANE const right[16], LANE result[16])
+            {
+                for (size_t row = 0; row < 4; ++row)
+                {
+                    for (size_t column = 0; column < 4; ++column)
+                    {
+                        result[(row * 4) + column] =
+                            (((left[(row * 4) + 0] * right[column + 0]) + (left[(row * 4) + 1] * right[column + 4])) +
+                            ((left[(row * 4) + 2] * right[column + 8]) + (left[(row * 4) + 3] * right[column + 12])));
+                    }
+                }
+            }
+
+            void Multiply(size_t count, Float4x4 const *leftList, Float4x4 const *rightList, Float4x4 *resultList, Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    LANE left[16], right[16], result[16];
+                    LANE::LoadMatrices(&leftList[index], left);
+                    LANE::LoadMatrices(&rightList[index], right);
+                    Multiply(left, right, result);
+                    LANE::StoreMatrices(result, &resultList[index]);
+                });
+            }
+
+            void Multiply(size_t count, Float4x4 const *leftList, Float4x4 const &right, Float4x4 *resultList, Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    LANE left[16], sharedRight[16], result[16];
+                    for (size_t element = 0; element < 16; ++element)
+                    {
+                        sharedRight[element] = LANE::Set(right.data[element]);
+                    }
+
+                    LANE::LoadMatrices(&leftList[index], left);
+                    Multiply(left, sharedRight, result);
+                    LANE::StoreMatrices(result, &resultList[index]);
+                });
+            }
+
+            // Matches Float4x4::getDeterminant and Float4x4::getInverse term for term
+            template <typename LANE>
+            void Invert(LANE const m[16], LANE result[16])
+            {
+                const auto One = LANE::Set(1.0f);
+                const auto Zero = LANE::Set(0.0f);
+
+                auto determinant = ((m[0] * m[5] - m[4] * m[1]) * (m[10] * m[15] - m[14] * m[11]) - (m[0] * m[9] - m[8] * m[1]) * (m[6] * m[15] - m[14] * m[7]) + (m[0] * m[13] - m[12] * m[1]) * (m[6] * m[11] - m[10] * m[7]) + (m[4] * m[9] - m[8] * m[5]) * (m[2] * m[15] - m[14] * m[3]) - (m[4] * m[13] - m[12] * m[5]) * (m[2] * m[11] - m[10] * m[3]) + (m[8] * m[13] - m[12] * m[9]) * (m[2] * m[7] - m[6] * m[3]));
+                auto isSingular = LANE::LessThan(LANE::Abs(determinant), LANE::Set(Epsilon));
+                determinant = (One / determinant);
+
+                result[0] = (determinant * (m[5] * (m[10] * m[15] - m[14] * m[11]) + m[9] * (m[14] * m[7] - m[6] * m[15]) + m[13] * (m[6] * m[11] - m[10] * m[7])));
+                result[1] = (determinant * (m[9] * (m[2] * m[15] - m[14] * m[3]) + m[13] * (m[10] * m[3] - m[2] * m[11]) + m[1] * (m[14] * m[11] - m[10] * m[15])));
+                result[2] = (determinant * (m[13] * (m[2] * m[7] - m[6] * m[3]) + m[1] * (m[6] * m[15] - m[14] * m[7]) + m[5] * (m[14] * m[3] - m[2] * m[15])));
+                result[3] = (determinant * (m[1] * (m[10] * m[7] - m[6] * m[11]) + m[5] * (m[2] * m[11] - m[10] * m[3]) + m[9] * (m[6] * m[3] - m[2] * m[7])));
+                result[4] = (determinant * (m[6] * (m[8] * m[15] - m[12] * m[11]) + m[10] * (m[12] * m[7] - m[4] * m[15]) + m[14] * (m[4] * m[11] - m[8] * m[7])));
+                result[5] = (determinant * (m[10] * (m[0] * m[15] - m[12] * m[3]) + m[14] * (m[8] * m[3] - m[0] * m[11]) + m[2] * (m[12] * m[11] - m[8] * m[15])));
+                result[6] = (determinant * (m[14] * (m[0] * m[7] - m[4] * m[3]) + m[2] * (m[4] * m[15] - m[12] * m[7]) + m[6] * (m[12] * m[3] - m[0] * m[15])));
+                result[7] = (determinant * (m[2] * (m[8] * m[7] - m[4] * m[11]) + m[6] * (m[0] * m[11] - m[8] * m[3]) + m[10] * (m[4] * m[3] - m[0] * m[7])));
+                result[8] = (determinant * (m[7] * (m[8] * m[13] - m[12] * m[9]) + m[11] * (m[12] * m[5] - m[4] * m[13]) + m[15] * (m[4] * m[9] - m[8] * m[5])));
+                result[9] = (determinant * (m[11] * (m[0] * m[13] - m[12] * m[1]) + m[15] * (m[8] * m[1] - m[0] * m[9]) + m[3] * (m[12] * m[9] - m[8] * m[13])));
+                result[10] = (determinant * (m[15] * (m[0] * m[5] - m[4] * m[1]) + m[3] * (m[4] * m[13] - m[12] * m[5]) + m[7] * (m[12] * m[1] - m[0] * m[13])));
+                result[11] = (determinant * (m[3] * (m[8] * m[5] - m[4] * m[9]) + m[7] * (m[0] * m[9] - m[8] * m[1]) + m[11] * (m[4] * m[1] - m[0] * m[5])));
+                result[12] = (determinant * (m[4] * (m[13] * m[10] - m[9] * m[14]) + m[8] * (m[5] * m[14] - m[13] * m[6]) + m[12] * (m[9] * m[6] - m[5] * m[10])));
+                result[13] = (determinant * (m[8] * (m[13] * m[2] - m[1] * m[14]) + m[12] * (m[1] * m[10] - m[9] * m[2]) + m[0] * (m[9] * m[14] - m[13] * m[10])));
+                result[14] = (determinant * (m[12] * (m[5] * m[2] - m[1] * m[6]) + m[0] * (m[13] * m[6] - m[5] * m[14]) + m[4] * (m[1] * m[14] - m[13] * m[2])));
+                result[15] = (determinant * (m[0] * (m[5] * m[10] - m[9] * m[6]) + m[4] * (m[9] * m[2] - m[1] * m[10]) + m[8] * (m[1] * m[6] - m[5] * m[2])));
+
+                for (size_t element = 0; element < 16; ++element)
+                {
+                    result[element] = LANE::Select(isSingular, (element % 5) ? Zero : One, result[element]);
+                }
+            }
+
+            void Invert(size_t count, Float4x4 const *matrixList, Float4x4 *resultList, Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    LANE matrix[16], result[16];
+                    LANE::LoadMatrices(&matrixList[index], matrix);
+                    Invert(matrix, result);
+                    LANE::StoreMatrices(result, &resultList[index]);
+                });
+            }
+
+            // The interpolation factors need the inverse cosine and sine, which are evaluated per element with the
+            // standard library so they match the scalar version, everything around them stays in registers
+            void GetSlerpFactors(float deltaAngle, float factor, float &factor0, float &factor1)
+            {
+                if ((deltaAngle + 1.0f) > Epsilon)
+                {
+                    if (deltaAngle < 0.995f)
+                    {
+                        float acos = std::acos(deltaAngle);
+                        float sin = std::sin(acos);
+                        float denominator = 1.0f / sin;
+                        factor0 = std::sin((1.0f - factor) * acos) * denominator;
+                        factor1 = std::sin(factor * acos) * denominator;
+                    }
+                    else
+                    {
+                        factor0 = 1.0f - factor;
+                        factor1 = factor;
+                    }
+                }
+                else
+                {
+                    factor0 = std::sin((1.0f - factor) * (Pi * 0.5f));
+                    factor1 = std::sin(factor * (Pi * 0.5f));
+                }
+            }
+
+            void Slerp(size_t count, QuaternionStreams const &from, QuaternionStreams const &to, float const *factorList, QuaternionStreams const &result, Instructions instructions)
+            {
+                Dispatch(count, instructions, [&](auto lane, size_t index) -> void
+                {
+                    using LANE = decltype(lane);
+                    auto fromX = LANE::Load(&from.x[index]);
+                    auto fromY = LANE::Load(&from.y[index]);
+                    auto fromZ = LANE::Load(&from.z[index]);
+                    auto fromW = LANE::Load(&from.w[index]);
+                    auto toX = LANE::Load(&to.x[index]);
+                    auto toY = LANE::Load(&to.y[index]);
+                    auto toZ = LANE::Load(&to.z[index]);
+                    auto toW = LANE::Load(&to.w[index]);
+
+                    float deltaAngleList[LANE::Width];
+                    float factor0List[LANE::Width];
+                    float factor1List[LANE::Width];
+                    ((fromX * toX) + (fromY * toY) + (fromZ * toZ) + (fromW * toW)).store(deltaAngleList);
+                    for (size_t element = 0; element < LANE::Width; ++element)
+                    {
+                        GetSlerpFactors(deltaAngleList[element], factorList[index + element], factor0List[element], factor1List[element]);
+                    }
+
+                    auto factor0 = LANE::Load(factor0List);
+                    auto factor1 = LANE::Load(factor1List);
+                    auto x = ((fromX * factor0) + (toX * factor1));
+                    auto y = ((fromY * factor0) + (toY * factor1));
+                    auto z = ((fromZ * factor0) + (toZ * factor1));
+                    auto w = ((fromW * factor0) + (toW * factor1));
+
+                    auto length = ((x * x) + (y * y) + (z * z) + (w * w));
+                    auto isShort = LANE::LessThan(length, LANE::Set(1.0f - Epsilon));
+                    auto scale = LANE::Select(isShort, (LANE::Set(1.0f) / LANE::Sqrt(length)), LANE::Set(1.0f));
+                    (x * scale).store(&result.x[index]);
+                    (y * scale).store(&result.y[index]);
+                    (z * scale).store(&result.z[index]);
+                    (w * scale).store(&result.w[index]);
+                });
+            }
+        }; // namespace Batch
+    }; // namespace Math
+}; // namespace Gek
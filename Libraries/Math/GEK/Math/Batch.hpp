@@ -0,0 +1,79 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Math/Matrix4x4.hpp"
+#include "GEK/Math/Quaternion.hpp"
+#include <cstdint>
+
+namespace Gek
+{
+    namespace Math
+    {
+        // Kernels that build, combine and interpolate whole arrays of transforms at once
+        //  - inputs are read as structure-of-arrays streams, and worked on as blocks of four or eight elements
+        //  - every kernel evaluates the same operations in the same order as the scalar Math types,
+        //    so results match Float4x4 and Quaternion exactly whichever instruction set is used
+        //  - streams don't need to be aligned, and counts don't need to be a multiple of the block size
+        namespace Batch
+        {
+            enum class Instructions : uint8_t
+            {
+                Scalar = 0,
+                SSE4,
+                AVX2,
+                Best,
+            };
+
+            // Widest instruction set the processor supports, detected once
+            Instructions GetSupportedInstructions(void);
+
+            struct TransformStreams
+            {
+                float const *positionX = nullptr;
+                float const *positionY = nullptr;
+                float const *positionZ = nullptr;
+                float const *rotationX = nullptr;
+                float const *rotationY = nullptr;
+                float const *rotationZ = nullptr;
+                float const *rotationW = nullptr;
+
+                // Optional, transforms are unscaled without them
+                float const *scaleX = nullptr;
+                float const *scaleY = nullptr;
+                float const *scaleZ = nullptr;
+            };
+
+            struct QuaternionStreams
+            {
+                float *x = nullptr;
+                float *y = nullptr;
+                float *z = nullptr;
+                float *w = nullptr;
+            };
+
+            // Same result as Components::Transform::getScaledMatrix, one matrix per element
+            void MakeMatrices(size_t count, TransformStreams const &transformStreams, Float4x4 *matrixList, Instructions instructions = Instructions::Best);
+
+            // Same as above, but each of the sixteen matrix elements goes to its own stream, the layout the culling kernels read
+            void MakeMatrices(size_t count, TransformStreams const &transformStreams, float *matrixStreams[16], Instructions instructions = Instructions::Best);
+
+            // resultList[index] = leftList[index] * rightList[index]
+            void Multiply(size_t count, Float4x4 const *leftList, Float4x4 const *rightList, Float4x4 *resultList, Instructions instructions = Instructions::Best);
+
+            // resultList[index] = leftList[index] * right, used to move a list of world matrices into view space
+            void Multiply(size_t count, Float4x4 const *leftList, Float4x4 const &right, Float4x4 *resultList, Instructions instructions = Instructions::Best);
+
+            // resultList[index] = matrixList[index].getInverse()
+            void Invert(size_t count, Float4x4 const *matrixList, Float4x4 *resultList, Instructions instructions = Instructions::Best);
+
+            // result[index] = from[index].slerp(to[index], factorList[index]), the result may alias either input
+            void Slerp(size_t count, QuaternionStreams const &from, QuaternionStreams const &to, float const *factorList, QuaternionStreams const &result, Instructions instructions = Instructions::Best);
+        }; // namespace Batch
+    }; // namespace Math
+}; // namespace Gek
@@ -0,0 +1,400 @@
+#include "GEK/Utility/Archive.hpp"
+#include "GEK/Utility/String.hpp"
+#include <unordered_set>
+#include <shared_mutex>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <memory>
+#include <zlib.h>
+
+namespace Gek
+{
+    namespace FileSystem
+    {
+        namespace Archive
+        {
+            std::string GetNormalizedName(std::string const &fileName)
+            {
+                std::vector<std::string> segmentList;
+                std::string segment;
+                auto addSegment = [&](void) -> void
+                {
+                    if (segment == "..")
+                    {
+                        if (!segmentList.empty() && segmentList.back() != "..")
+                        {
+                            segmentList.pop_back();
+                        }
+                        else
+                        {
+                            segmentList.push_back(segment);
+                        }
+                    }
+                    else if (!segment.empty() && segment != ".")
+                    {
+                        segmentList.push_back(segment);
+                    }
+
+                    segment.clear();
+                };
+
+                for (auto character : fileName)
+                {
+                    if (character == '/' || character == '\\')
+                    {
+                        addSegment();
+                    }
+                    else
+                    {
+                        segment.push_back(std::tolower(character, String::Locale));
+                    }
+                }
+
+                addSegment();
+
+                std::string normalizedName;
+                if (!fileName.empty() && (fileName.front() == '/' || fileName.front() == '\\'))
+                {
+                    normalizedName.push_back('/');
+                }
+
+                for (auto const &segment : segmentList)
+                {
+                    if (!normalizedName.empty() && normalizedName.back() != '/')
+                    {
+                        normalizedName.push_back('/');
+                    }
+
+                    normalizedName.append(segment);
+                }
+
+                return normalizedName;
+            }
+
+            uint64_t GetNameHash(std::string const &normalizedName)
+            {
+                uint64_t hash = 14695981039346656037ULL;
+                for (auto character : normalizedName)
+                {
+                    hash ^= uint8_t(character);
+                    hash *= 1099511628211ULL;
+                }
+
+                return hash;
+            }
+        }; // namespace Archive
+
+        struct MountedArchive
+        {
+            Path archivePath;
+            std::string mountName;
+            MappedFile mappedFile;
+            Archive::Header const *header = nullptr;
+            Archive::Entry const *entryList = nullptr;
+            char const *nameTable = nullptr;
+            std::unordered_set<std::string> directorySet;
+
+            // Returns the name relative to the mount point, or false if the name is outside of it
+            bool getRelativeName(std::string const &normalizedName, std::string &relativeName) const
+            {
+                if (mountName.empty())
+                {
+                    relativeName = normalizedName;
+                    return true;
+                }
+
+                if (normalizedName.size() > mountName.size() &&
+                    normalizedName[mountName.size()] == '/' &&
+                    normalizedName.compare(0, mountName.size(), mountName) == 0)
+                {
+                    relativeName = normalizedName.substr(mountName.size() + 1);
+                    return true;
+                }
+
+                if (normalizedName == mountName)
+                {
+                    relativeName.clear();
+                    return true;
+                }
+
+                return false;
+            }
+
+            Archive::Entry const *find(std::string const &relativeName) const
+            {
+                auto hash = Archive::GetNameHash(relativeName);
+                auto entryEnd = (entryList + header->entryCount);
+                auto entrySearch = std::lower_bound(entryList, entryEnd, hash, [](Archive::Entry const &entry, uint64_t hash) -> bool
+                {
+                    return (entry.hash < hash);
+                });
+
+                // Different names can share a hash, compare against every entry with a matching hash
+                for (; entrySearch != entryEnd && entrySearch->hash == hash; ++entrySearch)
+                {
+                    if (relativeName == &nameTable[entrySearch->nameOffset])
+                    {
+                        return entrySearch;
+                    }
+                }
+
+                return nullptr;
+            }
+        };
+
+        using MountedArchivePtr = std::unique_ptr<MountedArchive>;
+
+        struct MountState
+        {
+            std::shared_mutex mutex;
+            std::vector<MountedArchivePtr> mountList;
+        };
+
+        // Plugins are pointed at the application's mounts when they're loaded, see SharedState
+        static MountState localMountState;
+        MountState *currentMountState = &localMountState;
+
+        bool Mount(Path const &archivePath, Path const &mountPath)
+        {
+            auto archive = std::make_unique<MountedArchive>();
+            archive->archivePath = archivePath;
+            archive->mountName = Archive::GetNormalizedName(mountPath.u8string());
+            archive->mappedFile = MappedFile(archivePath);
+            if (archive->mappedFile.getSize() < sizeof(Archive::Header))
+            {
+                LockedWrite{ std::cerr } << String::Format("File too small to be an archive: %v", archivePath.u8string());
+                return false;
+            }
+
+            auto data = archive->mappedFile.getData();
+            archive->header = reinterpret_cast<Archive::Header const *>(data);
+            if (archive->header->identifier != Archive::Identifier)
+            {
+                LockedWrite{ std::cerr } << String::Format("Unknown archive identifier encountered: %v", archivePath.u8string());
+                return false;
+            }
+
+            if (archive->header->version != Archive::Version)
+            {
+                LockedWrite{ std::cerr } << String::Format("Unsupported archive version encountered (requires: %v, has: %v): %v", Archive::Version, archive->header->version, archivePath.u8string());
+                return false;
+            }
+
+            auto indexSize = (sizeof(Archive::Header) + (sizeof(Archive::Entry) * archive->header->entryCount) + archive->header->nameTableSize);
+            if (archive->mappedFile.getSize() < indexSize)
+            {
+                LockedWrite{ std::cerr } << String::Format("Archive too small to contain index: %v", archivePath.u8string());
+                return false;
+            }
+
+            archive->entryList = reinterpret_cast<Archive::Entry const *>(data + sizeof(Archive::Header));
+            archive->nameTable = reinterpret_cast<char const *>(archive->entryList + archive->header->entryCount);
+            for (uint32_t entryIndex = 0; entryIndex < archive->header->entryCount; ++entryIndex)
+            {
+                auto const &entry = archive->entryList[entryIndex];
+                if (entry.nameOffset >= archive->header->nameTableSize || (entry.offset + entry.packedSize) > archive->mappedFile.getSize())
+                {
+                    LockedWrite{ std::cerr } << String::Format("Invalid entry encountered in archive: %v", archivePath.u8string());
+                    return false;
+                }
+
+                std::string name(&archive->nameTable[entry.nameOffset]);
+                for (auto separator = name.rfind('/'); separator != std::string::npos; separator = name.rfind('/'))
+                {
+                    name.resize(separator);
+                    if (!archive->directorySet.insert(name).second)
+                    {
+                        break;
+                    }
+                }
+            }
+
+            // Start pulling the whole archive in now, as one large sequential read
+            archive->mappedFile.prefetch();
+
+            LockedWrite{ std::cout } << String::Format("Mounted archive: %v, %v files", archivePath.u8string(), archive->header->entryCount);
+
+            auto &mountState = *currentMountState;
+            std::unique_lock<std::shared_mutex> lock(mountState.mutex);
+            mountState.mountList.push_back(std::move(archive));
+            return true;
+        }
+
+        void Unmount(Path const &archivePath)
+        {
+            auto &mountState = *currentMountState;
+            std::unique_lock<std::shared_mutex> lock(mountState.mutex);
+            auto &mountList = mountState.mountList;
+            mountList.erase(std::remove_if(std::begin(mountList), std::end(mountList), [&archivePath](MountedArchivePtr const &archive) -> bool
+            {
+                return (archive->archivePath == archivePath);
+            }), std::end(mountList));
+        }
+
+        bool IsPackedFile(Path const &filePath)
+        {
+            auto &mountState = *currentMountState;
+            std::shared_lock<std::shared_mutex> lock(mountState.mutex);
+            auto const &mountList = mountState.mountList;
+            if (mountList.empty())
+            {
+                return false;
+            }
+
+            std::string relativeName;
+            auto normalizedName(Archive::GetNormalizedName(filePath.u8string()));
+            for (auto const &archive : mountList)
+            {
+                if (archive->getRelativeName(normalizedName, relativeName) && archive->find(relativeName))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        bool IsPackedDirectory(Path const &directoryPath)
+        {
+            auto &mountState = *currentMountState;
+            std::shared_lock<std::shared_mutex> lock(mountState.mutex);
+            auto const &mountList = mountState.mountList;
+            if (mountList.empty())
+            {
+                return false;
+            }
+
+            std::string relativeName;
+            auto normalizedName(Archive::GetNormalizedName(directoryPath.u8string()));
+            for (auto const &archive : mountList)
+            {
+                if (archive->getRelativeName(normalizedName, relativeName) && archive->directorySet.count(relativeName) > 0)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        void FindPacked(Path const &rootDirectory, std::function<bool(std::string const &name)> onNameFound)
+        {
+            std::vector<std::string> nameList;
+            if (true)
+            {
+                auto &mountState = *currentMountState;
+                std::shared_lock<std::shared_mutex> lock(mountState.mutex);
+                auto const &mountList = mountState.mountList;
+                if (mountList.empty())
+                {
+                    return;
+                }
+
+                std::string relativeName;
+                std::unordered_set<std::string> foundSet;
+                auto normalizedName(Archive::GetNormalizedName(rootDirectory.u8string()));
+                for (auto archiveSearch = mountList.rbegin(); archiveSearch != mountList.rend(); ++archiveSearch)
+                {
+                    auto const &archive = (*archiveSearch);
+                    if (!archive->getRelativeName(normalizedName, relativeName))
+                    {
+                        continue;
+                    }
+
+                    auto prefix(relativeName.empty() ? relativeName : (relativeName + '/'));
+                    for (uint32_t entryIndex = 0; entryIndex < archive->header->entryCount; ++entryIndex)
+                    {
+                        std::string_view name(&archive->nameTable[archive->entryList[entryIndex].nameOffset]);
+                        if (name.size() > prefix.size() && name.compare(0, prefix.size(), prefix) == 0)
+                        {
+                            // Only report the immediate child, either a file or a directory
+                            name.remove_prefix(prefix.size());
+                            std::string childName(name.substr(0, name.find('/')));
+                            if (foundSet.insert(childName).second)
+                            {
+                                nameList.push_back(childName);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Call back outside the lock so the caller is free to load what it finds
+            for (auto const &name : nameList)
+            {
+                if (!onNameFound(name))
+                {
+                    return;
+                }
+            }
+        }
+
+        bool LoadPacked(Path const &filePath, std::function<void *(std::size_t size)> const &resize, std::uintmax_t limitReadSize)
+        {
+            auto &mountState = *currentMountState;
+            std::shared_lock<std::shared_mutex> lock(mountState.mutex);
+            auto const &mountList = mountState.mountList;
+            if (mountList.empty())
+            {
+                return false;
+            }
+
+            std::string relativeName;
+            auto normalizedName(Archive::GetNormalizedName(filePath.u8string()));
+            for (auto archiveSearch = mountList.rbegin(); archiveSearch != mountList.rend(); ++archiveSearch)
+            {
+                auto const &archive = (*archiveSearch);
+                if (!archive->getRelativeName(normalizedName, relativeName))
+                {
+                    continue;
+                }
+
+                auto entry = archive->find(relativeName);
+                if (!entry)
+                {
+                    continue;
+                }
+
+                std::size_t size = static_cast<std::size_t>(limitReadSize == 0 ? entry->size : std::min<uint64_t>(entry->size, limitReadSize));
+                if (size == 0)
+                {
+                    return false;
+                }
+
+                auto packedData = (archive->mappedFile.getData() + entry->offset);
+                auto buffer = static_cast<uint8_t *>(resize(size));
+                if (entry->flags & Archive::Entry::Flags::Compressed)
+                {
+                    z_stream stream = {};
+                    if (inflateInit(&stream) != Z_OK)
+                    {
+                        return false;
+                    }
+
+                    stream.next_in = const_cast<Bytef *>(packedData);
+                    stream.avail_in = static_cast<uInt>(entry->packedSize);
+                    stream.next_out = buffer;
+                    stream.avail_out = static_cast<uInt>(size);
+
+                    // Reads limited to less than the whole entry stop as soon as the output is full
+                    auto result = inflate(&stream, Z_FINISH);
+                    inflateEnd(&stream);
+                    if ((result != Z_STREAM_END && result != Z_BUF_ERROR) || stream.total_out != size)
+                    {
+                        LockedWrite{ std::cerr } << String::Format("Unable to decompress %v from archive: %v", relativeName, archive->archivePath.u8string());
+                        return false;
+                    }
+                }
+                else
+                {
+                    std::memcpy(buffer, packedData, size);
+                }
+
+                return true;
+            }
+
+            return false;
+        }
+    } // namespace FileSystem
+}; // namespace Gek
@@ -0,0 +1,349 @@
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/ThreadPool.hpp"
+#include <algorithm>
+#include <atomic>
+#include <deque>
+
+#if defined(__linux__) && defined(GEK_IO_URING)
+#include <liburing.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <errno.h>
+#endif
+
+namespace Gek
+{
+    namespace FileSystem
+    {
+        struct ReadBatch
+        {
+            std::vector<Path> filePathList;
+            std::uintmax_t limitReadSize = 0;
+            AsyncReader::BufferList bufferList;
+            std::atomic<std::size_t> remainingCount = 0;
+            std::promise<AsyncReader::BufferList> promise;
+
+            ReadBatch(std::vector<Path> const &filePathList, std::uintmax_t limitReadSize)
+                : filePathList(filePathList)
+                , limitReadSize(limitReadSize)
+                , bufferList(filePathList.size())
+                , remainingCount(filePathList.size())
+            {
+            }
+
+            void complete(void)
+            {
+                promise.set_value(std::move(bufferList));
+            }
+        };
+
+        // Blocking reads spread across a pool of threads, one task per file
+        class PooledReader
+            : public AsyncReader
+        {
+        private:
+            ThreadPool pool;
+
+        public:
+            PooledReader(size_t threadCount)
+                : pool(threadCount)
+            {
+            }
+
+            // AsyncReader
+            std::future<BufferList> read(std::vector<Path> const &filePathList, std::uintmax_t limitReadSize)
+            {
+                auto batch = std::make_shared<ReadBatch>(filePathList, limitReadSize);
+                auto result = batch->promise.get_future();
+                if (filePathList.empty())
+                {
+                    batch->complete();
+                    return result;
+                }
+
+                for (std::size_t fileIndex = 0; fileIndex < filePathList.size(); ++fileIndex)
+                {
+                    pool.enqueue([batch, fileIndex](void) -> void
+                    {
+                        static const Buffer EmptyBuffer;
+                        batch->bufferList[fileIndex] = Load(batch->filePathList[fileIndex], EmptyBuffer, batch->limitReadSize);
+                        if (--batch->remainingCount == 0)
+                        {
+                            batch->complete();
+                        }
+                    });
+                }
+
+                return result;
+            }
+        };
+
+#if defined(__linux__) && defined(GEK_IO_URING)
+        // Submits every read in a batch to a single io_uring instance, the ring is only
+        // ever touched from its own submission thread so it needs no locking
+        class RingReader
+            : public AsyncReader
+        {
+        public:
+            static const uint32_t QueueDepth = 64;
+
+            // Reads are split so the length always fits io_uring's 32-bit count, short reads continue from there anyway
+            static const uint32_t MaximumReadSize = (1U << 30);
+
+            struct Request
+            {
+                int fileDescriptor = -1;
+                std::size_t fileIndex = 0;
+                std::size_t offset = 0;
+                bool inFlight = false;
+                bool finished = false;
+            };
+
+        private:
+            io_uring ring;
+            ThreadPool submitter;
+
+            // Buffers of reads that couldn't be confirmed as finished or cancelled, the kernel may still write to
+            // them so they're kept until the ring itself is gone instead of being handed back to the caller
+            std::vector<Buffer> abandonedBufferList;
+
+        public:
+            static std::unique_ptr<AsyncReader> Create(void)
+            {
+                std::unique_ptr<RingReader> reader(new RingReader());
+                if (io_uring_queue_init(QueueDepth, &reader->ring, 0) < 0)
+                {
+                    // Kernel lacks io_uring support, or it has been disabled
+                    reader->submitter.drain();
+                    return nullptr;
+                }
+
+                return std::move(reader);
+            }
+
+            ~RingReader(void)
+            {
+                submitter.drain();
+                io_uring_queue_exit(&ring);
+                abandonedBufferList.clear();
+            }
+
+            // AsyncReader
+            std::future<BufferList> read(std::vector<Path> const &filePathList, std::uintmax_t limitReadSize)
+            {
+                auto batch = std::make_shared<ReadBatch>(filePathList, limitReadSize);
+                auto result = batch->promise.get_future();
+                submitter.enqueue([this, batch](void) -> void
+                {
+                    process(*batch);
+                    batch->complete();
+                });
+
+                return result;
+            }
+
+        private:
+            RingReader(void)
+                : submitter(1)
+            {
+            }
+
+            void process(ReadBatch &batch)
+            {
+                std::vector<Request> requestList;
+                requestList.reserve(batch.filePathList.size());
+                for (std::size_t fileIndex = 0; fileIndex < batch.filePathList.size(); ++fileIndex)
+                {
+                    int fileDescriptor = open(batch.filePathList[fileIndex].u8string().c_str(), O_RDONLY);
+                    if (fileDescriptor < 0)
+                    {
+                        continue;
+                    }
+
+                    struct stat fileStatus;
+                    std::uintmax_t size = (fstat(fileDescriptor, &fileStatus) == 0 ? fileStatus.st_size : 0);
+                    size = (batch.limitReadSize == 0 ? size : std::min(size, batch.limitReadSize));
+                    if (size == 0)
+                    {
+                        close(fileDescriptor);
+                        continue;
+                    }
+
+                    batch.bufferList[fileIndex].resize(size);
+                    requestList.push_back({ fileDescriptor, fileIndex, 0 });
+                }
+
+                std::deque<Request *> submitQueue;
+                for (auto &request : requestList)
+                {
+                    submitQueue.push_back(&request);
+                }
+
+                uint32_t inFlightCount = 0;
+                bool failed = false;
+                auto finish = [&](Request *request) -> void
+                {
+                    close(request->fileDescriptor);
+                    request->finished = true;
+                };
+
+                // Handles every completion that's ready, cancellations carry no request and only count down
+                auto reap = [&](io_uring_cqe *completion) -> void
+                {
+                    do
+                    {
+                        Request *request = static_cast<Request *>(io_uring_cqe_get_data(completion));
+                        int readResult = completion->res;
+                        io_uring_cqe_seen(&ring, completion);
+                        if (!request)
+                        {
+                            continue;
+                        }
+
+                        --inFlightCount;
+                        request->inFlight = false;
+                        auto &buffer = batch.bufferList[request->fileIndex];
+                        if (readResult == -EAGAIN || readResult == -EINTR)
+                        {
+                            if (!failed)
+                            {
+                                submitQueue.push_back(request);
+                            }
+                        }
+                        else if (readResult < 0)
+                        {
+                            buffer.clear();
+                            finish(request);
+                        }
+                        else if (readResult == 0)
+                        {
+                            // File was truncated since it was opened
+                            buffer.resize(request->offset);
+                            finish(request);
+                        }
+                        else
+                        {
+                            request->offset += readResult;
+                            if (request->offset < buffer.size())
+                            {
+                                // Short read, continue from where it left off
+                                if (!failed)
+                                {
+                                    submitQueue.push_back(request);
+                                }
+                            }
+                            else
+                            {
+                                finish(request);
+                            }
+                        }
+                    } while (io_uring_peek_cqe(&ring, &completion) == 0);
+                };
+
+                while (!submitQueue.empty() || inFlightCount > 0)
+                {
+                    while (!submitQueue.empty() && inFlightCount < QueueDepth)
+                    {
+                        io_uring_sqe *submission = io_uring_get_sqe(&ring);
+                        if (!submission)
+                        {
+                            break;
+                        }
+
+                        Request *request = submitQueue.front();
+                        submitQueue.pop_front();
+
+                        auto &buffer = batch.bufferList[request->fileIndex];
+                        auto readSize = std::min((buffer.size() - request->offset), std::size_t(MaximumReadSize));
+                        io_uring_prep_read(submission, request->fileDescriptor, (buffer.data() + request->offset), uint32_t(readSize), request->offset);
+                        io_uring_sqe_set_data(submission, request);
+                        request->inFlight = true;
+                        ++inFlightCount;
+                    };
+
+                    io_uring_submit(&ring);
+
+                    io_uring_cqe *completion = nullptr;
+                    int waitResult = io_uring_wait_cqe(&ring, &completion);
+                    if (waitResult == -EINTR)
+                    {
+                        continue;
+                    }
+                    else if (waitResult < 0)
+                    {
+                        failed = true;
+                        break;
+                    }
+
+                    reap(completion);
+                };
+
+                if (failed)
+                {
+                    // Nothing new is submitted, every read still in flight is cancelled and waited on,
+                    // so the kernel is done with the buffers before they're handed back
+                    submitQueue.clear();
+                    for (auto &request : requestList)
+                    {
+                        if (request.inFlight)
+                        {
+                            io_uring_sqe *submission = io_uring_get_sqe(&ring);
+                            if (submission)
+                            {
+                                io_uring_prep_cancel(submission, &request, 0);
+                                io_uring_sqe_set_data(submission, nullptr);
+                            }
+                        }
+                    }
+
+                    io_uring_submit(&ring);
+                    while (inFlightCount > 0)
+                    {
+                        io_uring_cqe *completion = nullptr;
+                        int waitResult = io_uring_wait_cqe(&ring, &completion);
+                        if (waitResult == -EINTR || waitResult == -EAGAIN)
+                        {
+                            continue;
+                        }
+                        else if (waitResult < 0)
+                        {
+                            break;
+                        }
+
+                        reap(completion);
+                    }
+                }
+
+                // Anything left unfinished is reported as not loaded, rather than as a zero filled file
+                for (auto &request : requestList)
+                {
+                    if (!request.finished)
+                    {
+                        auto &buffer = batch.bufferList[request.fileIndex];
+                        if (request.inFlight)
+                        {
+                            abandonedBufferList.push_back(std::move(buffer));
+                        }
+
+                        buffer.clear();
+                        finish(&request);
+                    }
+                }
+            }
+        };
+#endif
+
+        std::unique_ptr<AsyncReader> AsyncReader::Create(size_t threadCount)
+        {
+#if defined(__linux__) && defined(GEK_IO_URING)
+            auto ringReader = RingReader::Create();
+            if (ringReader)
+            {
+                return ringReader;
+            }
+#endif
+            return std::make_unique<PooledReader>(threadCount);
+        }
+    }; // namespace FileSystem
+}; // namespace Gek
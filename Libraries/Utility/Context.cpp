@@ -2,6 +2,7 @@
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/SharedState.hpp"
 #include <unordered_map>
 #include <Windows.h>
 
@@ -21,7 +22,18 @@ namespace Gek
             : rootPath(rootPath)
         {
             SetCurrentDirectoryW(rootPath.native().c_str());
-            
+
+            // Mount packed archives before loading plugins, so everything after reads through them
+            FileSystem::Find(rootPath, [&](FileSystem::Path const &filePath) -> bool
+            {
+                if (String::GetLower(filePath.getExtension()) == ".pak")
+                {
+                    FileSystem::Mount(filePath, rootPath);
+                }
+
+                return true;
+            });
+
             searchPathList.push_back(rootPath);
             for (auto const &searchPath : searchPathList)
             {
@@ -35,7 +47,7 @@ namespace Gek
 							InitializePlugin initializePlugin = (InitializePlugin)GetProcAddress(module, "initializePlugin");
 							if (initializePlugin)
 							{
-								initializePlugin([this, filePath = filePath.u8string()](std::string const &className, std::function<ContextUserPtr(Context *, void *, std::vector<std::type_index> &)> creator) -> void
+								initializePlugin(GetSharedState(), [this, filePath = filePath.u8string()](std::string const &className, std::function<ContextUserPtr(Context *, void *, std::vector<std::type_index> &)> creator) -> void
 								{
 									if (classMap.count(className) == 0)
 									{
@@ -1,6 +1,15 @@
 #include "GEK/Utility/FileSystem.hpp"
+#include <unordered_set>
 #include <fstream>
+
+#ifdef _WIN32
 #include <Windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
 
 namespace Gek
 {
@@ -104,12 +113,22 @@ namespace Gek
 
         bool Path::isFile(void) const
         {
+            if (IsPackedFile(*this))
+            {
+                return true;
+            }
+
             std::error_code errorCode;
             return std::experimental::filesystem::is_regular_file(*this, errorCode);
         }
 
         bool Path::isDirectory(void) const
         {
+            if (IsPackedDirectory(*this))
+            {
+                return true;
+            }
+
             std::error_code errorCode;
             return std::experimental::filesystem::is_directory(*this, errorCode);
         }
@@ -141,6 +160,102 @@ namespace Gek
 			return std::experimental::filesystem::path(absoluteName);
         }
 
+        MappedFile::MappedFile(Path const &filePath)
+        {
+#ifdef _WIN32
+            HANDLE fileHandle = CreateFileW(filePath.wstring().c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+            if (fileHandle != INVALID_HANDLE_VALUE)
+            {
+                LARGE_INTEGER fileSize;
+                if (GetFileSizeEx(fileHandle, &fileSize) && fileSize.QuadPart > 0)
+                {
+                    HANDLE mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                    if (mappingHandle != nullptr)
+                    {
+                        // The view keeps the mapping alive, neither handle is needed afterwards
+                        data = static_cast<uint8_t const *>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+                        size = (data ? static_cast<std::size_t>(fileSize.QuadPart) : 0);
+                        CloseHandle(mappingHandle);
+                    }
+                }
+
+                CloseHandle(fileHandle);
+            }
+#else
+            int fileDescriptor = open(filePath.u8string().c_str(), O_RDONLY);
+            if (fileDescriptor >= 0)
+            {
+                struct stat fileStatus;
+                if (fstat(fileDescriptor, &fileStatus) == 0 && fileStatus.st_size > 0)
+                {
+                    void *mapping = mmap(nullptr, fileStatus.st_size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+                    if (mapping != MAP_FAILED)
+                    {
+                        madvise(mapping, fileStatus.st_size, MADV_SEQUENTIAL);
+                        data = static_cast<uint8_t const *>(mapping);
+                        size = static_cast<std::size_t>(fileStatus.st_size);
+                    }
+                }
+
+                ::close(fileDescriptor);
+            }
+#endif
+        }
+
+        MappedFile::MappedFile(MappedFile &&mappedFile)
+            : data(mappedFile.data)
+            , size(mappedFile.size)
+        {
+            mappedFile.data = nullptr;
+            mappedFile.size = 0;
+        }
+
+        MappedFile::~MappedFile(void)
+        {
+            close();
+        }
+
+        MappedFile &MappedFile::operator = (MappedFile &&mappedFile)
+        {
+            if (this != &mappedFile)
+            {
+                close();
+                std::swap(data, mappedFile.data);
+                std::swap(size, mappedFile.size);
+            }
+
+            return (*this);
+        }
+
+        void MappedFile::close(void)
+        {
+            if (data)
+            {
+#ifdef _WIN32
+                UnmapViewOfFile(data);
+#else
+                munmap(const_cast<uint8_t *>(data), size);
+#endif
+                data = nullptr;
+                size = 0;
+            }
+        }
+
+        void MappedFile::prefetch(void) const
+        {
+            if (data)
+            {
+#ifdef _WIN32
+                WIN32_MEMORY_RANGE_ENTRY range;
+                range.VirtualAddress = const_cast<uint8_t *>(data);
+                range.NumberOfBytes = size;
+                PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#else
+                madvise(const_cast<uint8_t *>(data), size, MADV_WILLNEED);
+#endif
+            }
+        }
+
         void MakeDirectoryChain(Path const &filePath)
         {
             std::error_code errorCode;
@@ -149,14 +264,26 @@ namespace Gek
 
         void Find(Path const &rootDirectory, std::function<bool(Path const &)> onFileFound)
 		{
+            std::unordered_set<std::string> foundSet;
             std::error_code errorCode;
             for (auto const &fileSearch : std::experimental::filesystem::directory_iterator(rootDirectory, errorCode))
 			{
+                foundSet.insert(String::GetLower(fileSearch.path().filename().u8string()));
                 if (!onFileFound(fileSearch.path().u8string()))
                 {
                     return;
                 }
 			}
+
+            FindPacked(rootDirectory, [&](std::string const &name) -> bool
+            {
+                if (foundSet.insert(name).second)
+                {
+                    return onFileFound(GetFileName(rootDirectory, name));
+                }
+
+                return true;
+            });
 		}
     } // namespace FileSystem
 }; // namespace Gek
@@ -7,9 +7,15 @@
 /// Last Changed: $Date$
 #pragma once
 
+#include "GEK/Utility/Memory.hpp"
+#include <algorithm>
+#include <stdexcept>
+#include <new>
+
 namespace Gek
 {
-    template <typename TYPE, std::size_t ALIGNMENT = sizeof(TYPE)>
+    // Allocations are counted against TAG in the memory accounting
+    template <typename TYPE, std::size_t ALIGNMENT = sizeof(TYPE), Memory::Tag TAG = Memory::Tag::General>
     class AlignedAllocator
     {
     public:
@@ -29,7 +35,7 @@ namespace Gek
         {
         }
 
-        template <typename NEWTYPE> AlignedAllocator(const AlignedAllocator<NEWTYPE, ALIGNMENT> &)
+        template <typename NEWTYPE> AlignedAllocator(const AlignedAllocator<NEWTYPE, ALIGNMENT, TAG> &)
         {
         }
 
@@ -55,7 +61,7 @@ namespace Gek
         template <typename NEWTYPE>
         struct rebind
         {
-            using other = AlignedAllocator<NEWTYPE, ALIGNMENT>;
+            using other = AlignedAllocator<NEWTYPE, ALIGNMENT, TAG>;
         };
 
         bool operator != (const AlignedAllocator &other) const
@@ -91,7 +97,7 @@ namespace Gek
                 throw std::length_error("AlignedAllocator<TYPE>::allocate() - integer overflow.");
             }
 
-            void *const nebulous = _mm_malloc(size * sizeof(TYPE), ALIGNMENT);
+            void *const nebulous = Memory::Allocate(TAG, size * sizeof(TYPE), ALIGNMENT);
             if (nebulous == nullptr)
             {
                 throw std::bad_alloc();
@@ -102,7 +108,7 @@ namespace Gek
 
         void deallocate(TYPE *const value, const std::size_t size) const
         {
-            _mm_free(value);
+            Memory::Free(TAG, value, size * sizeof(TYPE));
         }
 
         template <typename NEWTYPE>
@@ -114,4 +120,58 @@ namespace Gek
     private:
         AlignedAllocator &operator=(const AlignedAllocator &);
     };
+
+    // Standard container allocator, with the default alignment, that counts against TAG in the memory accounting
+    template <typename TYPE, Memory::Tag TAG>
+    class TaggedAllocator
+    {
+    public:
+        using value_type = TYPE;
+
+        template <typename NEWTYPE>
+        struct rebind
+        {
+            using other = TaggedAllocator<NEWTYPE, TAG>;
+        };
+
+        TaggedAllocator(void) = default;
+
+        template <typename NEWTYPE>
+        TaggedAllocator(const TaggedAllocator<NEWTYPE, TAG> &)
+        {
+        }
+
+        TYPE *allocate(const std::size_t size) const
+        {
+            if (size == 0)
+            {
+                return nullptr;
+            }
+
+            void *const nebulous = Memory::Allocate(TAG, size * sizeof(TYPE), std::max(alignof(TYPE), sizeof(void *)));
+            if (nebulous == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            return static_cast<TYPE *>(nebulous);
+        }
+
+        void deallocate(TYPE *const value, const std::size_t size) const
+        {
+            Memory::Free(TAG, value, size * sizeof(TYPE));
+        }
+
+        template <typename NEWTYPE>
+        bool operator == (const TaggedAllocator<NEWTYPE, TAG> &other) const
+        {
+            return true;
+        }
+
+        template <typename NEWTYPE>
+        bool operator != (const TaggedAllocator<NEWTYPE, TAG> &other) const
+        {
+            return false;
+        }
+    };
 }; // namespace Gek
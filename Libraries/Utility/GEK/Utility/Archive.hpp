@@ -0,0 +1,64 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include <cstdint>
+#include <string>
+
+namespace Gek
+{
+    namespace FileSystem
+    {
+        // Packed archive layout, as written by createpack:
+        //  - Header
+        //  - Entry list, sorted by hash so lookups are a binary search
+        //  - Name table, null terminated normalized names referenced by Entry::nameOffset
+        //  - File data, each entry starting on a Header::alignment boundary
+        namespace Archive
+        {
+            static const uint32_t Identifier = 0x504B4547; // GEKP
+            static const uint16_t Version = 1;
+
+            struct Header
+            {
+                uint32_t identifier = Identifier;
+                uint16_t version = Version;
+                uint16_t reserved = 0;
+                uint32_t alignment = 4096;
+                uint32_t entryCount = 0;
+                uint32_t nameTableSize = 0;
+                uint32_t padding = 0;
+            };
+
+            struct Entry
+            {
+                struct Flags
+                {
+                    enum
+                    {
+                        Compressed = 1 << 0,
+                    };
+                };
+
+                uint64_t hash = 0;
+                uint64_t offset = 0;
+                uint64_t size = 0;
+                uint64_t packedSize = 0;
+                uint32_t nameOffset = 0;
+                uint32_t flags = 0;
+            };
+
+            // Lower case, forward slash separated, with "." and ".." segments collapsed
+            std::string GetNormalizedName(std::string const &fileName);
+
+            // FNV-1a, stable across builds and platforms unlike std::hash
+            uint64_t GetNameHash(std::string const &normalizedName);
+        }; // namespace Archive
+    }; // namespace FileSystem
+}; // namespace Gek
@@ -8,6 +8,7 @@
 #pragma once
 
 #include "GEK/Utility/Context.hpp"
+#include "GEK/Utility/SharedState.hpp"
 #include <unordered_map>
 #include <assert.h>
 
@@ -24,9 +25,11 @@ extern ContextUserPtr CLASS##CreateInstance(Context *, void *, std::vector<std::
 
 #define GEK_CONTEXT_BEGIN(SOURCENAME)                                                                                                       \
 extern "C" __declspec(dllexport) void initializePlugin(                                                                                     \
+    SharedState *sharedState,                                                                                                               \
     std::function<void(std::string const &, std::function<ContextUserPtr(Context *, void *, std::vector<std::type_index> &)>)> addClass,    \
     std::function<void(std::string const &, std::string const &)> addType)                                                                  \
 {                                                                                                                                           \
+    SetSharedState(sharedState);                                                                                                            \
     std::string lastClassName;
 
 #define GEK_CONTEXT_ADD_CLASS(CLASSNAME, CLASS)                                                                                             \
@@ -41,7 +44,7 @@ extern "C" __declspec(dllexport) void initializePlugin(
 
 namespace Gek
 {
-    using InitializePlugin = void(*)(std::function<void(std::string const & className,
+    using InitializePlugin = void(*)(SharedState *sharedState, std::function<void(std::string const & className,
         std::function<ContextUserPtr(Context *, void *, std::vector<std::type_index> &)>)> addClass, 
         std::function<void(std::string const &, std::string const &)> addType);
 
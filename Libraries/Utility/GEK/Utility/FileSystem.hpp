@@ -11,6 +11,8 @@
 #include <experimental\filesystem>
 #include <functional>
 #include <algorithm>
+#include <future>
+#include <memory>
 #include <vector>
 
 namespace Gek
@@ -75,11 +77,34 @@ namespace Gek
 
 		void MakeDirectoryChain(Path const &filePath);
 
+		// Lists loose files first, followed by any packed files and directories not found on disk
 		void Find(Path const &rootDirectory, std::function<bool(Path const &filePath)> onFileFound);
 
+		// Mounted archives are searched, most recently mounted first, before loose files on disk
+		// Names in the archive are relative to the mount path
+		bool Mount(Path const &archivePath, Path const &mountPath);
+		void Unmount(Path const &archivePath);
+
+		bool IsPackedFile(Path const &filePath);
+		bool IsPackedDirectory(Path const &directoryPath);
+		void FindPacked(Path const &rootDirectory, std::function<bool(std::string const &name)> onNameFound);
+
+		// Calls resize with the size of the data, and reads into the returned pointer
+		bool LoadPacked(Path const &filePath, std::function<void *(std::size_t size)> const &resize, std::uintmax_t limitReadSize = 0);
+
 		template <typename CONTAINER>
 		CONTAINER Load(Path const &filePath, CONTAINER const &defaultValue = CONTAINER(), std::uintmax_t limitReadSize = 0)
 		{
+			CONTAINER packedBuffer;
+			if (LoadPacked(filePath, [&packedBuffer](std::size_t size) -> void *
+			{
+				packedBuffer.resize(size);
+				return static_cast<void *>(&packedBuffer.front());
+			}, limitReadSize))
+			{
+				return packedBuffer;
+			}
+
 			if (std::experimental::filesystem::is_regular_file(filePath))
 			{
 				CONTAINER buffer;
@@ -107,6 +132,77 @@ namespace Gek
 			return defaultValue;
 		}
 
+		// Read-only view of a whole file mapped into memory, avoids copying data that is
+		// only parsed once (collision models, packed archives) into an intermediate buffer
+		class MappedFile final
+		{
+		private:
+			uint8_t const *data = nullptr;
+			std::size_t size = 0;
+
+		public:
+			MappedFile(void) = default;
+			MappedFile(Path const &filePath);
+			MappedFile(MappedFile &&mappedFile);
+			~MappedFile(void);
+
+			MappedFile(MappedFile const &) = delete;
+			MappedFile &operator = (MappedFile const &) = delete;
+			MappedFile &operator = (MappedFile &&mappedFile);
+
+			void close(void);
+
+			// Asks the system to start reading the whole mapping in, ahead of first access
+			void prefetch(void) const;
+
+			bool isValid(void) const
+			{
+				return (data != nullptr);
+			}
+
+			explicit operator bool() const
+			{
+				return isValid();
+			}
+
+			uint8_t const *getData(void) const
+			{
+				return data;
+			}
+
+			std::size_t getSize(void) const
+			{
+				return size;
+			}
+
+			uint8_t const *begin(void) const
+			{
+				return data;
+			}
+
+			uint8_t const *end(void) const
+			{
+				return (data + size);
+			}
+		};
+
+		// Reads batches of files in the background, using io_uring where it is available
+		// and falling back to a pool of threads using blocking reads otherwise
+		class AsyncReader
+		{
+		public:
+			using Buffer = std::vector<uint8_t>;
+			using BufferList = std::vector<Buffer>;
+
+		public:
+			static std::unique_ptr<AsyncReader> Create(size_t threadCount = 2);
+
+			virtual ~AsyncReader(void) = default;
+
+			// Buffers are returned in the same order as the paths, missing or unreadable files return empty buffers
+			virtual std::future<BufferList> read(std::vector<Path> const &filePathList, std::uintmax_t limitReadSize = 0) = 0;
+		};
+
 		template <typename CONTAINER>
 		void Save(Path const &filePath, CONTAINER const &buffer)
 		{
@@ -0,0 +1,100 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <string_view>
+#include <functional>
+#include <cstdint>
+#include <string>
+
+namespace Gek
+{
+    // Compact handle for an interned name, the value is a sequential index into a table shared by every module
+    //  - comparisons and map lookups are plain integer operations
+    //  - each table entry stores the name and its precomputed 64-bit FNV-1a hash
+    //  - names that hash the same still get their own index, and the collision is reported
+    //  - literals are hashed at compile time with the _id suffix, names that are compared often should be interned
+    //    from one once and kept, rather than converted again for every comparison
+    class Identifier
+    {
+    public:
+        struct Literal
+        {
+            char const *string;
+            std::size_t length;
+            uint64_t hash;
+        };
+
+        static constexpr uint64_t MakeHash(char const *string, std::size_t length)
+        {
+            uint64_t hash = 14695981039346656037ULL;
+            for (std::size_t index = 0; index < length; ++index)
+            {
+                hash ^= uint8_t(string[index]);
+                hash *= 1099511628211ULL;
+            }
+
+            return hash;
+        }
+
+    private:
+        uint32_t index = 0;
+
+    public:
+        constexpr Identifier(void) = default;
+
+        // Interns the name in the shared table, safe to call from any thread
+        explicit Identifier(std::string_view name);
+        explicit Identifier(Literal const &literal);
+
+        constexpr uint32_t getIndex(void) const
+        {
+            return index;
+        }
+
+        uint64_t getHash(void) const;
+        std::string const &getString(void) const;
+
+        constexpr explicit operator bool() const
+        {
+            return (index != 0);
+        }
+
+        constexpr bool operator == (Identifier const &identifier) const
+        {
+            return (index == identifier.index);
+        }
+
+        constexpr bool operator != (Identifier const &identifier) const
+        {
+            return (index != identifier.index);
+        }
+
+        constexpr bool operator < (Identifier const &identifier) const
+        {
+            return (index < identifier.index);
+        }
+    };
+
+    inline constexpr Identifier::Literal operator "" _id(char const *string, std::size_t length)
+    {
+        return Identifier::Literal{ string, length, Identifier::MakeHash(string, length) };
+    }
+}; // namespace Gek
+
+namespace std
+{
+    template <>
+    struct hash<Gek::Identifier>
+    {
+        size_t operator()(Gek::Identifier const &identifier) const
+        {
+            return identifier.getIndex();
+        }
+    };
+}; // namespace std
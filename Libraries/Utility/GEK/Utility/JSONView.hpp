@@ -0,0 +1,308 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/JSON.hpp"
+#include <string_view>
+#include <memory>
+#include <vector>
+
+namespace Gek
+{
+    namespace JSON
+    {
+        // Pull parser, returns one token at a time without building any tree
+        class Reader
+        {
+        public:
+            enum class Token : uint8_t
+            {
+                Error = 0,
+                End,
+                BeginObject,
+                EndObject,
+                BeginArray,
+                EndArray,
+                Name,
+                String,
+                Number,
+                Boolean,
+                Null,
+            };
+
+        private:
+            struct Frame
+            {
+                enum : uint8_t
+                {
+                    Open = 0,
+                    Name,
+                    Value,
+                };
+
+                bool isObject;
+                uint8_t state;
+            };
+
+            std::string_view text;
+            std::size_t position = 0;
+            std::vector<Frame> frameStack;
+            bool rootFinished = false;
+
+            std::string scratch;
+            std::string_view string;
+            bool stringCopied = false;
+            double number = 0.0;
+            bool boolean = false;
+            std::string error;
+
+        public:
+            Reader(std::string_view text);
+
+            Token next(void);
+
+            // Valid until the next call to next, points in to the source text unless isStringCopied
+            std::string_view getString(void) const
+            {
+                return string;
+            }
+
+            // Strings containing escape sequences are decoded into a temporary buffer
+            bool isStringCopied(void) const
+            {
+                return stringCopied;
+            }
+
+            double getNumber(void) const
+            {
+                return number;
+            }
+
+            bool getBoolean(void) const
+            {
+                return boolean;
+            }
+
+            std::string const &getError(void) const
+            {
+                return error;
+            }
+
+            std::size_t getPosition(void) const
+            {
+                return position;
+            }
+
+        private:
+            Token fail(char const *message);
+            Token readValue(void);
+            Token readString(Token token);
+            Token readNumber(void);
+            Token readLiteral(std::string_view literal, Token token, bool value);
+            void skipWhiteSpace(void);
+        };
+
+        struct Member;
+
+        struct Node
+        {
+            enum class Type : uint8_t
+            {
+                Null = 0,
+                Boolean,
+                Number,
+                String,
+                Array,
+                Object,
+            };
+
+            Type type = Type::Null;
+            bool boolean = false;
+            uint32_t size = 0;
+            union
+            {
+                double number;
+                char const *string;
+                Node const *elementList;
+                Member const *memberList;
+            };
+
+            Node(void)
+                : number(0.0)
+            {
+            }
+        };
+
+        struct Member
+        {
+            std::string_view name;
+            Node value;
+        };
+
+        // Immutable view of a node in a Document, cheap to copy and pass by value
+        //  - a view can fall back to a second object for members it doesn't have, so
+        //    entities can override template components without merging copies
+        class View
+        {
+        public:
+            class ArrayRange
+            {
+            public:
+                class Iterator
+                {
+                private:
+                    Node const *node;
+
+                public:
+                    Iterator(Node const *node)
+                        : node(node)
+                    {
+                    }
+
+                    View operator * (void) const
+                    {
+                        return View(node);
+                    }
+
+                    Iterator &operator ++ (void)
+                    {
+                        ++node;
+                        return (*this);
+                    }
+
+                    bool operator != (Iterator const &iterator) const
+                    {
+                        return (node != iterator.node);
+                    }
+                };
+
+            private:
+                Node const *first;
+                Node const *last;
+
+            public:
+                ArrayRange(Node const *first, Node const *last)
+                    : first(first)
+                    , last(last)
+                {
+                }
+
+                Iterator begin(void) const
+                {
+                    return Iterator(first);
+                }
+
+                Iterator end(void) const
+                {
+                    return Iterator(last);
+                }
+
+                std::size_t size(void) const
+                {
+                    return (last - first);
+                }
+            };
+
+            using MemberList = std::vector<std::pair<std::string_view, View>>;
+
+        private:
+            Node const *node = nullptr;
+            Node const *fallback = nullptr;
+
+        public:
+            View(void) = default;
+            View(Node const *node, Node const *fallback = nullptr)
+                : node(node)
+                , fallback(fallback)
+            {
+            }
+
+            bool isEmpty(void) const;
+            bool isObject(void) const;
+            bool isArray(void) const;
+            bool isString(void) const;
+            bool isFloat(void) const;
+            bool isBoolean(void) const;
+
+            // Returns a view that uses this object's members first, followed by the fallback's
+            View withFallback(View const &fallback) const;
+
+            bool has(std::string_view name) const;
+            View get(std::string_view name) const;
+            View at(std::size_t index) const;
+
+            std::size_t getSize(void) const;
+            ArrayRange getArray(void) const;
+            MemberList getMembers(void) const;
+
+            std::string_view getString(std::string_view defaultValue = std::string_view()) const;
+            double getNumber(double defaultValue) const;
+
+            // Deep copy in to a mutable object, for code that still needs a full tree
+            Object getObject(void) const;
+
+            std::string convert(std::string const &defaultValue) const;
+            bool convert(bool defaultValue) const;
+            int32_t convert(int32_t defaultValue) const;
+            uint32_t convert(uint32_t defaultValue) const;
+            float convert(float defaultValue) const;
+            Math::Float2 convert(Math::Float2 const &defaultValue) const;
+            Math::Float3 convert(Math::Float3 const &defaultValue) const;
+            Math::Float4 convert(Math::Float4 const &defaultValue) const;
+            Math::Quaternion convert(Math::Quaternion const &defaultValue) const;
+
+            std::string parse(ShuntingYard &shuntingYard, std::string const &defaultValue) const;
+            bool parse(ShuntingYard &shuntingYard, bool defaultValue) const;
+            int32_t parse(ShuntingYard &shuntingYard, int32_t defaultValue) const;
+            uint32_t parse(ShuntingYard &shuntingYard, uint32_t defaultValue) const;
+            float parse(ShuntingYard &shuntingYard, float defaultValue) const;
+            Math::Float2 parse(ShuntingYard &shuntingYard, Math::Float2 const &defaultValue) const;
+            Math::Float3 parse(ShuntingYard &shuntingYard, Math::Float3 const &defaultValue) const;
+            Math::Float4 parse(ShuntingYard &shuntingYard, Math::Float4 const &defaultValue) const;
+            Math::Quaternion parse(ShuntingYard &shuntingYard, Math::Quaternion const &defaultValue) const;
+
+        private:
+            Node const *find(Node const *object, std::string_view name) const;
+        };
+
+        // Read-only tree built straight from a Reader
+        //  - every node, member and decoded string lives in a few large arena blocks
+        //  - strings without escape sequences point back in to the source text
+        class Document
+        {
+        private:
+            std::unique_ptr<std::string> text;
+            std::vector<std::unique_ptr<uint8_t[]>> blockList;
+            std::size_t blockSize = 0;
+            std::size_t blockOffset = 0;
+            Node const *root = nullptr;
+
+        public:
+            Document(void) = default;
+            Document(Document &&document) = default;
+            Document &operator = (Document &&document) = default;
+
+            Document(Document const &) = delete;
+            Document &operator = (Document const &) = delete;
+
+            static Document Load(FileSystem::Path const &filePath);
+            static Document Make(Object const &object);
+
+            bool parse(std::string &&text);
+
+            View getRoot(void) const
+            {
+                return View(root);
+            }
+
+        private:
+            void *allocate(std::size_t size, std::size_t alignment);
+            std::string_view store(std::string_view string, bool copy);
+        };
+    }; // namespace JSON
+}; // namespace Gek
@@ -0,0 +1,77 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+namespace Gek
+{
+    // Memory accounting per subsystem
+    //  - tagged allocators count against their own tag, wherever the container using them is filled
+    //  - builds with GEK_MEMORY_TRACKING replace global new and delete, which count against the calling thread's current tag,
+    //    set by a Scope around the work of a subsystem
+    //  - counters and the current tag are shared by the application and every plugin, the same as the profiler's buffers
+    namespace Memory
+    {
+        enum class Tag : uint8_t
+        {
+            General = 0,
+            Renderer,
+            Population,
+            Resources,
+            Physics,
+            Models,
+            Particles,
+            Audio,
+            Editor,
+            Count,
+        };
+
+        char const *GetTagName(Tag tag);
+
+        struct Counters
+        {
+            // Bytes allocated now, and the most that have been allocated at once
+            uint64_t currentSize = 0;
+            uint64_t peakSize = 0;
+
+            uint64_t totalAllocationCount = 0;
+
+            // Allocations made during the last frame ended by EndFrame
+            uint64_t frameAllocationCount = 0;
+        };
+
+        Counters GetCounters(Tag tag);
+
+        // Called once per frame, by the core, to start counting the next frame's allocations
+        void EndFrame(void);
+
+        // Only true in builds with GEK_MEMORY_TRACKING
+        bool IsTrackingGlobalAllocations(void);
+
+        void *Allocate(Tag tag, std::size_t size, std::size_t alignment);
+        void Free(Tag tag, void *pointer, std::size_t size);
+
+        Tag GetCurrentTag(void);
+
+        // Counts global allocations made by this thread against a tag until the scope ends
+        class Scope
+        {
+        private:
+            Tag previousTag;
+
+        public:
+            Scope(Tag tag);
+            ~Scope(void);
+
+            Scope(Scope const &) = delete;
+            Scope &operator = (Scope const &) = delete;
+        };
+    }; // namespace Memory
+}; // namespace Gek
@@ -0,0 +1,99 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/FileSystem.hpp"
+#include <cstdint>
+#include <vector>
+
+namespace Gek
+{
+    // CPU instrumentation, recorded into one ring buffer per thread
+    //  - zones and counters refer to a static Location for their call site, so recording an event never formats or allocates
+    //  - each thread only ever writes to its own buffer, the newest events overwrite the oldest once it's full
+    //  - nothing is recorded until the profiler is enabled, then a zone costs two clock reads and two buffer writes
+    //  - buffers are best exported between frames, events written during an export may be missing or torn
+    //  - one profiler is shared by the application and every plugin, export before unloading plugins since events point at their locations
+    namespace Profiler
+    {
+        struct Location
+        {
+            char const *name;
+            char const *file;
+            uint32_t line;
+        };
+
+        void SetEnabled(bool enabled);
+        bool IsEnabled(void);
+
+        // Name the calling thread is shown with in exported traces
+        void SetThreadName(std::string const &name);
+
+        // Both return false, and record nothing, if the profiler is disabled
+        bool BeginZone(Location const *location);
+        bool SetCounter(Location const *location, double value);
+
+        void EndZone(Location const *location);
+
+        // Drops every event recorded so far
+        void Clear(void);
+
+        // Writes every recorded event as Chrome trace event JSON, readable by chrome://tracing and Perfetto
+        void ExportChromeTrace(FileSystem::Path const &filePath);
+
+        struct ZoneSummary
+        {
+            std::string name;
+            uint64_t count = 0;
+            double totalTime = 0.0;
+            double maximumTime = 0.0;
+        };
+
+        // Count and times, in milliseconds, of every zone that both began and ended within the recorded events,
+        // zones from all threads and call sites that share a name are added together
+        std::vector<ZoneSummary> GetZoneSummary(void);
+
+        class Zone
+        {
+        private:
+            Location const *location;
+
+        public:
+            Zone(Location const *location)
+                : location(BeginZone(location) ? location : nullptr)
+            {
+            }
+
+            ~Zone(void)
+            {
+                if (location)
+                {
+                    EndZone(location);
+                }
+            }
+
+            Zone(Zone const &) = delete;
+            Zone &operator = (Zone const &) = delete;
+        };
+    }; // namespace Profiler
+}; // namespace Gek
+
+#define GEK_PROFILER_CONCATENATE_INNER(LEFT, RIGHT) LEFT##RIGHT
+#define GEK_PROFILER_CONCATENATE(LEFT, RIGHT) GEK_PROFILER_CONCATENATE_INNER(LEFT, RIGHT)
+
+// Times the rest of the enclosing scope
+#define GEK_PROFILE_ZONE(NAME) \
+    static Gek::Profiler::Location const GEK_PROFILER_CONCATENATE(profilerLocation, __LINE__) = { NAME, __FILE__, __LINE__ }; \
+    Gek::Profiler::Zone GEK_PROFILER_CONCATENATE(profilerZone, __LINE__)(&GEK_PROFILER_CONCATENATE(profilerLocation, __LINE__))
+
+#define GEK_PROFILE_COUNTER(NAME, VALUE) \
+    do \
+    { \
+        static Gek::Profiler::Location const profilerLocation = { NAME, __FILE__, __LINE__ }; \
+        Gek::Profiler::SetCounter(&profilerLocation, double(VALUE)); \
+    } while (false)
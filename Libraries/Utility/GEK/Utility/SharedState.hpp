@@ -0,0 +1,19 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+namespace Gek
+{
+    // Utility is linked statically into the application and into every plugin, so each module starts out with
+    // its own copy of the global state (mounted archives, identifiers, etc), the context hands the application's copy to
+    // every plugin it loads so that all modules read and write the same state
+    struct SharedState;
+
+    SharedState *GetSharedState(void);
+    void SetSharedState(SharedState *sharedState);
+}; // namespace Gek
@@ -76,7 +76,7 @@ namespace Gek
                 Lock lock(queueMutex);
                 if (stop)
                 {
-                    return
+                    return;
                 }
 
                 taskQueue.emplace(std::bind(std::forward<FUNCTION>(function), std::forward<PARAMETERS>(arguments)...));
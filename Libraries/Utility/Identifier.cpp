@@ -0,0 +1,143 @@
+#include "GEK/Utility/Identifier.hpp"
+#include "GEK/Utility/String.hpp"
+#include <unordered_map>
+#include <shared_mutex>
+#include <iostream>
+#include <memory>
+#include <atomic>
+#include <array>
+#include <mutex>
+
+namespace Gek
+{
+    struct IdentifierState
+    {
+        struct Entry
+        {
+            std::string name;
+            uint64_t hash = 0;
+        };
+
+        // Entries live in fixed size chunks that never move, so reading an entry by index doesn't need a lock
+        //  - an index is only handed out after its entry has been written
+        static constexpr uint32_t ChunkSize = 1024;
+        static constexpr uint32_t ChunkCount = 1024;
+        std::mutex entryMutex;
+        std::array<std::unique_ptr<Entry[]>, ChunkCount> chunkList;
+        std::atomic<uint32_t> entryCount = 1;
+
+        // Lookups by name are split across several locks, so threads interning different names rarely wait on each other
+        struct Shard
+        {
+            std::shared_mutex mutex;
+            std::unordered_multimap<uint64_t, uint32_t> indexMap;
+        };
+
+        static constexpr uint32_t ShardCount = 16;
+        std::array<Shard, ShardCount> shardList;
+
+        IdentifierState(void)
+        {
+            // Index zero is the empty identifier
+            chunkList[0] = std::make_unique<Entry[]>(ChunkSize);
+        }
+
+        Entry const &getEntry(uint32_t index) const
+        {
+            return chunkList[index / ChunkSize][index % ChunkSize];
+        }
+
+        uint32_t findIndex(Shard &shard, std::string_view name, uint64_t hash) const
+        {
+            auto indexRange = shard.indexMap.equal_range(hash);
+            for (auto indexSearch = indexRange.first; indexSearch != indexRange.second; ++indexSearch)
+            {
+                if (getEntry(indexSearch->second).name == name)
+                {
+                    return indexSearch->second;
+                }
+            }
+
+            return 0;
+        }
+
+        uint32_t intern(std::string_view name, uint64_t hash)
+        {
+            if (name.empty())
+            {
+                return 0;
+            }
+
+            auto &shard = shardList[hash % ShardCount];
+            if (true)
+            {
+                std::shared_lock<std::shared_mutex> lock(shard.mutex);
+                auto index = findIndex(shard, name, hash);
+                if (index)
+                {
+                    return index;
+                }
+            }
+
+            std::unique_lock<std::shared_mutex> lock(shard.mutex);
+            auto index = findIndex(shard, name, hash);
+            if (index)
+            {
+                return index;
+            }
+
+            auto indexSearch = shard.indexMap.find(hash);
+            if (indexSearch != std::end(shard.indexMap))
+            {
+                LockedWrite{ std::cerr } << String::Format("Identifier collision between %v and %v", getEntry(indexSearch->second).name, std::string(name));
+            }
+
+            std::unique_lock<std::mutex> entryLock(entryMutex);
+            index = entryCount.load(std::memory_order_relaxed);
+            if (index >= (ChunkSize * ChunkCount))
+            {
+                LockedWrite{ std::cerr } << String::Format("Identifier table full, unable to add: %v", std::string(name));
+                return 0;
+            }
+
+            auto &chunk = chunkList[index / ChunkSize];
+            if (!chunk)
+            {
+                chunk = std::make_unique<Entry[]>(ChunkSize);
+            }
+
+            auto &entry = chunk[index % ChunkSize];
+            entry.name = name;
+            entry.hash = hash;
+            entryCount.store(index + 1, std::memory_order_release);
+            entryLock.unlock();
+
+            shard.indexMap.insert(std::make_pair(hash, index));
+            return index;
+        }
+    };
+
+    // Plugins are pointed at the application's table when they're loaded, see SharedState
+    static IdentifierState localIdentifierState;
+    IdentifierState *currentIdentifierState = &localIdentifierState;
+
+    Identifier::Identifier(std::string_view name)
+        : index(currentIdentifierState->intern(name, MakeHash(name.data(), name.size())))
+    {
+    }
+
+    Identifier::Identifier(Literal const &literal)
+        : index(currentIdentifierState->intern(std::string_view(literal.string, literal.length), literal.hash))
+    {
+    }
+
+    uint64_t Identifier::getHash(void) const
+    {
+        return currentIdentifierState->getEntry(index).hash;
+    }
+
+    std::string const &Identifier::getString(void) const
+    {
+        return currentIdentifierState->getEntry(index).name;
+    }
+}; // namespace Gek
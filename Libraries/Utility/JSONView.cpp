@@ -0,0 +1,1119 @@
+#include "GEK/Utility/JSONView.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include <algorithm>
+#include <iostream>
+#include <cstdlib>
+
+namespace Gek
+{
+    namespace JSON
+    {
+        // Reader
+        Reader::Reader(std::string_view text)
+            : text(text)
+        {
+        }
+
+        Reader::Token Reader::fail(char const *message)
+        {
+            if (error.empty())
+            {
+                error = String::Format("%v, at offset %v", message, position);
+            }
+
+            return Token::Error;
+        }
+
+        void Reader::skipWhiteSpace(void)
+        {
+            while (position < text.size())
+            {
+                switch (text[position])
+                {
+                case ' ':
+                case '\t':
+                case '\r':
+                case '\n':
+                    ++position;
+                    break;
+
+                default:
+                    return;
+                };
+            };
+        }
+
+        Reader::Token Reader::next(void)
+        {
+            if (!error.empty())
+            {
+                return Token::Error;
+            }
+
+            skipWhiteSpace();
+            if (frameStack.empty())
+            {
+                if (rootFinished)
+                {
+                    return (position < text.size() ? fail("Unexpected data after root value") : Token::End);
+                }
+
+                return readValue();
+            }
+
+            if (position >= text.size())
+            {
+                return fail("Unexpected end of data");
+            }
+
+            auto &frame = frameStack.back();
+            char character = text[position];
+            if (frame.isObject)
+            {
+                if (frame.state == Frame::Name)
+                {
+                    if (character != ':')
+                    {
+                        return fail("Expected ':' after member name");
+                    }
+
+                    ++position;
+                    skipWhiteSpace();
+                    frame.state = Frame::Value;
+                    return readValue();
+                }
+
+                if (character == '}')
+                {
+                    ++position;
+                    frameStack.pop_back();
+                    rootFinished = frameStack.empty();
+                    return Token::EndObject;
+                }
+
+                if (frame.state == Frame::Value)
+                {
+                    if (character != ',')
+                    {
+                        return fail("Expected ',' or '}' after member");
+                    }
+
+                    ++position;
+                    skipWhiteSpace();
+                }
+
+                if (position >= text.size() || text[position] != '"')
+                {
+                    return fail("Expected member name");
+                }
+
+                frame.state = Frame::Name;
+                return readString(Token::Name);
+            }
+            else
+            {
+                if (character == ']')
+                {
+                    ++position;
+                    frameStack.pop_back();
+                    rootFinished = frameStack.empty();
+                    return Token::EndArray;
+                }
+
+                if (frame.state == Frame::Value)
+                {
+                    if (character != ',')
+                    {
+                        return fail("Expected ',' or ']' after element");
+                    }
+
+                    ++position;
+                    skipWhiteSpace();
+                }
+
+                frame.state = Frame::Value;
+                return readValue();
+            }
+        }
+
+        Reader::Token Reader::readValue(void)
+        {
+            if (position >= text.size())
+            {
+                return fail("Unexpected end of data");
+            }
+
+            Token token = Token::Error;
+            switch (text[position])
+            {
+            case '{':
+                ++position;
+                frameStack.push_back({ true, Frame::Open });
+                return Token::BeginObject;
+
+            case '[':
+                ++position;
+                frameStack.push_back({ false, Frame::Open });
+                return Token::BeginArray;
+
+            case '"':
+                token = readString(Token::String);
+                break;
+
+            case 't':
+                token = readLiteral("true", Token::Boolean, true);
+                break;
+
+            case 'f':
+                token = readLiteral("false", Token::Boolean, false);
+                break;
+
+            case 'n':
+                token = readLiteral("null", Token::Null, false);
+                break;
+
+            default:
+                token = readNumber();
+                break;
+            };
+
+            if (frameStack.empty())
+            {
+                rootFinished = true;
+            }
+
+            return token;
+        }
+
+        Reader::Token Reader::readString(Token token)
+        {
+            auto start = ++position;
+            while (position < text.size() && text[position] != '"' && text[position] != '\\')
+            {
+                ++position;
+            };
+
+            if (position >= text.size())
+            {
+                return fail("Unterminated string");
+            }
+
+            if (text[position] == '"')
+            {
+                string = text.substr(start, (position++ - start));
+                stringCopied = false;
+                return token;
+            }
+
+            // Escape sequences need decoding, continue in to the scratch buffer
+            scratch.assign(text.data() + start, (position - start));
+            while (position < text.size() && text[position] != '"')
+            {
+                char character = text[position++];
+                if (character != '\\')
+                {
+                    scratch.push_back(character);
+                    continue;
+                }
+
+                if (position >= text.size())
+                {
+                    break;
+                }
+
+                character = text[position++];
+                switch (character)
+                {
+                case '"':
+                case '\\':
+                case '/':
+                    scratch.push_back(character);
+                    break;
+
+                case 'b':
+                    scratch.push_back('\b');
+                    break;
+
+                case 'f':
+                    scratch.push_back('\f');
+                    break;
+
+                case 'n':
+                    scratch.push_back('\n');
+                    break;
+
+                case 'r':
+                    scratch.push_back('\r');
+                    break;
+
+                case 't':
+                    scratch.push_back('\t');
+                    break;
+
+                case 'u':
+                    if (true)
+                    {
+                        auto readHex = [&](uint32_t &value) -> bool
+                        {
+                            if ((position + 4) > text.size())
+                            {
+                                return false;
+                            }
+
+                            value = 0;
+                            for (uint32_t digit = 0; digit < 4; ++digit)
+                            {
+                                char hex = text[position++];
+                                value <<= 4;
+                                if (hex >= '0' && hex <= '9') value |= (hex - '0');
+                                else if (hex >= 'a' && hex <= 'f') value |= (hex - 'a' + 10);
+                                else if (hex >= 'A' && hex <= 'F') value |= (hex - 'A' + 10);
+                                else return false;
+                            }
+
+                            return true;
+                        };
+
+                        uint32_t codePoint = 0;
+                        if (!readHex(codePoint))
+                        {
+                            return fail("Invalid unicode escape sequence");
+                        }
+
+                        // Surrogate pairs are combined before encoding
+                        if (codePoint >= 0xD800 && codePoint <= 0xDBFF && (position + 2) <= text.size() && text[position] == '\\' && text[position + 1] == 'u')
+                        {
+                            position += 2;
+                            uint32_t lowSurrogate = 0;
+                            if (!readHex(lowSurrogate))
+                            {
+                                return fail("Invalid unicode escape sequence");
+                            }
+
+                            codePoint = (0x10000 + ((codePoint - 0xD800) << 10) + (lowSurrogate - 0xDC00));
+                        }
+
+                        if (codePoint < 0x80)
+                        {
+                            scratch.push_back(char(codePoint));
+                        }
+                        else if (codePoint < 0x800)
+                        {
+                            scratch.push_back(char(0xC0 | (codePoint >> 6)));
+                            scratch.push_back(char(0x80 | (codePoint & 0x3F)));
+                        }
+                        else if (codePoint < 0x10000)
+                        {
+                            scratch.push_back(char(0xE0 | (codePoint >> 12)));
+                            scratch.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                            scratch.push_back(char(0x80 | (codePoint & 0x3F)));
+                        }
+                        else
+                        {
+                            scratch.push_back(char(0xF0 | (codePoint >> 18)));
+                            scratch.push_back(char(0x80 | ((codePoint >> 12) & 0x3F)));
+                            scratch.push_back(char(0x80 | ((codePoint >> 6) & 0x3F)));
+                            scratch.push_back(char(0x80 | (codePoint & 0x3F)));
+                        }
+                    }
+
+                    break;
+
+                default:
+                    return fail("Invalid escape sequence");
+                };
+            };
+
+            if (position >= text.size())
+            {
+                return fail("Unterminated string");
+            }
+
+            ++position;
+            string = scratch;
+            stringCopied = true;
+            return token;
+        }
+
+        Reader::Token Reader::readNumber(void)
+        {
+            auto start = position;
+            while (position < text.size())
+            {
+                char character = text[position];
+                if ((character >= '0' && character <= '9') || character == '-' || character == '+' || character == '.' || character == 'e' || character == 'E')
+                {
+                    ++position;
+                }
+                else
+                {
+                    break;
+                }
+            };
+
+            if (position == start)
+            {
+                return fail("Unexpected character");
+            }
+
+            // The source text isn't guaranteed to be null terminated
+            char buffer[64];
+            std::string longNumber;
+            char const *numberText = buffer;
+            auto length = (position - start);
+            if (length < sizeof(buffer))
+            {
+                std::copy(text.data() + start, text.data() + position, buffer);
+                buffer[length] = '\0';
+            }
+            else
+            {
+                longNumber.assign(text.data() + start, length);
+                numberText = longNumber.c_str();
+            }
+
+            char *end = nullptr;
+            number = std::strtod(numberText, &end);
+            if (end != (numberText + length))
+            {
+                return fail("Invalid number");
+            }
+
+            return Token::Number;
+        }
+
+        Reader::Token Reader::readLiteral(std::string_view literal, Token token, bool value)
+        {
+            if (text.compare(position, literal.size(), literal) != 0)
+            {
+                return fail("Unexpected character");
+            }
+
+            position += literal.size();
+            boolean = value;
+            return token;
+        }
+
+        // View
+        Node const *View::find(Node const *object, std::string_view name) const
+        {
+            if (object && object->type == Node::Type::Object)
+            {
+                // Search backwards so the last of any duplicated names wins
+                for (auto member = (object->memberList + object->size); member != object->memberList; )
+                {
+                    --member;
+                    if (member->name == name)
+                    {
+                        return &member->value;
+                    }
+                }
+            }
+
+            return nullptr;
+        }
+
+        bool View::isEmpty(void) const
+        {
+            if (!node || node->type == Node::Type::Null)
+            {
+                return true;
+            }
+
+            if (node->type == Node::Type::Array || node->type == Node::Type::Object)
+            {
+                return (node->size == 0 && !fallback);
+            }
+
+            return false;
+        }
+
+        bool View::isObject(void) const
+        {
+            return (node && node->type == Node::Type::Object);
+        }
+
+        bool View::isArray(void) const
+        {
+            return (node && node->type == Node::Type::Array);
+        }
+
+        bool View::isString(void) const
+        {
+            return (node && node->type == Node::Type::String);
+        }
+
+        bool View::isFloat(void) const
+        {
+            return (node && node->type == Node::Type::Number);
+        }
+
+        bool View::isBoolean(void) const
+        {
+            return (node && node->type == Node::Type::Boolean);
+        }
+
+        View View::withFallback(View const &fallback) const
+        {
+            if (isObject() && fallback.isObject())
+            {
+                return View(node, fallback.node);
+            }
+
+            return (*this);
+        }
+
+        bool View::has(std::string_view name) const
+        {
+            return (find(node, name) || find(fallback, name));
+        }
+
+        View View::get(std::string_view name) const
+        {
+            auto value = find(node, name);
+            return View(value ? value : find(fallback, name));
+        }
+
+        View View::at(std::size_t index) const
+        {
+            if (isArray() && index < node->size)
+            {
+                return View(&node->elementList[index]);
+            }
+
+            return View();
+        }
+
+        std::size_t View::getSize(void) const
+        {
+            return (isArray() ? node->size : 0);
+        }
+
+        View::ArrayRange View::getArray(void) const
+        {
+            if (isArray())
+            {
+                return ArrayRange(node->elementList, (node->elementList + node->size));
+            }
+
+            return ArrayRange(nullptr, nullptr);
+        }
+
+        View::MemberList View::getMembers(void) const
+        {
+            MemberList memberList;
+            if (isObject())
+            {
+                memberList.reserve(node->size + (fallback ? fallback->size : 0));
+                for (uint32_t index = 0; index < node->size; ++index)
+                {
+                    memberList.push_back(std::make_pair(node->memberList[index].name, View(&node->memberList[index].value)));
+                }
+
+                if (fallback)
+                {
+                    for (uint32_t index = 0; index < fallback->size; ++index)
+                    {
+                        auto const &member = fallback->memberList[index];
+                        if (!find(node, member.name))
+                        {
+                            memberList.push_back(std::make_pair(member.name, View(&member.value)));
+                        }
+                    }
+                }
+            }
+
+            return memberList;
+        }
+
+        std::string_view View::getString(std::string_view defaultValue) const
+        {
+            return (isString() ? std::string_view(node->string, node->size) : defaultValue);
+        }
+
+        double View::getNumber(double defaultValue) const
+        {
+            return (isFloat() ? node->number : defaultValue);
+        }
+
+        Object View::getObject(void) const
+        {
+            if (!node)
+            {
+                return Object::null();
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::Boolean:
+                return Object(node->boolean);
+
+            case Node::Type::Number:
+                return Object(node->number);
+
+            case Node::Type::String:
+                return Object(std::string(node->string, node->size));
+
+            case Node::Type::Array:
+                if (true)
+                {
+                    Object array = Object::make_array();
+                    for (auto element : getArray())
+                    {
+                        array.add(element.getObject());
+                    }
+
+                    return array;
+                }
+
+            case Node::Type::Object:
+                if (true)
+                {
+                    Object object;
+                    for (auto const &member : getMembers())
+                    {
+                        object[std::string(member.first)] = member.second.getObject();
+                    }
+
+                    return object;
+                }
+
+            default:
+                return Object::null();
+            };
+        }
+
+        std::string View::convert(std::string const &defaultValue) const
+        {
+            if (!node)
+            {
+                return String::Empty;
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::String:
+                return std::string(node->string, node->size);
+
+            case Node::Type::Number:
+                return String::Format("%v", node->number);
+
+            case Node::Type::Boolean:
+                return (node->boolean ? "true" : "false");
+
+            default:
+                return String::Empty;
+            };
+        }
+
+        bool View::convert(bool defaultValue) const
+        {
+            if (!node)
+            {
+                return defaultValue;
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::String:
+                return String::Convert(std::string(node->string, node->size), defaultValue);
+
+            case Node::Type::Boolean:
+                return node->boolean;
+
+            case Node::Type::Number:
+                return (node->number != 0.0);
+
+            default:
+                return defaultValue;
+            };
+        }
+
+        int32_t View::convert(int32_t defaultValue) const
+        {
+            if (!node)
+            {
+                return defaultValue;
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::String:
+                return String::Convert(std::string(node->string, node->size), defaultValue);
+
+            case Node::Type::Boolean:
+                return (node->boolean ? 1 : 0);
+
+            case Node::Type::Number:
+                return static_cast<int32_t>(static_cast<int64_t>(node->number));
+
+            default:
+                return defaultValue;
+            };
+        }
+
+        uint32_t View::convert(uint32_t defaultValue) const
+        {
+            if (!node)
+            {
+                return defaultValue;
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::String:
+                return String::Convert(std::string(node->string, node->size), defaultValue);
+
+            case Node::Type::Boolean:
+                return (node->boolean ? 1 : 0);
+
+            case Node::Type::Number:
+                return static_cast<uint32_t>(static_cast<int64_t>(node->number));
+
+            default:
+                return defaultValue;
+            };
+        }
+
+        float View::convert(float defaultValue) const
+        {
+            if (!node)
+            {
+                return defaultValue;
+            }
+
+            switch (node->type)
+            {
+            case Node::Type::String:
+                return String::Convert(std::string(node->string, node->size), defaultValue);
+
+            case Node::Type::Boolean:
+                return (node->boolean ? 1.0f : 0.0f);
+
+            case Node::Type::Number:
+                return static_cast<float>(node->number);
+
+            default:
+                return defaultValue;
+            };
+        }
+
+        Math::Float2 View::convert(Math::Float2 const &defaultValue) const
+        {
+            if (getSize() == 2)
+            {
+                return Math::Float2(
+                    at(0).convert(defaultValue.x),
+                    at(1).convert(defaultValue.y));
+            }
+
+            return defaultValue;
+        }
+
+        Math::Float3 View::convert(Math::Float3 const &defaultValue) const
+        {
+            if (getSize() == 3)
+            {
+                return Math::Float3(
+                    at(0).convert(defaultValue.x),
+                    at(1).convert(defaultValue.y),
+                    at(2).convert(defaultValue.z));
+            }
+
+            return defaultValue;
+        }
+
+        Math::Float4 View::convert(Math::Float4 const &defaultValue) const
+        {
+            if (getSize() == 3)
+            {
+                return Math::Float4(
+                    at(0).convert(defaultValue.x),
+                    at(1).convert(defaultValue.y),
+                    at(2).convert(defaultValue.z),
+                    defaultValue.w);
+            }
+            else if (getSize() == 4)
+            {
+                return Math::Float4(
+                    at(0).convert(defaultValue.x),
+                    at(1).convert(defaultValue.y),
+                    at(2).convert(defaultValue.z),
+                    at(3).convert(defaultValue.w));
+            }
+
+            return defaultValue;
+        }
+
+        Math::Quaternion View::convert(Math::Quaternion const &defaultValue) const
+        {
+            if (getSize() == 3)
+            {
+                float pitch = at(0).convert(Math::Infinity);
+                float yaw = at(1).convert(Math::Infinity);
+                float roll = at(2).convert(Math::Infinity);
+                if (pitch != Math::Infinity && yaw != Math::Infinity && roll != Math::Infinity)
+                {
+                    return Math::Quaternion::MakeEulerRotation(pitch, yaw, roll);
+                }
+            }
+            else if (getSize() == 4)
+            {
+                return Math::Quaternion(
+                    at(0).convert(defaultValue.x),
+                    at(1).convert(defaultValue.y),
+                    at(2).convert(defaultValue.z),
+                    at(3).convert(defaultValue.w));
+            }
+
+            return defaultValue;
+        }
+
+        std::string View::parse(ShuntingYard &shuntingYard, std::string const &defaultValue) const
+        {
+            if (!node || node->type == Node::Type::Null || node->type == Node::Type::Array || node->type == Node::Type::Object)
+            {
+                return defaultValue;
+            }
+
+            return convert(defaultValue);
+        }
+
+        bool View::parse(ShuntingYard &shuntingYard, bool defaultValue) const
+        {
+            if (isString())
+            {
+                return shuntingYard.evaluate(std::string(node->string, node->size)).value_or(defaultValue) != 0.0f;
+            }
+
+            return convert(defaultValue);
+        }
+
+        int32_t View::parse(ShuntingYard &shuntingYard, int32_t defaultValue) const
+        {
+            if (isString())
+            {
+                return static_cast<int32_t>(shuntingYard.evaluate(std::string(node->string, node->size)).value_or(defaultValue));
+            }
+
+            return convert(defaultValue);
+        }
+
+        uint32_t View::parse(ShuntingYard &shuntingYard, uint32_t defaultValue) const
+        {
+            if (isString())
+            {
+                return static_cast<uint32_t>(shuntingYard.evaluate(std::string(node->string, node->size)).value_or(defaultValue));
+            }
+
+            return convert(defaultValue);
+        }
+
+        float View::parse(ShuntingYard &shuntingYard, float defaultValue) const
+        {
+            if (isString())
+            {
+                return shuntingYard.evaluate(std::string(node->string, node->size)).value_or(defaultValue);
+            }
+            else if (getSize() == 1)
+            {
+                return at(0).parse(shuntingYard, defaultValue);
+            }
+
+            return convert(defaultValue);
+        }
+
+        Math::Float2 View::parse(ShuntingYard &shuntingYard, Math::Float2 const &defaultValue) const
+        {
+            if (getSize() == 1)
+            {
+                return Math::Float2(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(0).parse(shuntingYard, defaultValue.y));
+            }
+            else if (getSize() == 2)
+            {
+                return Math::Float2(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(1).parse(shuntingYard, defaultValue.y));
+            }
+
+            return Math::Float2(
+                parse(shuntingYard, defaultValue.x),
+                parse(shuntingYard, defaultValue.y));
+        }
+
+        Math::Float3 View::parse(ShuntingYard &shuntingYard, Math::Float3 const &defaultValue) const
+        {
+            if (getSize() == 1)
+            {
+                return Math::Float3(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(0).parse(shuntingYard, defaultValue.y),
+                    at(0).parse(shuntingYard, defaultValue.z));
+            }
+            else if (getSize() == 3)
+            {
+                return Math::Float3(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(1).parse(shuntingYard, defaultValue.y),
+                    at(2).parse(shuntingYard, defaultValue.z));
+            }
+
+            return Math::Float3(
+                parse(shuntingYard, defaultValue.x),
+                parse(shuntingYard, defaultValue.y),
+                parse(shuntingYard, defaultValue.z));
+        }
+
+        Math::Float4 View::parse(ShuntingYard &shuntingYard, Math::Float4 const &defaultValue) const
+        {
+            if (getSize() == 1)
+            {
+                return Math::Float4(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(0).parse(shuntingYard, defaultValue.y),
+                    at(0).parse(shuntingYard, defaultValue.z),
+                    at(0).parse(shuntingYard, defaultValue.w));
+            }
+            else if (getSize() == 3)
+            {
+                return Math::Float4(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(1).parse(shuntingYard, defaultValue.y),
+                    at(2).parse(shuntingYard, defaultValue.z),
+                    defaultValue.w);
+            }
+            else if (getSize() == 4)
+            {
+                return Math::Float4(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(1).parse(shuntingYard, defaultValue.y),
+                    at(2).parse(shuntingYard, defaultValue.z),
+                    at(3).parse(shuntingYard, defaultValue.w));
+            }
+
+            return Math::Float4(
+                parse(shuntingYard, defaultValue.x),
+                parse(shuntingYard, defaultValue.y),
+                parse(shuntingYard, defaultValue.z),
+                parse(shuntingYard, defaultValue.w));
+        }
+
+        Math::Quaternion View::parse(ShuntingYard &shuntingYard, Math::Quaternion const &defaultValue) const
+        {
+            if (getSize() == 3)
+            {
+                float pitch = at(0).parse(shuntingYard, Math::Infinity);
+                float yaw = at(1).parse(shuntingYard, Math::Infinity);
+                float roll = at(2).parse(shuntingYard, Math::Infinity);
+                if (pitch != Math::Infinity && yaw != Math::Infinity && roll != Math::Infinity)
+                {
+                    return Math::Quaternion::MakeEulerRotation(pitch, yaw, roll);
+                }
+            }
+            else if (getSize() == 4)
+            {
+                return Math::Quaternion(
+                    at(0).parse(shuntingYard, defaultValue.x),
+                    at(1).parse(shuntingYard, defaultValue.y),
+                    at(2).parse(shuntingYard, defaultValue.z),
+                    at(3).parse(shuntingYard, defaultValue.w));
+            }
+
+            return defaultValue;
+        }
+
+        // Document
+        Document Document::Load(FileSystem::Path const &filePath)
+        {
+            Document document;
+            if (!document.parse(FileSystem::Load(filePath, String::Empty)))
+            {
+                LockedWrite{ std::cerr } << String::Format("Unable to parse JSON file: %v", filePath.u8string());
+            }
+
+            return document;
+        }
+
+        Document Document::Make(Object const &object)
+        {
+            Document document;
+            document.parse(object.to_string());
+            return document;
+        }
+
+        void *Document::allocate(std::size_t size, std::size_t alignment)
+        {
+            if (size > blockSize)
+            {
+                // Oversized requests get a block of their own, inserted behind the one being filled
+                auto block = std::make_unique<uint8_t[]>(size);
+                auto data = block.get();
+                blockList.insert((blockList.empty() ? std::end(blockList) : std::prev(std::end(blockList))), std::move(block));
+                if (blockList.size() == 1)
+                {
+                    blockOffset = blockSize;
+                }
+
+                return data;
+            }
+
+            auto offset = ((blockOffset + (alignment - 1)) & ~(alignment - 1));
+            if (blockList.empty() || (offset + size) > blockSize)
+            {
+                blockList.push_back(std::make_unique<uint8_t[]>(blockSize));
+                offset = 0;
+            }
+
+            blockOffset = (offset + size);
+            return (blockList.back().get() + offset);
+        }
+
+        std::string_view Document::store(std::string_view string, bool copy)
+        {
+            if (!copy || string.empty())
+            {
+                return string;
+            }
+
+            auto data = static_cast<char *>(allocate(string.size(), 1));
+            std::copy(std::begin(string), std::end(string), data);
+            return std::string_view(data, string.size());
+        }
+
+        bool Document::parse(std::string &&source)
+        {
+            // Strings point back in to the source, so it's held where moving the document won't relocate it
+            text = std::make_unique<std::string>(std::move(source));
+            blockList.clear();
+            blockSize = std::max<std::size_t>((64 * 1024), std::min<std::size_t>(text->size(), (4 * 1024 * 1024)));
+            blockOffset = 0;
+            root = nullptr;
+
+            struct Frame
+            {
+                bool isObject;
+                std::size_t start;
+                std::string_view name;
+            };
+
+            std::vector<Frame> frameStack;
+            std::vector<Node> elementStack;
+            std::vector<Member> memberStack;
+            std::string_view memberName;
+            auto addNode = [&](Node const &node) -> void
+            {
+                if (frameStack.empty())
+                {
+                    auto rootNode = new (allocate(sizeof(Node), alignof(Node))) Node(node);
+                    root = rootNode;
+                }
+                else if (frameStack.back().isObject)
+                {
+                    memberStack.push_back({ memberName, node });
+                }
+                else
+                {
+                    elementStack.push_back(node);
+                }
+            };
+
+            Reader reader(*text);
+            for (;;)
+            {
+                Node node;
+                switch (reader.next())
+                {
+                case Reader::Token::Error:
+                    LockedWrite{ std::cerr } << reader.getError();
+                    root = nullptr;
+                    return false;
+
+                case Reader::Token::End:
+                    return (root != nullptr);
+
+                case Reader::Token::BeginObject:
+                    frameStack.push_back({ true, memberStack.size(), memberName });
+                    break;
+
+                case Reader::Token::BeginArray:
+                    frameStack.push_back({ false, elementStack.size(), memberName });
+                    break;
+
+                case Reader::Token::EndObject:
+                    if (true)
+                    {
+                        auto frame = frameStack.back();
+                        frameStack.pop_back();
+
+                        auto count = (memberStack.size() - frame.start);
+                        auto memberList = static_cast<Member *>(allocate(sizeof(Member) * count, alignof(Member)));
+                        std::uninitialized_copy(std::begin(memberStack) + frame.start, std::end(memberStack), memberList);
+                        memberStack.resize(frame.start);
+
+                        node.type = Node::Type::Object;
+                        node.size = uint32_t(count);
+                        node.memberList = memberList;
+                        memberName = frame.name;
+                        addNode(node);
+                    }
+
+                    break;
+
+                case Reader::Token::EndArray:
+                    if (true)
+                    {
+                        auto frame = frameStack.back();
+                        frameStack.pop_back();
+
+                        auto count = (elementStack.size() - frame.start);
+                        auto elementList = static_cast<Node *>(allocate(sizeof(Node) * count, alignof(Node)));
+                        std::uninitialized_copy(std::begin(elementStack) + frame.start, std::end(elementStack), elementList);
+                        elementStack.resize(frame.start);
+
+                        node.type = Node::Type::Array;
+                        node.size = uint32_t(count);
+                        node.elementList = elementList;
+                        memberName = frame.name;
+                        addNode(node);
+                    }
+
+                    break;
+
+                case Reader::Token::Name:
+                    memberName = store(reader.getString(), reader.isStringCopied());
+                    break;
+
+                case Reader::Token::String:
+                    if (true)
+                    {
+                        auto string = store(reader.getString(), reader.isStringCopied());
+                        node.type = Node::Type::String;
+                        node.size = uint32_t(string.size());
+                        node.string = string.data();
+                        addNode(node);
+                    }
+
+                    break;
+
+                case Reader::Token::Number:
+                    node.type = Node::Type::Number;
+                    node.number = reader.getNumber();
+                    addNode(node);
+                    break;
+
+                case Reader::Token::Boolean:
+                    node.type = Node::Type::Boolean;
+                    node.boolean = reader.getBoolean();
+                    addNode(node);
+                    break;
+
+                case Reader::Token::Null:
+                    addNode(node);
+                    break;
+                };
+            };
+        }
+    }; // namespace JSON
+}; // namespace Gek
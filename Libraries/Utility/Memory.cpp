@@ -0,0 +1,283 @@
+#include "GEK/Utility/Memory.hpp"
+#include <xmmintrin.h>
+#include <algorithm>
+#include <cstdlib>
+#include <atomic>
+#include <new>
+
+namespace Gek
+{
+    namespace Memory
+    {
+        struct TagCounters
+        {
+            std::atomic<uint64_t> currentSize = 0;
+            std::atomic<uint64_t> peakSize = 0;
+            std::atomic<uint64_t> totalAllocationCount = 0;
+            std::atomic<uint64_t> currentFrameAllocationCount = 0;
+            std::atomic<uint64_t> frameAllocationCount = 0;
+        };
+
+        static const std::size_t TagCount = static_cast<std::size_t>(Tag::Count);
+
+        static thread_local Tag currentTag = Tag::General;
+
+        static Tag &getLocalCurrentTag(void)
+        {
+            return currentTag;
+        }
+
+        struct State
+        {
+            TagCounters tagCountersList[TagCount];
+
+            // Thread locals are per module too, every module goes through the owning module's so scopes apply across modules
+            Tag &(*getCurrentTag)(void) = getLocalCurrentTag;
+        };
+
+        // Plain constant initialized storage, global new can be called before any dynamic initializers have run
+        // Plugins are pointed at the application's state when they're loaded, see SharedState
+        static State localState;
+        State *currentState = &localState;
+
+        static TagCounters &getTagCounters(Tag tag)
+        {
+            return currentState->tagCountersList[static_cast<std::size_t>(tag)];
+        }
+
+        static void recordAllocation(TagCounters &tagCounters, std::size_t size)
+        {
+            auto currentSize = (tagCounters.currentSize.fetch_add(size, std::memory_order_relaxed) + size);
+            auto peakSize = tagCounters.peakSize.load(std::memory_order_relaxed);
+            while (currentSize > peakSize && !tagCounters.peakSize.compare_exchange_weak(peakSize, currentSize, std::memory_order_relaxed))
+            {
+            };
+
+            tagCounters.totalAllocationCount.fetch_add(1, std::memory_order_relaxed);
+            tagCounters.currentFrameAllocationCount.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        static void recordFree(TagCounters &tagCounters, std::size_t size)
+        {
+            tagCounters.currentSize.fetch_sub(size, std::memory_order_relaxed);
+        }
+
+        char const *GetTagName(Tag tag)
+        {
+            static char const * const TagNameList[TagCount] =
+            {
+                "General",
+                "Renderer",
+                "Population",
+                "Resources",
+                "Physics",
+                "Models",
+                "Particles",
+                "Audio",
+                "Editor",
+            };
+
+            return (tag < Tag::Count ? TagNameList[static_cast<std::size_t>(tag)] : "Unknown");
+        }
+
+        Counters GetCounters(Tag tag)
+        {
+            Counters counters;
+            if (tag < Tag::Count)
+            {
+                auto &tagCounters = getTagCounters(tag);
+                counters.currentSize = tagCounters.currentSize.load(std::memory_order_relaxed);
+                counters.peakSize = tagCounters.peakSize.load(std::memory_order_relaxed);
+                counters.totalAllocationCount = tagCounters.totalAllocationCount.load(std::memory_order_relaxed);
+                counters.frameAllocationCount = tagCounters.frameAllocationCount.load(std::memory_order_relaxed);
+            }
+
+            return counters;
+        }
+
+        void EndFrame(void)
+        {
+            for (auto &tagCounters : currentState->tagCountersList)
+            {
+                tagCounters.frameAllocationCount.store(tagCounters.currentFrameAllocationCount.exchange(0, std::memory_order_relaxed), std::memory_order_relaxed);
+            }
+        }
+
+        bool IsTrackingGlobalAllocations(void)
+        {
+#ifdef GEK_MEMORY_TRACKING
+            return true;
+#else
+            return false;
+#endif
+        }
+
+        void *Allocate(Tag tag, std::size_t size, std::size_t alignment)
+        {
+            void *pointer = _mm_malloc(size, alignment);
+            if (pointer)
+            {
+                recordAllocation(getTagCounters(tag), size);
+            }
+
+            return pointer;
+        }
+
+        void Free(Tag tag, void *pointer, std::size_t size)
+        {
+            if (pointer)
+            {
+                recordFree(getTagCounters(tag), size);
+                _mm_free(pointer);
+            }
+        }
+
+        Tag GetCurrentTag(void)
+        {
+            return currentState->getCurrentTag();
+        }
+
+        Scope::Scope(Tag tag)
+            : previousTag(GetCurrentTag())
+        {
+            currentState->getCurrentTag() = tag;
+        }
+
+        Scope::~Scope(void)
+        {
+            currentState->getCurrentTag() = previousTag;
+        }
+
+#ifdef GEK_MEMORY_TRACKING
+        // Stored just before every block global new returns, so delete knows what to take off which tag
+        // Keeps the counters themselves, blocks allocated before a plugin is handed the shared state still balance
+        struct GlobalHeader
+        {
+            void *block;
+            std::size_t size;
+            TagCounters *tagCounters;
+        };
+
+        static void *globalAllocate(std::size_t size, std::size_t alignment)
+        {
+            alignment = std::max(alignment, alignof(GlobalHeader));
+            void *block = std::malloc(size + sizeof(GlobalHeader) + alignment);
+            if (!block)
+            {
+                return nullptr;
+            }
+
+            auto address = ((reinterpret_cast<std::uintptr_t>(block) + sizeof(GlobalHeader) + alignment - 1) & ~(alignment - 1));
+            auto header = (reinterpret_cast<GlobalHeader *>(address) - 1);
+            header->block = block;
+            header->size = size;
+            header->tagCounters = &getTagCounters(GetCurrentTag());
+            recordAllocation(*header->tagCounters, size);
+            return reinterpret_cast<void *>(address);
+        }
+
+        static void *globalAllocateOrThrow(std::size_t size, std::size_t alignment)
+        {
+            void *pointer = globalAllocate(size, alignment);
+            if (!pointer)
+            {
+                throw std::bad_alloc();
+            }
+
+            return pointer;
+        }
+
+        static void globalFree(void *pointer)
+        {
+            if (pointer)
+            {
+                auto header = (static_cast<GlobalHeader *>(pointer) - 1);
+                recordFree(*header->tagCounters, header->size);
+                std::free(header->block);
+            }
+        }
+#endif
+    }; // namespace Memory
+}; // namespace Gek
+
+#ifdef GEK_MEMORY_TRACKING
+void *operator new(std::size_t size)
+{
+    return Gek::Memory::globalAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](std::size_t size)
+{
+    return Gek::Memory::globalAllocateOrThrow(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(std::size_t size, std::nothrow_t const &) noexcept
+{
+    return Gek::Memory::globalAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new[](std::size_t size, std::nothrow_t const &) noexcept
+{
+    return Gek::Memory::globalAllocate(size, __STDCPP_DEFAULT_NEW_ALIGNMENT__);
+}
+
+void *operator new(std::size_t size, std::align_val_t alignment)
+{
+    return Gek::Memory::globalAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void *operator new[](std::size_t size, std::align_val_t alignment)
+{
+    return Gek::Memory::globalAllocateOrThrow(size, static_cast<std::size_t>(alignment));
+}
+
+void operator delete(void *pointer) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete[](void *pointer) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete(void *pointer, std::nothrow_t const &) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete[](void *pointer, std::nothrow_t const &) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete(void *pointer, std::align_val_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete[](void *pointer, std::align_val_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete(void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+
+void operator delete[](void *pointer, std::size_t, std::align_val_t) noexcept
+{
+    Gek::Memory::globalFree(pointer);
+}
+#endif
@@ -0,0 +1,318 @@
+#include "GEK/Utility/Profiler.hpp"
+#include <algorithm>
+#include <sstream>
+#include <iomanip>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <map>
+
+namespace Gek
+{
+    namespace Profiler
+    {
+        enum class EventType : uint8_t
+        {
+            Begin = 0,
+            End,
+            Counter,
+        };
+
+        struct Event
+        {
+            uint64_t time;
+            Location const *location;
+            double value;
+            EventType type;
+        };
+
+        struct ThreadBuffer
+        {
+            static constexpr uint64_t Capacity = (1 << 16);
+
+            uint32_t identifier = 0;
+            std::string name;
+            std::unique_ptr<Event[]> eventList;
+
+            // Only ever written by the owning thread
+            std::atomic<uint64_t> writeCount = 0;
+
+            // Events before this one were dropped by Clear
+            std::atomic<uint64_t> clearCount = 0;
+        };
+
+        using Clock = std::chrono::high_resolution_clock;
+
+        struct State;
+        static ThreadBuffer *getLocalThreadBuffer(State &state);
+
+        struct State
+        {
+            Clock::time_point const startTime = Clock::now();
+            std::atomic<bool> enabled = false;
+            std::mutex bufferMutex;
+            std::vector<std::unique_ptr<ThreadBuffer>> bufferList;
+
+            // Thread locals are per module too, every module goes through the owning module's so a thread only has one buffer
+            ThreadBuffer *(*getThreadBuffer)(State &state) = getLocalThreadBuffer;
+        };
+
+        // Plugins are pointed at the application's state when they're loaded, see SharedState
+        static State localState;
+        State *currentState = &localState;
+
+        static thread_local ThreadBuffer *currentBuffer = nullptr;
+
+        static ThreadBuffer *getLocalThreadBuffer(State &state)
+        {
+            if (!currentBuffer)
+            {
+                std::unique_lock<std::mutex> lock(state.bufferMutex);
+                state.bufferList.push_back(std::make_unique<ThreadBuffer>());
+                currentBuffer = state.bufferList.back().get();
+                currentBuffer->identifier = uint32_t(state.bufferList.size());
+            }
+
+            return currentBuffer;
+        }
+
+        static ThreadBuffer *getThreadBuffer(void)
+        {
+            auto &state = *currentState;
+            return state.getThreadBuffer(state);
+        }
+
+        static void record(EventType type, Location const *location, double value)
+        {
+            auto buffer = getThreadBuffer();
+            if (!buffer->eventList)
+            {
+                buffer->eventList = std::make_unique<Event[]>(ThreadBuffer::Capacity);
+            }
+
+            auto index = buffer->writeCount.load(std::memory_order_relaxed);
+            auto &event = buffer->eventList[index & (ThreadBuffer::Capacity - 1)];
+            event.time = uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - currentState->startTime).count());
+            event.location = location;
+            event.value = value;
+            event.type = type;
+            buffer->writeCount.store((index + 1), std::memory_order_release);
+        }
+
+        void SetEnabled(bool enabled)
+        {
+            currentState->enabled.store(enabled, std::memory_order_relaxed);
+        }
+
+        bool IsEnabled(void)
+        {
+            return currentState->enabled.load(std::memory_order_relaxed);
+        }
+
+        void SetThreadName(std::string const &name)
+        {
+            auto buffer = getThreadBuffer();
+            std::unique_lock<std::mutex> lock(currentState->bufferMutex);
+            buffer->name = name;
+        }
+
+        bool BeginZone(Location const *location)
+        {
+            if (!IsEnabled())
+            {
+                return false;
+            }
+
+            record(EventType::Begin, location, 0.0);
+            return true;
+        }
+
+        bool SetCounter(Location const *location, double value)
+        {
+            if (!IsEnabled())
+            {
+                return false;
+            }
+
+            record(EventType::Counter, location, value);
+            return true;
+        }
+
+        void EndZone(Location const *location)
+        {
+            record(EventType::End, location, 0.0);
+        }
+
+        void Clear(void)
+        {
+            auto &state = *currentState;
+            std::unique_lock<std::mutex> lock(state.bufferMutex);
+            for (auto &buffer : state.bufferList)
+            {
+                buffer->clearCount.store(buffer->writeCount.load(std::memory_order_acquire));
+            }
+        }
+
+        static void writeString(std::ostringstream &stream, char const *string)
+        {
+            stream << '"';
+            for (; string && *string; ++string)
+            {
+                auto character = *string;
+                switch (character)
+                {
+                case '"':
+                case '\\':
+                    stream << '\\' << character;
+                    break;
+
+                default:
+                    if (static_cast<unsigned char>(character) < 0x20)
+                    {
+                        stream << "\\u" << std::hex << std::setw(4) << std::setfill('0') << uint32_t(character) << std::dec << std::setfill(' ');
+                    }
+                    else
+                    {
+                        stream << character;
+                    }
+
+                    break;
+                };
+            }
+
+            stream << '"';
+        }
+
+        void ExportChromeTrace(FileSystem::Path const &filePath)
+        {
+            std::ostringstream stream;
+            stream << std::fixed << std::setprecision(3);
+            stream << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+
+            bool firstEvent = true;
+            auto beginEvent = [&](char const *phase, char const *name, uint32_t threadIdentifier) -> void
+            {
+                stream << (firstEvent ? "\n" : ",\n") << "{\"ph\":\"" << phase << "\",\"pid\":0,\"tid\":" << threadIdentifier << ",\"name\":";
+                writeString(stream, name);
+                firstEvent = false;
+            };
+
+            auto &state = *currentState;
+            std::unique_lock<std::mutex> lock(state.bufferMutex);
+            for (auto const &buffer : state.bufferList)
+            {
+                if (!buffer->name.empty())
+                {
+                    beginEvent("M", "thread_name", buffer->identifier);
+                    stream << ",\"args\":{\"name\":";
+                    writeString(stream, buffer->name.c_str());
+                    stream << "}}";
+                }
+
+                if (!buffer->eventList)
+                {
+                    continue;
+                }
+
+                auto writeCount = buffer->writeCount.load(std::memory_order_acquire);
+                auto firstIndex = std::max(buffer->clearCount.load(), (writeCount > ThreadBuffer::Capacity ? (writeCount - ThreadBuffer::Capacity) : 0));
+
+                // Zones that began before the oldest event still in the buffer have nothing to end
+                uint32_t depth = 0;
+                for (auto index = firstIndex; index < writeCount; ++index)
+                {
+                    auto const &event = buffer->eventList[index & (ThreadBuffer::Capacity - 1)];
+                    switch (event.type)
+                    {
+                    case EventType::Begin:
+                        beginEvent("B", event.location->name, buffer->identifier);
+                        stream << ",\"ts\":" << (event.time / 1000.0) << ",\"args\":{\"file\":";
+                        writeString(stream, event.location->file);
+                        stream << ",\"line\":" << event.location->line << "}}";
+                        ++depth;
+                        break;
+
+                    case EventType::End:
+                        if (depth > 0)
+                        {
+                            beginEvent("E", event.location->name, buffer->identifier);
+                            stream << ",\"ts\":" << (event.time / 1000.0) << "}";
+                            --depth;
+                        }
+
+                        break;
+
+                    case EventType::Counter:
+                        beginEvent("C", event.location->name, buffer->identifier);
+                        stream << ",\"ts\":" << (event.time / 1000.0) << ",\"args\":{\"value\":" << event.value << "}}";
+                        break;
+                    };
+                }
+            }
+
+            lock.unlock();
+            stream << "\n]}\n";
+            FileSystem::Save(filePath, stream.str());
+        }
+
+        std::vector<ZoneSummary> GetZoneSummary(void)
+        {
+            std::map<std::string, ZoneSummary> summaryMap;
+            std::vector<uint64_t> beginTimeStack;
+
+            auto &state = *currentState;
+            std::unique_lock<std::mutex> lock(state.bufferMutex);
+            for (auto const &buffer : state.bufferList)
+            {
+                if (!buffer->eventList)
+                {
+                    continue;
+                }
+
+                auto writeCount = buffer->writeCount.load(std::memory_order_acquire);
+                auto firstIndex = std::max(buffer->clearCount.load(), (writeCount > ThreadBuffer::Capacity ? (writeCount - ThreadBuffer::Capacity) : 0));
+
+                beginTimeStack.clear();
+                for (auto index = firstIndex; index < writeCount; ++index)
+                {
+                    auto const &event = buffer->eventList[index & (ThreadBuffer::Capacity - 1)];
+                    switch (event.type)
+                    {
+                    case EventType::Begin:
+                        beginTimeStack.push_back(event.time);
+                        break;
+
+                    case EventType::End:
+                        if (!beginTimeStack.empty())
+                        {
+                            double zoneTime = ((event.time - beginTimeStack.back()) / 1000000.0);
+                            beginTimeStack.pop_back();
+
+                            auto &summary = summaryMap[event.location->name];
+                            ++summary.count;
+                            summary.totalTime += zoneTime;
+                            summary.maximumTime = std::max(summary.maximumTime, zoneTime);
+                        }
+
+                        break;
+
+                    default:
+                        break;
+                    };
+                }
+            }
+
+            lock.unlock();
+
+            std::vector<ZoneSummary> summaryList;
+            summaryList.reserve(summaryMap.size());
+            for (auto &summaryPair : summaryMap)
+            {
+                summaryPair.second.name = summaryPair.first;
+                summaryList.push_back(std::move(summaryPair.second));
+            }
+
+            return summaryList;
+        }
+    }; // namespace Profiler
+}; // namespace Gek
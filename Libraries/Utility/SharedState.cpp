@@ -0,0 +1,55 @@
+#include "GEK/Utility/SharedState.hpp"
+
+namespace Gek
+{
+    // Each subsystem keeps a pointer to its state, which starts out at the module's own instance
+    struct IdentifierState;
+    extern IdentifierState *currentIdentifierState;
+
+    namespace FileSystem
+    {
+        struct MountState;
+        extern MountState *currentMountState;
+    }; // namespace FileSystem
+
+    namespace Profiler
+    {
+        struct State;
+        extern State *currentState;
+    }; // namespace Profiler
+
+    namespace Memory
+    {
+        struct State;
+        extern State *currentState;
+    }; // namespace Memory
+
+    struct SharedState
+    {
+        FileSystem::MountState *mountState = nullptr;
+        Profiler::State *profilerState = nullptr;
+        Memory::State *memoryState = nullptr;
+        IdentifierState *identifierState = nullptr;
+    };
+
+    SharedState *GetSharedState(void)
+    {
+        static SharedState sharedState =
+        {
+            FileSystem::currentMountState,
+            Profiler::currentState,
+            Memory::currentState,
+            currentIdentifierState,
+        };
+
+        return &sharedState;
+    }
+
+    void SetSharedState(SharedState *sharedState)
+    {
+        FileSystem::currentMountState = sharedState->mountState;
+        Profiler::currentState = sharedState->profilerState;
+        Memory::currentState = sharedState->memoryState;
+        currentIdentifierState = sharedState->identifierState;
+    }
+}; // namespace Gek
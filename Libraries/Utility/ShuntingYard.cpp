@@ -70,7 +70,7 @@ namespace Gek
     }
 
 	ShuntingYard::ShuntingYard(void)
-        : mersineTwister(std::random_device()())
+        : mersineTwister(seed)
     {
         variableMap["pi"] = Math::Pi;
         variableMap["tau"] = Math::Tau;
@@ -1,4 +1,5 @@
 #include "GEK/Utility/ThreadPool.hpp"
+#include "GEK/Utility/Profiler.hpp"
 
 #ifdef _WIN32
 #include <Windows.h>
@@ -45,6 +46,7 @@ namespace Gek
 #ifdef _WIN32
                 CoInitializeEx(nullptr, COINITBASE_MULTITHREADED);
 #endif
+				Profiler::SetThreadName("Thread Pool Worker");
 				for (;;)
 				{
 					// Task to execute
@@ -72,6 +74,7 @@ namespace Gek
 					}
 
 					// Execute
+					GEK_PROFILE_ZONE("Thread Pool Task");
 					task();
 				}
 
@@ -1,4 +1,5 @@
 ﻿#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Processor.hpp"
 #include "GEK/Engine/Population.hpp"
@@ -44,7 +45,7 @@ namespace Gek
             componentData["target"] = data->target;
         }
 
-        void load(Components::FirstPersonCamera * const data, JSON::Reference componentData)
+        void load(Components::FirstPersonCamera * const data, JSON::View componentData)
         {
             data->fieldOfView = Math::DegreesToRadians(parse(componentData.get("fieldOfView"), 90.0f));
             data->nearClip = parse(componentData.get("nearClip"), 1.0f);
@@ -175,6 +176,8 @@ namespace Gek
         // Plugin::Population Slots
         void onUpdate(float frameTime)
         {
+            GEK_PROFILE_ZONE("Camera Update");
+
             assert(renderer);
 
             bool editorActive = core->getOption("editor", "active").convert(false);
@@ -188,7 +191,7 @@ namespace Gek
                         name = &entity->getComponent<Components::Name>().name;
                     }
 
-                    auto viewMatrix(transformComponent.getMatrix().getInverse());
+                    auto viewMatrix(transformComponent.cachedMatrix.getInverse());
 
                     const auto backBuffer = core->getVideoDevice()->getBackBuffer();
                     const float width = float(backBuffer->getDescription().width);
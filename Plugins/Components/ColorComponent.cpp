@@ -27,7 +27,7 @@ namespace Gek
             componentData = JSON::Make(data->value);
         }
 
-        void load(Components::Color * const data, JSON::Reference componentData)
+        void load(Components::Color * const data, JSON::View componentData)
         {
             data->value = parse(componentData, Math::Float4::White);
         }
@@ -14,22 +14,81 @@
 
 namespace Gek
 {
+    namespace Processor
+    {
+        GEK_INTERFACE(Transform)
+        {
+            virtual ~Transform(void) = default;
+
+            // Queues a node to have its world values rebuilt, along with everything attached to it, safe to call from any thread
+            virtual void setDirty(uint32_t nodeIndex) = 0;
+        };
+    }; // namespace Processor
+
     namespace Components
     {
         GEK_COMPONENT(Transform)
         {
+            // Relative to the parent entity, or in world space if there isn't one
             Math::Float3 position = Math::Float3::Zero;
             Math::Quaternion rotation = Math::Quaternion::Identity;
             Math::Float3 scale = Math::Float3::One;
 
+            // Name of the entity this one is attached to, empty to place it directly in the world,
+            // physics bodies are simulated in world space so shouldn't be attached to anything
+            std::string parent;
+
+            // World space values of attached entities, kept up to date by the transform processor
+            Math::Float3 worldPosition = Math::Float3::Zero;
+            Math::Quaternion worldRotation = Math::Quaternion::Identity;
+            Math::Float3 worldScale = Math::Float3::One;
+
+            // World matrices cached by the transform processor each update, for per frame work like culling and lighting,
+            // use getMatrix and getScaledMatrix for values that may have been set since the last update
+            Math::Float4x4 cachedMatrix = Math::Float4x4::Identity;
+            Math::Float4x4 cachedScaledMatrix = Math::Float4x4::Identity;
+
+            // Bumped whenever the cached values change, so anything derived from them can tell when it's stale
+            uint32_t version = 0;
+
+            // Set by the transform processor when it builds the hierarchy
+            Processor::Transform *processor = nullptr;
+            uint32_t nodeIndex = 0;
+
+            // Call after changing the position, rotation or scale, the transform processor only rebuilds the world values
+            // of transforms that were marked dirty and the ones attached to them
+            inline void setDirty(void)
+            {
+                if (processor)
+                {
+                    processor->setDirty(nodeIndex);
+                }
+            }
+
+            inline Math::Float3 const &getWorldPosition(void) const
+            {
+                return (parent.empty() ? position : worldPosition);
+            }
+
+            inline Math::Quaternion const &getWorldRotation(void) const
+            {
+                return (parent.empty() ? rotation : worldRotation);
+            }
+
+            inline Math::Float3 const &getWorldScale(void) const
+            {
+                return (parent.empty() ? scale : worldScale);
+            }
+
+            // World space matrix, including every parent, built from the current values
             inline Math::Float4x4 getMatrix(void) const
             {
-                return Math::Float4x4::MakeQuaternionRotation(rotation, position);
+                return Math::Float4x4::MakeQuaternionRotation(getWorldRotation(), getWorldPosition());
             }
 
             inline Math::Float4x4 getScaledMatrix(void) const
             {
-                return (Math::Float4x4::MakeScaling(scale) * getMatrix());
+                return (Math::Float4x4::MakeScaling(getWorldScale()) * getMatrix());
             }
         };
     }; // namespace Components
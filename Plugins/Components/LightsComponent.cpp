@@ -23,7 +23,7 @@ namespace Gek
             componentData.set("intensity", data->intensity);
         }
 
-        void load(Components::PointLight * const data, JSON::Reference componentData)
+        void load(Components::PointLight * const data, JSON::View componentData)
         {
             data->range = parse(componentData.get("range"), 0.0f);
             data->radius = parse(componentData.get("radius"), 0.0f);
@@ -80,7 +80,7 @@ namespace Gek
             componentData.set("coneFalloff", data->coneFalloff);
         }
 
-        void load(Components::SpotLight * const data, JSON::Reference componentData)
+        void load(Components::SpotLight * const data, JSON::View componentData)
         {
             data->range = parse(componentData.get("range"), 0.0f);
             data->radius = parse(componentData.get("radius"), 0.0f);
@@ -149,7 +149,7 @@ namespace Gek
             componentData.set("intensity", data->intensity);
         }
 
-        void load(Components::DirectionalLight * const data, JSON::Reference componentData)
+        void load(Components::DirectionalLight * const data, JSON::View componentData)
         {
             data->intensity = parse(componentData.get("intensity"), 0.0f);
         }
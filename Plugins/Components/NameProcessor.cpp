@@ -25,7 +25,7 @@ namespace Gek
             componentData = data->name;
         }
 
-        void load(Components::Name * const data, JSON::Reference componentData)
+        void load(Components::Name * const data, JSON::View componentData)
         {
             data->name = componentData.convert(String::Empty);
         }
@@ -158,7 +158,8 @@ namespace Gek
         // Model::Processor
         Plugin::Entity *getEntity(std::string const &name)
         {
-            return nullptr;
+            auto nameSearch = nameMap.find(name);
+            return (nameSearch == std::end(nameMap) ? nullptr : nameSearch->second);
         }
 
         // Plugin::Editor Slots
@@ -173,6 +174,7 @@ namespace Gek
         // Plugin::Population Slots
         void onReset(void)
         {
+            nameMap.clear();
             clear();
         }
 
@@ -1,4 +1,5 @@
 ﻿#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Processor.hpp"
 #include "GEK/Engine/Population.hpp"
@@ -35,7 +36,7 @@ namespace Gek
         {
         }
 
-        void load(Components::Spin * const data, JSON::Reference componentData)
+        void load(Components::Spin * const data, JSON::View componentData)
         {
             data->torque.x = population->getShuntingYard().evaluate("random(-pi,pi)").value_or(0.0f);
             data->torque.y = population->getShuntingYard().evaluate("random(-pi,pi)").value_or(0.0f);
@@ -71,6 +72,8 @@ namespace Gek
         // Plugin::Population Slots
         void onUpdate(float frameTime)
         {
+            GEK_PROFILE_ZONE("Spin Update");
+
             assert(population);
 
             bool editorActive = core->getOption("editor", "active").convert(false);
@@ -80,6 +83,7 @@ namespace Gek
                 {
                     auto omega(spinComponent.torque * frameTime);
                     transformComponent.rotation *= Math::Quaternion::MakeEulerRotation(omega.x, omega.y, omega.z);
+                    transformComponent.setDirty();
                 });
             }
         }
@@ -21,12 +21,17 @@ namespace Gek
         {
             componentData["position"] = JSON::Make(data->position);
             componentData["rotation"] = JSON::Make(data->rotation);
+            if (!data->parent.empty())
+            {
+                componentData["parent"] = data->parent;
+            }
         }
 
-        void load(Components::Transform * const data, JSON::Reference componentData)
+        void load(Components::Transform * const data, JSON::View componentData)
         {
             data->position = parse(componentData.get("position"), Math::Float3::Zero);
             data->rotation = parse(componentData.get("rotation"), Math::Quaternion::Identity);
+            data->parent = parse(componentData.get("parent"), String::Empty);
             LockedWrite{ std::cout } << String::Format("Position: [%v, %v, %v]", data->position.x, data->position.y, data->position.z);
 		}
 
@@ -53,6 +58,11 @@ namespace Gek
                 return ImGui::InputFloat3("##scale", transformComponent.scale.data, 4, ImGuiInputTextFlags_CharsDecimal | ImGuiInputTextFlags_CharsNoBlank);
             });
 
+            changed |= editorElement("Parent", [&](void) -> bool
+            {
+                return UI::InputString("##parent", transformComponent.parent, ImGuiInputTextFlags_EnterReturnsTrue);
+            });
+
             ImGui::SetCurrentContext(nullptr);
             return changed;
         }
@@ -0,0 +1,419 @@
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Engine/Core.hpp"
+#include "GEK/Engine/Processor.hpp"
+#include "GEK/Engine/Population.hpp"
+#include "GEK/Engine/Entity.hpp"
+#include "GEK/Engine/Editor.hpp"
+#include "GEK/Engine/ComponentMixin.hpp"
+#include "GEK/Components/Transform.hpp"
+#include "GEK/Components/Name.hpp"
+#include <concurrent_vector.h>
+#include <unordered_map>
+#include <algorithm>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <vector>
+#include <atomic>
+#include <ppl.h>
+
+namespace Gek
+{
+    // Keeps the world values and cached matrices of every transform up to date
+    //  - every transform gets a node, nodes are kept in one flat list sorted by depth, with the children of each node
+    //    next to each other, so each level only ever reads the level above it and can be updated in parallel
+    //  - writers mark the transforms they change dirty, each update only visits the dirty nodes and walks down
+    //    from them to their children one level at a time, so untouched subtrees cost nothing
+    //  - the node list is rebuilt from the parent names whenever entities, or their names and parents, change
+    GEK_CONTEXT_USER(TransformProcessor, Plugin::Core *)
+        , public Plugin::ProcessorMixin<TransformProcessor, Components::Transform>
+        , public Plugin::Processor
+        , public Gek::Processor::Transform
+    {
+    public:
+        struct Data
+        {
+            // Parent name the hierarchy was last built from
+            std::string parent;
+        };
+
+        struct Node
+        {
+            Components::Transform *transform = nullptr;
+            int32_t parent = -1;
+            uint32_t level = 0;
+            uint32_t firstChild = 0;
+            uint32_t childCount = 0;
+        };
+
+    private:
+        Plugin::Core *core = nullptr;
+        Plugin::Population *population = nullptr;
+        Plugin::Editor *editor = nullptr;
+        Gek::Processor::Name *nameProcessor = nullptr;
+
+        bool rebuildRequired = true;
+        std::vector<Node> nodeList;
+        std::vector<size_t> levelList;
+
+        // Writers can mark nodes from inside parallel loops, the flag keeps each node from being queued twice
+        std::unique_ptr<std::atomic<bool>[]> dirtyFlagList;
+        concurrency::concurrent_vector<uint32_t> dirtyQueue;
+        std::vector<std::vector<uint32_t>> dirtyLevelList;
+
+        // The population sends onComponentRemoved before the component is actually removed, and doesn't say which,
+        // so entities are only checked for a missing transform at the start of the next update
+        std::vector<Plugin::Entity *> componentRemovedList;
+
+    public:
+        TransformProcessor(Context *context, Plugin::Core *core)
+            : ContextRegistration(context)
+            , core(core)
+            , population(core->getPopulation())
+        {
+            assert(population);
+
+            core->onInitialized.connect(this, &TransformProcessor::onInitialized);
+            core->onShutdown.connect(this, &TransformProcessor::onShutdown);
+            population->onReset.connect(this, &TransformProcessor::onReset);
+            population->onEntityCreated.connect(this, &TransformProcessor::onEntityCreated);
+            population->onEntityDestroyed.connect(this, &TransformProcessor::onEntityDestroyed);
+            population->onComponentAdded.connect(this, &TransformProcessor::onComponentAdded);
+            population->onComponentRemoved.connect(this, &TransformProcessor::onComponentRemoved);
+            population->onUpdate[80].connect(this, &TransformProcessor::onUpdate);
+        }
+
+        void addEntity(Plugin::Entity * const entity)
+        {
+            ProcessorMixin::addEntity(entity);
+            rebuildRequired = true;
+        }
+
+        void removeEntity(Plugin::Entity * const entity)
+        {
+            ProcessorMixin::removeEntity(entity);
+            rebuildRequired = true;
+        }
+
+        void rebuildHierarchy(void)
+        {
+            nodeList.clear();
+            levelList.clear();
+            dirtyQueue.clear();
+
+            std::vector<Plugin::Entity *> entityList;
+            std::unordered_map<Plugin::Entity *, Plugin::Entity *> parentMap;
+            std::unordered_map<Plugin::Entity *, int32_t> depthMap;
+            listEntities([&](Plugin::Entity * const entity, auto &data, auto &transformComponent) -> void
+            {
+                entityList.push_back(entity);
+                depthMap[entity] = -1;
+                data.parent = transformComponent.parent;
+                if (transformComponent.parent.empty())
+                {
+                    return;
+                }
+
+                auto parent = (nameProcessor ? nameProcessor->getEntity(transformComponent.parent) : nullptr);
+                if (parent && parent != entity && entityDataMap.find(parent) != std::end(entityDataMap))
+                {
+                    parentMap[entity] = parent;
+                }
+                else
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unable to find parent entity: %v", transformComponent.parent);
+                }
+            });
+
+            // Depth of a node is one more than its parent's, links that would form a loop are dropped
+            std::function<int32_t(Plugin::Entity *)> getDepth;
+            getDepth = [&](Plugin::Entity *entity) -> int32_t
+            {
+                auto &depth = depthMap[entity];
+                if (depth >= 0)
+                {
+                    return depth;
+                }
+
+                auto parentSearch = parentMap.find(entity);
+                if (parentSearch == std::end(parentMap))
+                {
+                    return (depth = 0);
+                }
+
+                depth = std::numeric_limits<int32_t>::max();
+                auto parentDepth = getDepth(parentSearch->second);
+                if (parentDepth == std::numeric_limits<int32_t>::max())
+                {
+                    LockedWrite{ std::cerr } << String::Format("Entity hierarchy loops back on itself: %v", entity->getComponent<Components::Transform>().parent);
+                    parentMap.erase(parentSearch);
+                    return (depthMap[entity] = 0);
+                }
+
+                return (depthMap[entity] = (parentDepth + 1));
+            };
+
+            for (auto entity : entityList)
+            {
+                getDepth(entity);
+            }
+
+            std::vector<Plugin::Entity *> orderList;
+            std::unordered_map<Plugin::Entity *, std::vector<Plugin::Entity *>> childMap;
+            for (auto entity : entityList)
+            {
+                auto parentSearch = parentMap.find(entity);
+                if (parentSearch == std::end(parentMap))
+                {
+                    orderList.push_back(entity);
+                }
+                else
+                {
+                    childMap[parentSearch->second].push_back(entity);
+                }
+            }
+
+            // Breadth first from the roots, which sorts the list by depth and keeps the children of each node together
+            nodeList.resize(orderList.size());
+            nodeList.reserve(entityList.size());
+            for (size_t index = 0; index < nodeList.size(); ++index)
+            {
+                auto entity = orderList[index];
+                nodeList[index].transform = &entity->getComponent<Components::Transform>();
+                nodeList[index].firstChild = uint32_t(nodeList.size());
+
+                auto childSearch = childMap.find(entity);
+                if (childSearch != std::end(childMap))
+                {
+                    nodeList[index].childCount = uint32_t(childSearch->second.size());
+                    for (auto child : childSearch->second)
+                    {
+                        Node childNode;
+                        childNode.parent = int32_t(index);
+                        childNode.level = (nodeList[index].level + 1);
+                        nodeList.push_back(childNode);
+                        orderList.push_back(child);
+                    }
+                }
+            }
+
+            levelList.push_back(0);
+            for (size_t index = 0; index < nodeList.size(); ++index)
+            {
+                auto &transformComponent = *nodeList[index].transform;
+                transformComponent.processor = this;
+                transformComponent.nodeIndex = uint32_t(index);
+                if (nodeList[index].level == levelList.size())
+                {
+                    levelList.push_back(index);
+                }
+            }
+
+            levelList.push_back(nodeList.size());
+            dirtyFlagList = std::make_unique<std::atomic<bool>[]>(nodeList.size());
+            dirtyLevelList.clear();
+            dirtyLevelList.resize(levelList.size() - 1);
+        }
+
+        void updateNode(uint32_t nodeIndex)
+        {
+            auto &node = nodeList[nodeIndex];
+            auto &transformComponent = *node.transform;
+            auto parentComponent = (node.parent >= 0 ? nodeList[node.parent].transform : nullptr);
+            if (parentComponent)
+            {
+                transformComponent.worldPosition = parentComponent->cachedScaledMatrix.transform(transformComponent.position);
+                transformComponent.worldRotation = (transformComponent.rotation * parentComponent->getWorldRotation());
+                transformComponent.worldScale = (transformComponent.scale * parentComponent->getWorldScale());
+            }
+            else
+            {
+                // Roots are in world space already, this only matters if their own parent couldn't be found
+                transformComponent.worldPosition = transformComponent.position;
+                transformComponent.worldRotation = transformComponent.rotation;
+                transformComponent.worldScale = transformComponent.scale;
+            }
+
+            transformComponent.cachedMatrix = transformComponent.getMatrix();
+            transformComponent.cachedScaledMatrix = (Math::Float4x4::MakeScaling(transformComponent.getWorldScale()) * transformComponent.cachedMatrix);
+            ++transformComponent.version;
+        }
+
+        // Processor::Transform
+        void setDirty(uint32_t nodeIndex)
+        {
+            // Everything is rebuilt with the hierarchy anyway, and the node indices aren't valid until it is
+            if (!rebuildRequired && nodeIndex < nodeList.size() && !dirtyFlagList[nodeIndex].exchange(true))
+            {
+                dirtyQueue.push_back(nodeIndex);
+            }
+        }
+
+        // Plugin::Core
+        void onInitialized(void)
+        {
+            core->listProcessors([&](Plugin::Processor *processor) -> void
+            {
+                auto editorCheck = dynamic_cast<Plugin::Editor *>(processor);
+                if (editorCheck)
+                {
+                    (editor = editorCheck)->onModified.connect(this, &TransformProcessor::onModified);
+                }
+
+                auto nameCheck = dynamic_cast<Gek::Processor::Name *>(processor);
+                if (nameCheck)
+                {
+                    nameProcessor = nameCheck;
+                }
+            });
+        }
+
+        void onShutdown(void)
+        {
+            if (editor)
+            {
+                editor->onModified.disconnect(this, &TransformProcessor::onModified);
+            }
+
+            population->onReset.disconnect(this, &TransformProcessor::onReset);
+            population->onEntityCreated.disconnect(this, &TransformProcessor::onEntityCreated);
+            population->onEntityDestroyed.disconnect(this, &TransformProcessor::onEntityDestroyed);
+            population->onComponentAdded.disconnect(this, &TransformProcessor::onComponentAdded);
+            population->onComponentRemoved.disconnect(this, &TransformProcessor::onComponentRemoved);
+            population->onUpdate[80].disconnect(this, &TransformProcessor::onUpdate);
+        }
+
+        // Plugin::Editor Slots
+        void onModified(Plugin::Entity * const entity, const std::type_index &type)
+        {
+            if (type == typeid(Components::Name))
+            {
+                rebuildRequired = true;
+            }
+            else if (type == typeid(Components::Transform))
+            {
+                // Moving an entity around only needs its subtree updated, changing its parent needs a new hierarchy
+                auto entitySearch = entityDataMap.find(entity);
+                if (entitySearch == std::end(entityDataMap) || entitySearch->second.parent != entity->getComponent<Components::Transform>().parent)
+                {
+                    rebuildRequired = true;
+                }
+                else
+                {
+                    entity->getComponent<Components::Transform>().setDirty();
+                }
+            }
+        }
+
+        // Plugin::Population Slots
+        void onReset(void)
+        {
+            nodeList.clear();
+            levelList.clear();
+            dirtyQueue.clear();
+            dirtyLevelList.clear();
+            componentRemovedList.clear();
+            clear();
+        }
+
+        void onEntityCreated(Plugin::Entity * const entity)
+        {
+            addEntity(entity);
+        }
+
+        void onEntityDestroyed(Plugin::Entity * const entity)
+        {
+            componentRemovedList.erase(std::remove(std::begin(componentRemovedList), std::end(componentRemovedList), entity), std::end(componentRemovedList));
+            removeEntity(entity);
+        }
+
+        void onComponentAdded(Plugin::Entity * const entity)
+        {
+            addEntity(entity);
+        }
+
+        void onComponentRemoved(Plugin::Entity * const entity)
+        {
+            componentRemovedList.push_back(entity);
+        }
+
+        void onUpdate(float frameTime)
+        {
+            GEK_PROFILE_ZONE("Transform Update");
+
+            assert(population);
+
+            for (auto entity : componentRemovedList)
+            {
+                if (!entity->hasComponent<Components::Transform>())
+                {
+                    removeEntity(entity);
+                }
+            }
+
+            componentRemovedList.clear();
+            if (rebuildRequired)
+            {
+                rebuildHierarchy();
+                rebuildRequired = false;
+                for (size_t level = 1; level < levelList.size(); ++level)
+                {
+                    concurrency::parallel_for(levelList[level - 1], levelList[level], [&](size_t index) -> void
+                    {
+                        updateNode(uint32_t(index));
+                    });
+                }
+
+                return;
+            }
+
+            for (auto nodeIndex : dirtyQueue)
+            {
+                dirtyLevelList[nodeList[nodeIndex].level].push_back(nodeIndex);
+            }
+
+            dirtyQueue.clear();
+            for (size_t level = 0; level < dirtyLevelList.size(); ++level)
+            {
+                auto &dirtyList = dirtyLevelList[level];
+                if (dirtyList.empty())
+                {
+                    continue;
+                }
+
+                concurrency::parallel_for(size_t(0), dirtyList.size(), [&](size_t index) -> void
+                {
+                    updateNode(dirtyList[index]);
+                });
+
+                // Children of an updated node are stale now too, unless they were already marked themselves
+                if ((level + 1) < dirtyLevelList.size())
+                {
+                    auto &nextDirtyList = dirtyLevelList[level + 1];
+                    for (auto nodeIndex : dirtyList)
+                    {
+                        auto const &node = nodeList[nodeIndex];
+                        for (auto childIndex = node.firstChild; childIndex < (node.firstChild + node.childCount); ++childIndex)
+                        {
+                            if (!dirtyFlagList[childIndex].exchange(true))
+                            {
+                                nextDirtyList.push_back(childIndex);
+                            }
+                        }
+                    }
+                }
+
+                for (auto nodeIndex : dirtyList)
+                {
+                    dirtyFlagList[nodeIndex] = false;
+                }
+
+                dirtyList.clear();
+            }
+        }
+    };
+
+    GEK_REGISTER_CONTEXT_USER(TransformProcessor);
+}; // namespace Gek
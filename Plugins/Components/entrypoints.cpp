@@ -10,6 +10,7 @@ namespace Gek
     GEK_DECLARE_CONTEXT_USER(SpotLight);
     GEK_DECLARE_CONTEXT_USER(DirectionalLight);
     GEK_DECLARE_CONTEXT_USER(Transform);
+    GEK_DECLARE_CONTEXT_USER(TransformProcessor);
     GEK_DECLARE_CONTEXT_USER(Spin);
     GEK_DECLARE_CONTEXT_USER(SpinProcessor);
     GEK_DECLARE_CONTEXT_USER(Name);
@@ -37,6 +38,8 @@ namespace Gek
             GEK_CONTEXT_ADD_TYPE(ProcessorType);
         GEK_CONTEXT_ADD_CLASS(Processors::SpinProcessor, SpinProcessor);
             GEK_CONTEXT_ADD_TYPE(ProcessorType);
+        GEK_CONTEXT_ADD_CLASS(Processors::TransformProcessor, TransformProcessor);
+            GEK_CONTEXT_ADD_TYPE(ProcessorType);
         GEK_CONTEXT_ADD_CLASS(Processors::NameProcessor, NameProcessor);
             GEK_CONTEXT_ADD_TYPE(ProcessorType);
     GEK_CONTEXT_END();
@@ -1,6 +1,8 @@
 ﻿#include "GEK/Utility/String.hpp"
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/Timer.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/GUI/Utilities.hpp"
 #include "GEK/GUI/Dock.hpp"
@@ -22,6 +24,7 @@ namespace Gek
         {
         private:
             WindowPtr window;
+            bool headless = false;
             bool windowActive = false;
             bool engineRunning = false;
 
@@ -43,7 +46,9 @@ namespace Gek
             int currentSelectedScene = 0;
             bool showSettings = false;
             bool showModeChange = false;
+            bool showMemory = false;
             float modeChangeTimer = 0.0f;
+            bool recordingSession = false;
 
             Timer timer;
             float mouseSensitivity = 0.5f;
@@ -73,6 +78,9 @@ namespace Gek
                     window = getContext()->createClass<Window>("Default::System::Window", description);
                 }
 
+                // A window without a native window behind it runs the engine headless, drawing to a device that only counts commands
+                headless = (window->getBaseWindow() == nullptr);
+
                 window->onClose.connect(this, &Core::onClose);
                 window->onActivate.connect(this, &Core::onActivate);
                 window->onSizeChanged.connect(this, &Core::onSizeChanged);
@@ -85,6 +93,8 @@ namespace Gek
                 window->onMouseMovement.connect(this, &Core::onMouseMovement);
 
                 configuration = JSON::Load(getContext()->getRootFileName("config.json"));
+                Profiler::SetThreadName("Main");
+                Profiler::SetEnabled(getOption("profiler", "enabled").convert(false));
 
                 HRESULT resultValue = CoInitializeEx(nullptr, COINITBASE_MULTITHREADED);
                 if (FAILED(resultValue))
@@ -94,7 +104,7 @@ namespace Gek
                 }
 
                 Video::Device::Description deviceDescription;
-                videoDevice = getContext()->createClass<Video::Device>("Default::Device::Video", window.get(), deviceDescription);
+                videoDevice = getContext()->createClass<Video::Device>((headless ? "Null::Device::Video" : "Default::Device::Video"), window.get(), deviceDescription);
 
                 uint32_t preferredDisplayMode = 0;
                 auto fullDisplayModeList = videoDevice->getDisplayModeList(deviceDescription.displayFormat);
@@ -195,7 +205,17 @@ namespace Gek
                 population = nullptr;
                 videoDevice = nullptr;
                 window = nullptr;
-                JSON::Reference(configuration).save(getContext()->getRootFileName("config.json"));
+                if (Profiler::IsEnabled())
+                {
+                    auto traceFileName(getOption("profiler", "trace").convert(String::Empty));
+                    Profiler::ExportChromeTrace(traceFileName.empty() ? getContext()->getRootFileName("trace.json") : FileSystem::Path(traceFileName));
+                }
+
+                if (!headless)
+                {
+                    JSON::Reference(configuration).save(getContext()->getRootFileName("config.json"));
+                }
+
                 CoUninitialize();
             }
 
@@ -361,40 +381,59 @@ namespace Gek
                         case Window::Key::F6:
                             population->load("autosave");
                             break;
+
+                        case Window::Key::F7:
+                            if (recordingSession)
+                            {
+                                population->stopRecording();
+                            }
+                            else
+                            {
+                                population->startRecording(getContext()->getRootFileName("data", "replays", "last").withExtension(".replay"));
+                            }
+
+                            recordingSession = !recordingSession;
+                            break;
+
+                        case Window::Key::F8:
+                            recordingSession = false;
+                            population->startReplay(getContext()->getRootFileName("data", "replays", "last").withExtension(".replay"));
+                            break;
                         };
                     }
                 }
 
                 if (!enableInterfaceControl && population)
                 {
+                    auto const &actionNames = Plugin::Population::Action::GetNames();
                     switch (key)
                     {
                     case Window::Key::W:
                     case Window::Key::Up:
-                        population->action(Plugin::Population::Action("move_forward", state));
+                        population->action(Plugin::Population::Action(actionNames.moveForward, state));
                         break;
 
                     case Window::Key::S:
                     case Window::Key::Down:
-                        population->action(Plugin::Population::Action("move_backward", state));
+                        population->action(Plugin::Population::Action(actionNames.moveBackward, state));
                         break;
 
                     case Window::Key::A:
                     case Window::Key::Left:
-                        population->action(Plugin::Population::Action("strafe_left", state));
+                        population->action(Plugin::Population::Action(actionNames.strafeLeft, state));
                         break;
 
                     case Window::Key::D:
                     case Window::Key::Right:
-                        population->action(Plugin::Population::Action("strafe_right", state));
+                        population->action(Plugin::Population::Action(actionNames.strafeRight, state));
                         break;
 
                     case Window::Key::Space:
-                        population->action(Plugin::Population::Action("jump", state));
+                        population->action(Plugin::Population::Action(actionNames.jump, state));
                         break;
 
                     case Window::Key::LeftControl:
-                        population->action(Plugin::Population::Action("crouch", state));
+                        population->action(Plugin::Population::Action(actionNames.crouch, state));
                         break;
                     };
                 }
@@ -445,8 +484,9 @@ namespace Gek
             {
                 if (population)
                 {
-                    population->action(Plugin::Population::Action("turn", xMovement * mouseSensitivity));
-                    population->action(Plugin::Population::Action("tilt", yMovement * mouseSensitivity));
+                    auto const &actionNames = Plugin::Population::Action::GetNames();
+                    population->action(Plugin::Population::Action(actionNames.turn, xMovement * mouseSensitivity));
+                    population->action(Plugin::Population::Action(actionNames.tilt, yMovement * mouseSensitivity));
                 }
             }
 
@@ -488,6 +528,12 @@ namespace Gek
                             changedVisualOptions = false;
                         }
 
+                        ImGui::Separator();
+                        if (ImGui::MenuItem("Memory"))
+                        {
+                            showMemory = true;
+                        }
+
                         ImGui::Separator();
                         if (ImGui::MenuItem("Quit", "CTRL+Q"))
                         {
@@ -503,6 +549,7 @@ namespace Gek
                     showDisplayBackup();
                     showLoadWindow();
                     showReset();
+                    showMemoryWindow();
                 }
             }
 
@@ -911,6 +958,51 @@ namespace Gek
                 }
             }
 
+            void showMemoryWindow(void)
+            {
+                if (showMemory)
+                {
+                    if (ImGui::Begin("Memory", &showMemory, ImVec2(500.0f, 0.0f), -1.0f, ImGuiWindowFlags_ShowBorders | ImGuiWindowFlags_NoSavedSettings))
+                    {
+                        if (!Memory::IsTrackingGlobalAllocations())
+                        {
+                            ImGui::Text("Only tagged containers are counted, build with GEK_MEMORY_TRACKING to count everything");
+                        }
+
+                        ImGui::Columns(5);
+                        ImGui::Text("Subsystem");
+                        ImGui::NextColumn();
+                        ImGui::Text("Current");
+                        ImGui::NextColumn();
+                        ImGui::Text("Peak");
+                        ImGui::NextColumn();
+                        ImGui::Text("Per Frame");
+                        ImGui::NextColumn();
+                        ImGui::Text("Total");
+                        ImGui::NextColumn();
+                        ImGui::Separator();
+                        for (uint8_t tag = 0; tag < static_cast<uint8_t>(Memory::Tag::Count); ++tag)
+                        {
+                            auto counters = Memory::GetCounters(static_cast<Memory::Tag>(tag));
+                            ImGui::Text(Memory::GetTagName(static_cast<Memory::Tag>(tag)));
+                            ImGui::NextColumn();
+                            ImGui::Text("%.1f KB", (double(counters.currentSize) / 1024.0));
+                            ImGui::NextColumn();
+                            ImGui::Text("%.1f KB", (double(counters.peakSize) / 1024.0));
+                            ImGui::NextColumn();
+                            ImGui::Text("%llu", static_cast<unsigned long long>(counters.frameAllocationCount));
+                            ImGui::NextColumn();
+                            ImGui::Text("%llu", static_cast<unsigned long long>(counters.totalAllocationCount));
+                            ImGui::NextColumn();
+                        }
+
+                        ImGui::Columns(1);
+                    }
+
+                    ImGui::End();
+                }
+            }
+
             // Plugin::Core
             JSON::Reference getOption(std::string const &system, std::string const &name)
             {
@@ -966,15 +1058,21 @@ namespace Gek
 
             bool update(void)
             {
+                GEK_PROFILE_ZONE("Frame");
+
                 window->readEvents();
 
                 timer.update();
 
                 // Read keyboard modifiers inputs
                 ImGuiIO &imGuiIo = ImGui::GetIO();
-                imGuiIo.KeyCtrl = (GetKeyState(VK_CONTROL) & 0x8000) != 0;
-                imGuiIo.KeyShift = (GetKeyState(VK_SHIFT) & 0x8000) != 0;
-                imGuiIo.KeyAlt = (GetKeyState(VK_MENU) & 0x8000) != 0;
+                if (!headless)
+                {
+                    imGuiIo.KeyCtrl = (GetKeyState(VK_CONTROL) & 0x8000) != 0;
+                    imGuiIo.KeyShift = (GetKeyState(VK_SHIFT) & 0x8000) != 0;
+                    imGuiIo.KeyAlt = (GetKeyState(VK_MENU) & 0x8000) != 0;
+                }
+
                 imGuiIo.KeySuper = false;
                 // imGuiIo.KeysDown : filled by WM_KEYDOWN/WM_KEYUP events
                 // imGuiIo.MousePos : filled by WM_MOUSEMOVE events
@@ -999,6 +1097,7 @@ namespace Gek
                     }
                 }
 
+                Memory::EndFrame();
                 return engineRunning;
             }
         };
@@ -4,6 +4,9 @@
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/JSON.hpp"
 #include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
+#include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/GUI/Utilities.hpp"
 #include "GEK/GUI/Dock.hpp"
 #include "GEK/GUI/Gizmo.hpp"
@@ -19,6 +22,12 @@
 #include "GEK/Model/Base.hpp"
 #include <concurrent_vector.h>
 #include <ppl.h>
+#include <unordered_map>
+#include <unordered_set>
+#include <algorithm>
+#include <future>
+#include <chrono>
+#include <mutex>
 #include <set>
 
 namespace Gek
@@ -61,6 +70,83 @@ namespace Gek
             ResourceHandle cameraTarget;
             ImVec2 cameraSize;
 
+            // Entity outliner, a sorted index of the population kept up to date from its signals
+            //  - signals only queue changes, which are applied once per frame before the editor is shown,
+            //    so names are read after the name processor has made them unique
+            //  - the index is only kept while the editor is active, and rebuilt when it's next shown
+            //  - only the rows in view are drawn, and filtering runs on its own thread against a copy of the index
+            struct OutlinerRow
+            {
+                Plugin::Entity *entity = nullptr;
+                uint64_t serial = 0;
+                bool named = false;
+                std::string name;
+                std::string searchName;
+
+                // Bit per component type, in the order of outlinerComponentList
+                uint64_t componentMask = 0;
+
+                // Named entities first by name, then unnamed entities in creation order
+                bool operator < (OutlinerRow const &row) const
+                {
+                    if (named != row.named)
+                    {
+                        return named;
+                    }
+
+                    if (named && searchName != row.searchName)
+                    {
+                        return (searchName < row.searchName);
+                    }
+
+                    return (serial < row.serial);
+                }
+            };
+
+            using OutlinerRowList = std::vector<OutlinerRow>;
+
+            // Shown entities have every component type in the mask, and a name containing the lower case text
+            struct OutlinerFilter
+            {
+                std::string text;
+                uint64_t componentMask = 0;
+
+                bool isActive(void) const
+                {
+                    return (!text.empty() || componentMask != 0);
+                }
+
+                bool matches(OutlinerRow const &row) const
+                {
+                    return ((row.componentMask & componentMask) == componentMask && (text.empty() || row.searchName.find(text) != std::string::npos));
+                }
+            };
+
+            enum class OutlinerEvent : uint8_t
+            {
+                Created = 0,
+                Destroyed,
+                Modified,
+            };
+
+            std::mutex outlinerEventMutex;
+            std::vector<std::pair<OutlinerEvent, Plugin::Entity *>> outlinerEventList;
+            bool outlinerTracking = false;
+            bool outlinerResetPending = false;
+
+            std::vector<std::type_index> outlinerComponentList;
+            std::vector<std::string> outlinerComponentNameList;
+            OutlinerRowList outlinerRowList;
+            std::unordered_map<Plugin::Entity *, uint64_t> outlinerSerialMap;
+            uint64_t nextOutlinerSerial = 0;
+
+            std::string outlinerFilterText;
+            OutlinerFilter outlinerFilter;
+            bool outlinerFilterChanged = false;
+            OutlinerRowList filteredRowList;
+            std::future<OutlinerRowList> filteredRowResult;
+            ThreadPool outlinerFilterPool;
+
         public:
             Editor(Context *context, Plugin::Core *core)
                 : ContextRegistration(context)
@@ -87,7 +173,13 @@ namespace Gek
                 core->onShutdown.connect(this, &Editor::onShutdown);
                 population->onAction.connect(this, &Editor::onAction);
                 population->onUpdate[90].connect(this, &Editor::onUpdate);
+                population->onReset.connect(this, &Editor::onReset);
+                population->onEntityCreated.connect(this, &Editor::onEntityCreated);
+                population->onEntityDestroyed.connect(this, &Editor::onEntityDestroyed);
+                population->onComponentAdded.connect(this, &Editor::onComponentAdded);
+                population->onComponentRemoved.connect(this, &Editor::onComponentRemoved);
                 renderer->onShowUserInterface.connect(this, &Editor::onShowUserInterface);
+                onModified.connect(this, &Editor::onEntityModified);
             }
 
             // Plugin::Core
@@ -108,6 +200,219 @@ namespace Gek
                 renderer->onShowUserInterface.disconnect(this, &Editor::onShowUserInterface);
                 population->onAction.disconnect(this, &Editor::onAction);
                 population->onUpdate[90].disconnect(this, &Editor::onUpdate);
+                population->onReset.disconnect(this, &Editor::onReset);
+                population->onEntityCreated.disconnect(this, &Editor::onEntityCreated);
+                population->onEntityDestroyed.disconnect(this, &Editor::onEntityDestroyed);
+                population->onComponentAdded.disconnect(this, &Editor::onComponentAdded);
+                population->onComponentRemoved.disconnect(this, &Editor::onComponentRemoved);
+                onModified.disconnect(this, &Editor::onEntityModified);
+            }
+
+            // Outliner
+            OutlinerRow makeOutlinerRow(Plugin::Entity *entity, uint64_t serial) const
+            {
+                OutlinerRow row;
+                row.entity = entity;
+                row.serial = serial;
+                if (entity->hasComponent<Components::Name>())
+                {
+                    row.name = entity->getComponent<Components::Name>().name;
+                }
+
+                row.named = !row.name.empty();
+                if (!row.named)
+                {
+                    row.name = String::Format("entity_%v", serial);
+                }
+
+                row.searchName = String::GetLower(row.name);
+                for (size_t componentIndex = 0; componentIndex < outlinerComponentList.size(); ++componentIndex)
+                {
+                    if (entity->hasComponent(outlinerComponentList[componentIndex]))
+                    {
+                        row.componentMask |= (1ULL << componentIndex);
+                    }
+                }
+
+                return row;
+            }
+
+            void queueOutlinerEvent(OutlinerEvent event, Plugin::Entity *entity)
+            {
+                std::unique_lock<std::mutex> lock(outlinerEventMutex);
+                if (outlinerTracking)
+                {
+                    outlinerEventList.push_back(std::make_pair(event, entity));
+                }
+            }
+
+            void stopOutliner(void)
+            {
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(outlinerEventMutex);
+                    if (!outlinerTracking)
+                    {
+                        return;
+                    }
+
+                    outlinerTracking = false;
+                    outlinerResetPending = false;
+                    outlinerEventList.clear();
+                }
+
+                outlinerRowList.clear();
+                outlinerSerialMap.clear();
+                filteredRowList.clear();
+                outlinerFilterChanged = true;
+            }
+
+            void updateOutliner(void)
+            {
+                GEK_PROFILE_ZONE("Outliner Update");
+                Memory::Scope memoryScope(Memory::Tag::Editor);
+
+                // Component types in name order, which is also the order of the bits in the component masks
+                if (outlinerComponentList.empty())
+                {
+                    std::vector<std::pair<std::string, std::type_index>> componentList;
+                    for (auto const &componentSearch : population->getComponentMap())
+                    {
+                        componentList.push_back(std::make_pair(componentSearch.second->getName(), componentSearch.first));
+                    }
+
+                    std::sort(std::begin(componentList), std::end(componentList), [](auto const &left, auto const &right) -> bool
+                    {
+                        return (left.first < right.first);
+                    });
+
+                    componentList.resize(std::min(componentList.size(), size_t(64)));
+                    for (auto const &component : componentList)
+                    {
+                        outlinerComponentNameList.push_back(component.first);
+                        outlinerComponentList.push_back(component.second);
+                    }
+                }
+
+                bool rebuild = false;
+                std::vector<std::pair<OutlinerEvent, Plugin::Entity *>> eventList;
+                if (true)
+                {
+                    std::unique_lock<std::mutex> lock(outlinerEventMutex);
+                    rebuild = (!outlinerTracking || outlinerResetPending);
+                    outlinerTracking = true;
+                    outlinerResetPending = false;
+                    eventList.swap(outlinerEventList);
+                }
+
+                if (rebuild)
+                {
+                    selectedEntity = nullptr;
+                    outlinerRowList.clear();
+                    outlinerSerialMap.clear();
+                    for (auto const &entity : population->getEntityList())
+                    {
+                        auto serial = nextOutlinerSerial++;
+                        outlinerSerialMap[entity.get()] = serial;
+                        outlinerRowList.push_back(makeOutlinerRow(entity.get(), serial));
+                    }
+
+                    std::sort(std::begin(outlinerRowList), std::end(outlinerRowList));
+                    outlinerFilterChanged = true;
+                    return;
+                }
+
+                if (eventList.empty())
+                {
+                    return;
+                }
+
+                // Rows are removed for every changed entity, and remade for the ones that are still alive
+                std::unordered_set<Plugin::Entity *> removeSet;
+                std::unordered_set<Plugin::Entity *> refreshSet;
+                for (auto const &event : eventList)
+                {
+                    auto entity = event.second;
+                    switch (event.first)
+                    {
+                    case OutlinerEvent::Created:
+                        outlinerSerialMap[entity] = nextOutlinerSerial++;
+                        removeSet.insert(entity);
+                        refreshSet.insert(entity);
+                        break;
+
+                    case OutlinerEvent::Destroyed:
+                        if (outlinerSerialMap.erase(entity) > 0)
+                        {
+                            removeSet.insert(entity);
+                            refreshSet.erase(entity);
+                            if (selectedEntity == entity)
+                            {
+                                selectedEntity = nullptr;
+                            }
+                        }
+
+                        break;
+
+                    case OutlinerEvent::Modified:
+                        if (outlinerSerialMap.count(entity) > 0)
+                        {
+                            removeSet.insert(entity);
+                            refreshSet.insert(entity);
+                        }
+
+                        break;
+                    };
+                }
+
+                outlinerRowList.erase(std::remove_if(std::begin(outlinerRowList), std::end(outlinerRowList), [&removeSet](OutlinerRow const &row) -> bool
+                {
+                    return (removeSet.count(row.entity) > 0);
+                }), std::end(outlinerRowList));
+
+                OutlinerRowList insertRowList;
+                insertRowList.reserve(refreshSet.size());
+                for (auto entity : refreshSet)
+                {
+                    insertRowList.push_back(makeOutlinerRow(entity, outlinerSerialMap[entity]));
+                }
+
+                std::sort(std::begin(insertRowList), std::end(insertRowList));
+                auto previousRowCount = outlinerRowList.size();
+                outlinerRowList.insert(std::end(outlinerRowList), std::make_move_iterator(std::begin(insertRowList)), std::make_move_iterator(std::end(insertRowList)));
+                std::inplace_merge(std::begin(outlinerRowList), (std::begin(outlinerRowList) + previousRowCount), std::end(outlinerRowList));
+                outlinerFilterChanged = true;
+            }
+
+            // Takes a finished filter's rows, and starts filtering again if the index or filter changed since it began
+            void updateOutlinerFilter(void)
+            {
+                if (filteredRowResult.valid() && filteredRowResult.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+                {
+                    filteredRowList = filteredRowResult.get();
+                }
+
+                if (outlinerFilterChanged && outlinerFilter.isActive() && !filteredRowResult.valid())
+                {
+                    outlinerFilterChanged = false;
+                    auto rowList = std::make_shared<OutlinerRowList const>(outlinerRowList);
+                    filteredRowResult = outlinerFilterPool.enqueue([rowList, filter = outlinerFilter](void) -> OutlinerRowList
+                    {
+                        GEK_PROFILE_ZONE("Outliner Filter");
+                        Memory::Scope memoryScope(Memory::Tag::Editor);
+
+                        OutlinerRowList filteredRowList;
+                        for (auto const &row : *rowList)
+                        {
+                            if (filter.matches(row))
+                            {
+                                filteredRowList.push_back(row);
+                            }
+                        }
+
+                        return filteredRowList;
+                    });
+                }
             }
 
             // Renderer
@@ -154,6 +459,14 @@ namespace Gek
                             {
                                 auto &transformComponent = selectedEntity->getComponent<Components::Transform>();
                                 auto matrix = transformComponent.getScaledMatrix();
+
+                                // The gizmo works in world space, attached entities are moved back into their parent's space afterwards
+                                auto parentMatrix(Math::Float4x4::Identity);
+                                if (!transformComponent.parent.empty())
+                                {
+                                    parentMatrix = ((Math::Float4x4::MakeScaling(transformComponent.scale) * Math::Float4x4::MakeQuaternionRotation(transformComponent.rotation, transformComponent.position)).getInverse() * matrix);
+                                }
+
                                 float *snapData = nullptr;
                                 if (useGizmoSnap)
                                 {
@@ -198,26 +511,28 @@ namespace Gek
                                     gizmo->manipulate(currentGizmoOperation, currentGizmoAlignment, matrix, snapData, &boundingBox, currentGizmoAxis);
                                     if (gizmo->isUsing())
                                     {
+                                        auto localMatrix(matrix * parentMatrix.getInverse());
                                         switch (currentGizmoOperation)
                                         {
                                         case UI::Gizmo::Operation::Translate:
-                                            transformComponent.position = matrix.translation.xyz;
+                                            transformComponent.position = localMatrix.translation.xyz;
                                             break;
 
                                         case UI::Gizmo::Operation::Rotate:
-                                            transformComponent.rotation = matrix.getRotation();
+                                            transformComponent.rotation = localMatrix.getRotation();
                                             break;
 
                                         case UI::Gizmo::Operation::Scale:
-                                            transformComponent.scale = matrix.getScaling();
+                                            transformComponent.scale = localMatrix.getScaling();
                                             break;
 
                                         case UI::Gizmo::Operation::Bounds:
-                                            transformComponent.position = matrix.translation.xyz;
-                                            transformComponent.scale = matrix.getScaling();
+                                            transformComponent.position = localMatrix.translation.xyz;
+                                            transformComponent.scale = localMatrix.getScaling();
                                             break;
                                         };
 
+                                        transformComponent.setDirty();
                                         onModified(selectedEntity, typeid(Components::Transform));
                                     }
                                 }
@@ -294,8 +609,6 @@ namespace Gek
                     ImGui::PopItemWidth();
 
                     std::set<Plugin::Entity *> deleteEntitySet;
-                    auto &entityList = population->getEntityList();
-                    auto entityCount = entityList.size();
 
                     ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.5f, 0.0f, 1.0f));
                     ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.75f, 0.0f, 1.0f));
@@ -357,182 +670,246 @@ namespace Gek
 
                     ImGui::PopStyleVar();
                     ImGui::SameLine();
-                    UI::TextFrame(String::Format("Population: %v", entityCount).c_str(), ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
-                    if (ImGui::BeginChildFrame(665, ImVec2(-1.0f, -1.0f)))
+                    bool filtering = outlinerFilter.isActive();
+                    auto const &rowList = (filtering ? filteredRowList : outlinerRowList);
+                    if (filtering)
                     {
-                        ImGuiListClipper clipper(entityCount);
-                        while (clipper.Step())
+                        UI::TextFrame(String::Format("Population: %v of %v", rowList.size(), outlinerRowList.size()).c_str(), ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
+                    }
+                    else
+                    {
+                        UI::TextFrame(String::Format("Population: %v", outlinerRowList.size()).c_str(), ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
+                    }
+
+                    if (UI::CheckButton(ICON_FA_FILTER, (outlinerFilter.componentMask != 0)))
+                    {
+                        ImGui::OpenPopup("OutlinerComponents");
+                    }
+
+                    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+                    if (ImGui::BeginPopup("OutlinerComponents"))
+                    {
+                        UI::TextFrame("Required Components", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
+                        ImGui::Spacing();
+                        for (size_t componentIndex = 0; componentIndex < outlinerComponentNameList.size(); ++componentIndex)
                         {
-                            for (auto entityIndex = clipper.DisplayStart; entityIndex < clipper.DisplayEnd; ++entityIndex)
+                            auto componentBit = (1ULL << componentIndex);
+                            if (ImGui::Selectable(outlinerComponentNameList[componentIndex].c_str(), (outlinerFilter.componentMask & componentBit) != 0, ImGuiSelectableFlags_DontClosePopups))
                             {
-                                auto entitySearch = std::begin(entityList);
-                                std::advance(entitySearch, entityIndex);
-                                auto entity = entitySearch->get();
+                                outlinerFilter.componentMask ^= componentBit;
+                                outlinerFilterChanged = true;
+                            }
+                        }
 
-                                std::string name;
-                                if (entity->hasComponent<Components::Name>())
-                                {
-                                    name = entity->getComponent<Components::Name>().name;
-                                }
-                                else
-                                {
-                                    name = String::Format("entity_%v", entityIndex);
-                                }
+                        ImGui::EndPopup();
+                    }
 
-                                ImGui::PushID(entityIndex);
-                                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
-                                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.75f, 0.0f, 0.0f, 1.0f));
-                                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
-                                if (ImGui::Button(ICON_FA_USER_TIMES))
-                                {
-                                    ImGui::OpenPopup("ConfirmEntityDelete");
-                                }
+                    ImGui::PopStyleVar();
+                    ImGui::SameLine();
+                    ImGui::PushItemWidth(-1.0f);
+                    if (UI::InputString("##outlinerFilter", outlinerFilterText))
+                    {
+                        outlinerFilter.text = String::GetLower(outlinerFilterText);
+                        outlinerFilterChanged = true;
+                    }
 
-                                ImGui::PopStyleColor(3);
-                                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
-                                if (ImGui::BeginPopup("ConfirmEntityDelete"))
-                                {
-                                    ImGui::Text("Are you sure you want to remove this entitiy?");
-                                    ImGui::Spacing();
-                                    if (ImGui::Button("Yes", ImVec2(50.0f, 25.0f)))
-                                    {
-                                        deleteEntitySet.insert(entity);
-                                        ImGui::CloseCurrentPopup();
-                                    }
+                    ImGui::PopItemWidth();
+                    updateOutlinerFilter();
+                    if (ImGui::BeginChildFrame(665, ImVec2(-1.0f, -1.0f)))
+                    {
+                        auto showRow = [&](OutlinerRow const &row) -> void
+                        {
+                            // Filtered rows can outlive their entity until the next filter finishes
+                            auto serialSearch = outlinerSerialMap.find(row.entity);
+                            if (serialSearch == std::end(outlinerSerialMap) || serialSearch->second != row.serial)
+                            {
+                                ImGui::TextDisabled("%s", row.name.c_str());
+                                return;
+                            }
 
-                                    ImGui::SameLine();
-                                    if (ImGui::Button("No", ImVec2(50.0f, 25.0f)))
-                                    {
-                                        ImGui::CloseCurrentPopup();
-                                    }
+                            auto entity = row.entity;
+                            auto const &name = row.name;
+                            ImGui::PushID(static_cast<int>(row.serial));
+                            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
+                            ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.75f, 0.0f, 0.0f, 1.0f));
+                            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
+                            if (ImGui::Button(ICON_FA_USER_TIMES))
+                            {
+                                ImGui::OpenPopup("ConfirmEntityDelete");
+                            }
 
-                                    ImGui::EndPopup();
+                            ImGui::PopStyleColor(3);
+                            ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+                            if (ImGui::BeginPopup("ConfirmEntityDelete"))
+                            {
+                                ImGui::Text("Are you sure you want to remove this entitiy?");
+                                ImGui::Spacing();
+                                if (ImGui::Button("Yes", ImVec2(50.0f, 25.0f)))
+                                {
+                                    deleteEntitySet.insert(entity);
+                                    ImGui::CloseCurrentPopup();
                                 }
 
-                                ImGui::PopStyleVar();
                                 ImGui::SameLine();
-                                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.5f, 0.0f, 1.0f));
-                                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.75f, 0.0f, 1.0f));
-                                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 1.0f, 0.0f, 1.0f));
-                                if (ImGui::Button(ICON_FA_PLUS_CIRCLE))
+                                if (ImGui::Button("No", ImVec2(50.0f, 25.0f)))
                                 {
-                                    selectedComponent = 0;
-                                    ImGui::OpenPopup("AddComponent");
+                                    ImGui::CloseCurrentPopup();
                                 }
 
-                                ImGui::PopStyleColor(3);
-                                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
-                                if (ImGui::BeginPopup("AddComponent"))
+                                ImGui::EndPopup();
+                            }
+
+                            ImGui::PopStyleVar();
+                            ImGui::SameLine();
+                            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.0f, 0.5f, 0.0f, 1.0f));
+                            ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.0f, 0.75f, 0.0f, 1.0f));
+                            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(0.0f, 1.0f, 0.0f, 1.0f));
+                            if (ImGui::Button(ICON_FA_PLUS_CIRCLE))
+                            {
+                                selectedComponent = 0;
+                                ImGui::OpenPopup("AddComponent");
+                            }
+
+                            ImGui::PopStyleColor(3);
+                            ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+                            if (ImGui::BeginPopup("AddComponent"))
+                            {
+                                UI::TextFrame("Select Component Type", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
+                                ImGui::Spacing();
+                                ImGui::Spacing();
+                                ImGui::Spacing();
+
+                                auto componentCount = outlinerComponentNameList.size();
+                                if (ImGui::ListBoxHeader("##Components", componentCount, 10))
                                 {
-                                    UI::TextFrame("Select Component Type", ImVec2(ImGui::GetWindowContentRegionWidth(), 0.0f));
-                                    ImGui::Spacing();
-                                    ImGui::Spacing();
-                                    ImGui::Spacing();
-
-                                    auto const &componentMap = population->getComponentMap();
-                                    auto componentCount = componentMap.size();
-                                    if (ImGui::ListBoxHeader("##Components", componentCount, 10))
+                                    ImGuiListClipper clipper(componentCount, ImGui::GetTextLineHeightWithSpacing());
+                                    while (clipper.Step())
                                     {
-                                        ImGuiListClipper clipper(componentCount, ImGui::GetTextLineHeightWithSpacing());
-                                        while (clipper.Step())
+                                        for (auto componentIndex = clipper.DisplayStart; componentIndex < clipper.DisplayEnd; ++componentIndex)
                                         {
-                                            for (auto componentIndex = clipper.DisplayStart; componentIndex < clipper.DisplayEnd; ++componentIndex)
+                                            auto const &componentName = outlinerComponentNameList[componentIndex];
+                                            if (ImGui::Selectable(componentName.c_str(), (selectedComponent == componentIndex)))
                                             {
-                                                auto componentSearch = std::begin(componentMap);
-                                                std::advance(componentSearch, componentIndex);
-                                                if (ImGui::Selectable((componentSearch->first.name() + 7), (selectedComponent == componentIndex)))
-                                                {
-                                                    auto componentData = std::make_pair(componentSearch->second->getName(), JSON::EmptyObject);
-                                                    population->addComponent(entity, componentData);
-                                                    ImGui::CloseCurrentPopup();
-                                                }
+                                                auto componentData = std::make_pair(componentName, JSON::EmptyObject);
+                                                population->addComponent(entity, componentData);
+                                                ImGui::CloseCurrentPopup();
                                             }
-                                        };
-
-                                        ImGui::ListBoxFooter();
-                                    }
+                                        }
+                                    };
 
-                                    ImGui::EndPopup();
+                                    ImGui::ListBoxFooter();
                                 }
 
-                                ImGui::PopStyleVar();
-                                ImGui::PopID();
-                                ImGui::SameLine();
-                                ImGui::SetNextTreeNodeOpen(selectedEntity == entity);
-                                if (ImGui::TreeNodeEx(name.c_str(), ImGuiTreeNodeFlags_Framed))
+                                ImGui::EndPopup();
+                            }
+
+                            ImGui::PopStyleVar();
+                            ImGui::PopID();
+                            ImGui::SameLine();
+                            ImGui::SetNextTreeNodeOpen(selectedEntity == entity);
+                            if (ImGui::TreeNodeEx(name.c_str(), ImGuiTreeNodeFlags_Framed))
+                            {
+                                selectedEntity = entity;
+                                auto editorEntity = dynamic_cast<Edit::Entity *>(entity);
+                                if (editorEntity)
                                 {
-                                    selectedEntity = entity;
-                                    auto editorEntity = dynamic_cast<Edit::Entity *>(entity);
-                                    if (editorEntity)
+                                    std::set<std::type_index> deleteComponentSet;
+                                    auto const &entityComponentMap = editorEntity->getComponentMap();
+                                    for (auto &componentSearch : entityComponentMap)
                                     {
-                                        std::set<std::type_index> deleteComponentSet;
-                                        auto const &entityComponentMap = editorEntity->getComponentMap();
-                                        for (auto &componentSearch : entityComponentMap)
+                                        Edit::Component *component = population->getComponent(componentSearch.first);
+                                        Plugin::Component::Data *componentData = componentSearch.second.get();
+                                        if (component && componentData)
                                         {
-                                            Edit::Component *component = population->getComponent(componentSearch.first);
-                                            Plugin::Component::Data *componentData = componentSearch.second.get();
-                                            if (component && componentData)
+                                            ImGui::PushID(component->getIdentifier().hash_code());
+                                            ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
+                                            ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.75f, 0.0f, 0.0f, 1.0f));
+                                            ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
+                                            if (ImGui::Button(ICON_FA_MINUS_CIRCLE))
                                             {
-                                                ImGui::PushID(component->getIdentifier().hash_code());
-                                                ImGui::PushStyleColor(ImGuiCol_Button, ImVec4(0.5f, 0.0f, 0.0f, 1.0f));
-                                                ImGui::PushStyleColor(ImGuiCol_ButtonActive, ImVec4(0.75f, 0.0f, 0.0f, 1.0f));
-                                                ImGui::PushStyleColor(ImGuiCol_ButtonHovered, ImVec4(1.0f, 0.0f, 0.0f, 1.0f));
-                                                if (ImGui::Button(ICON_FA_MINUS_CIRCLE))
-                                                {
-                                                    ImGui::OpenPopup("ConfirmComponentDelete");
-                                                }
+                                                ImGui::OpenPopup("ConfirmComponentDelete");
+                                            }
 
-                                                ImGui::PopStyleColor(3);
-                                                ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
-                                                if (ImGui::BeginPopup("ConfirmComponentDelete"))
+                                            ImGui::PopStyleColor(3);
+                                            ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(10.0f, 10.0f));
+                                            if (ImGui::BeginPopup("ConfirmComponentDelete"))
+                                            {
+                                                ImGui::Text("Are you sure you want to remove this component?");
+                                                ImGui::Spacing();
+                                                if (ImGui::Button("Yes", ImVec2(50.0f, 25.0f)))
                                                 {
-                                                    ImGui::Text("Are you sure you want to remove this component?");
-                                                    ImGui::Spacing();
-                                                    if (ImGui::Button("Yes", ImVec2(50.0f, 25.0f)))
-                                                    {
-                                                        ImGui::CloseCurrentPopup();
-                                                        deleteComponentSet.insert(component->getIdentifier());
-                                                    }
-
-                                                    ImGui::SameLine();
-                                                    if (ImGui::Button("No", ImVec2(50.0f, 25.0f)))
-                                                    {
-                                                        ImGui::CloseCurrentPopup();
-                                                    }
-
-                                                    ImGui::EndPopup();
+                                                    ImGui::CloseCurrentPopup();
+                                                    deleteComponentSet.insert(component->getIdentifier());
                                                 }
 
-                                                ImGui::PopStyleVar();
-                                                ImGui::PopID();
                                                 ImGui::SameLine();
-                                                if (ImGui::TreeNodeEx(component->getName().c_str(), ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_DefaultOpen))
+                                                if (ImGui::Button("No", ImVec2(50.0f, 25.0f)))
                                                 {
-                                                    if (component->onUserInterface(ImGui::GetCurrentContext(), entity, componentData))
-                                                    {
-                                                        onModified(entity, componentSearch.first);
-                                                    }
-
-                                                    ImGui::TreePop();
+                                                    ImGui::CloseCurrentPopup();
                                                 }
+
+                                                ImGui::EndPopup();
                                             }
-                                        }
 
-                                        for (auto &component : deleteComponentSet)
-                                        {
-                                            population->removeComponent(entity, component);
+                                            ImGui::PopStyleVar();
+                                            ImGui::PopID();
+                                            ImGui::SameLine();
+                                            if (ImGui::TreeNodeEx(component->getName().c_str(), ImGuiTreeNodeFlags_Framed | ImGuiTreeNodeFlags_DefaultOpen))
+                                            {
+                                                if (component->onUserInterface(ImGui::GetCurrentContext(), entity, componentData))
+                                                {
+                                                    onModified(entity, componentSearch.first);
+                                                }
+
+                                                ImGui::TreePop();
+                                            }
                                         }
                                     }
 
-                                    ImGui::TreePop();
+                                    for (auto &component : deleteComponentSet)
+                                    {
+                                        population->removeComponent(entity, component);
+                                    }
                                 }
-                                else if (selectedEntity == entity)
+
+                                ImGui::TreePop();
+                            }
+                            else if (selectedEntity == entity)
+                            {
+                                selectedEntity = nullptr;
+                            }
+                        };
+
+                        auto showRowRange = [&](size_t firstRowIndex, size_t lastRowIndex) -> void
+                        {
+                            ImGuiListClipper clipper(static_cast<int>(lastRowIndex - firstRowIndex), ImGui::GetItemsLineHeightWithSpacing());
+                            while (clipper.Step())
+                            {
+                                for (auto rowIndex = clipper.DisplayStart; rowIndex < clipper.DisplayEnd; ++rowIndex)
                                 {
-                                    selectedEntity = nullptr;
+                                    showRow(rowList[firstRowIndex + rowIndex]);
                                 }
-                            }
+                            };
                         };
 
+                        // The selected entity's row is open to show its components, so the rows on either side of it are clipped separately
+                        auto selectedRowIndex = rowList.size();
+                        auto selectedSearch = (selectedEntity ? outlinerSerialMap.find(selectedEntity) : std::end(outlinerSerialMap));
+                        if (selectedSearch != std::end(outlinerSerialMap))
+                        {
+                            auto rowSearch = std::lower_bound(std::begin(rowList), std::end(rowList), makeOutlinerRow(selectedEntity, selectedSearch->second));
+                            if (rowSearch != std::end(rowList) && rowSearch->entity == selectedEntity)
+                            {
+                                selectedRowIndex = std::distance(std::begin(rowList), rowSearch);
+                            }
+                        }
+
+                        showRowRange(0, selectedRowIndex);
+                        if (selectedRowIndex < rowList.size())
+                        {
+                            showRow(rowList[selectedRowIndex]);
+                            showRowRange((selectedRowIndex + 1), rowList.size());
+                        }
                     }
 
                     ImGui::EndChildFrame();
@@ -578,9 +955,12 @@ namespace Gek
                 bool editorActive = core->getOption("editor", "active").convert(false);
                 if (!editorActive)
                 {
+                    stopOutliner();
                     return;
                 }
 
+                updateOutliner();
+
                 auto editorSize = imGuiIo.DisplaySize;
                 auto editorPosition = ImVec2(0.0f, 0.0f);
                 if (mainMenuShowing)
@@ -611,7 +991,43 @@ namespace Gek
                 ImGui::PopStyleVar(3);
             }
 
+            // Plugin::Editor Slots
+            void onEntityModified(Plugin::Entity * const entity, std::type_index const &type)
+            {
+                if (type == typeid(Components::Name))
+                {
+                    queueOutlinerEvent(OutlinerEvent::Modified, entity);
+                }
+            }
+
             // Plugin::Population Slots
+            void onReset(void)
+            {
+                std::unique_lock<std::mutex> lock(outlinerEventMutex);
+                outlinerResetPending = true;
+                outlinerEventList.clear();
+            }
+
+            void onEntityCreated(Plugin::Entity * const entity)
+            {
+                queueOutlinerEvent(OutlinerEvent::Created, entity);
+            }
+
+            void onEntityDestroyed(Plugin::Entity * const entity)
+            {
+                queueOutlinerEvent(OutlinerEvent::Destroyed, entity);
+            }
+
+            void onComponentAdded(Plugin::Entity * const entity)
+            {
+                queueOutlinerEvent(OutlinerEvent::Modified, entity);
+            }
+
+            void onComponentRemoved(Plugin::Entity * const entity)
+            {
+                queueOutlinerEvent(OutlinerEvent::Modified, entity);
+            }
+
             void onAction(Plugin::Population::Action const &action)
             {
                 bool editorActive = core->getOption("editor", "active").convert(false);
@@ -620,28 +1036,29 @@ namespace Gek
                     return;
                 }
 
-                if (action.name == "turn")
+                auto const &actionNames = Plugin::Population::Action::GetNames();
+                if (action.name == actionNames.turn)
                 {
                     headingAngle += (action.value * 0.01f);
                 }
-                else if (action.name == "tilt")
+                else if (action.name == actionNames.tilt)
                 {
                     lookingAngle += (action.value * 0.01f);
                     lookingAngle = Math::Clamp(lookingAngle, -Math::Pi * 0.5f, Math::Pi * 0.5f);
                 }
-                else if (action.name == "move_forward")
+                else if (action.name == actionNames.moveForward)
                 {
                     moveForward = action.state;
                 }
-                else if (action.name == "move_backward")
+                else if (action.name == actionNames.moveBackward)
                 {
                     moveBackward = action.state;
                 }
-                else if (action.name == "strafe_left")
+                else if (action.name == actionNames.strafeLeft)
                 {
                     strafeLeft = action.state;
                 }
-                else if (action.name == "strafe_right")
+                else if (action.name == actionNames.strafeRight)
                 {
                     strafeRight = action.state;
                 }
@@ -649,6 +1066,9 @@ namespace Gek
 
             void onUpdate(float frameTime)
             {
+                GEK_PROFILE_ZONE("Editor Update");
+                Memory::Scope memoryScope(Memory::Tag::Editor);
+
                 bool editorActive = core->getOption("editor", "active").convert(false);
                 if (editorActive)
                 {
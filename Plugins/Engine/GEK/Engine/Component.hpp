@@ -10,6 +10,7 @@
 #include "GEK/Math/Matrix4x4.hpp"
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONView.hpp"
 #include "GEK/GUI/Utilities.hpp"
 #include <typeindex>
 
@@ -37,7 +38,7 @@ namespace Gek
 
             virtual std::unique_ptr<Data> create(void) = 0;
             virtual void save(Data const * const data, JSON::Object &componentData) const = 0;
-            virtual void load(Data * const data, JSON::Reference componentData) = 0;
+            virtual void load(Data * const data, JSON::View componentData) = 0;
         };
     }; // namespace Plugin
 
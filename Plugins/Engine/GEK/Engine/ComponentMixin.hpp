@@ -10,6 +10,8 @@
 #include "GEK/Engine/Component.hpp"
 #include "GEK/Engine/Population.hpp"
 #include <concurrent_unordered_map.h>
+#include <ppl.h>
+#include <vector>
 #include <new>
 
 namespace Gek
@@ -59,20 +61,20 @@ namespace Gek
             }
 
             template <typename TYPE>
-            TYPE parse(JSON::Reference object, TYPE defaultValue)
+            TYPE parse(JSON::View object, TYPE defaultValue)
             {
                 return object.parse(population->getShuntingYard(), defaultValue);
             }
 
             virtual void save(COMPONENT const * const component, JSON::Object &componentData) const { };
-            virtual void load(COMPONENT * const component, JSON::Reference componentData) { };
+            virtual void load(COMPONENT * const component, JSON::View componentData) { };
 
             void save(Plugin::Component::Data const * const component, JSON::Object &componentData) const
             {
                 save(static_cast<COMPONENT const * const>(component), componentData);
             }
 
-            void load(Plugin::Component::Data * const component, JSON::Reference componentData)
+            void load(Plugin::Component::Data * const component, JSON::View componentData)
             {
                 load(static_cast<COMPONENT * const>(component), componentData);
             }
@@ -95,12 +97,38 @@ namespace Gek
         private:
             struct Data : public CLASS::Data
             {
+                // Position of the entity in entityOrderList
+                size_t orderIndex = 0;
             };
 
         protected:
             using EntityDataMap = concurrency::concurrent_unordered_map<Plugin::Entity *, Data>;
             EntityDataMap entityDataMap;
 
+        private:
+            // Entities are listed in the order they were added, instead of the map's order, which depends on
+            // pointer values and changes every run, so deterministic populations process entities the same way each time
+            //  - the map never moves its elements, so the list points straight at them
+            //  - removed entities leave an empty slot behind, until enough have been removed to be worth compacting
+            std::vector<typename EntityDataMap::value_type *> entityOrderList;
+            size_t removedOrderCount = 0;
+
+            void compactOrder(void)
+            {
+                size_t orderIndex = 0;
+                for (auto entityData : entityOrderList)
+                {
+                    if (entityData)
+                    {
+                        entityData->second.orderIndex = orderIndex;
+                        entityOrderList[orderIndex++] = entityData;
+                    }
+                }
+
+                entityOrderList.resize(orderIndex);
+                removedOrderCount = 0;
+            }
+
         public:
             virtual ~ProcessorMixin(void) = default;
 
@@ -108,6 +136,8 @@ namespace Gek
             void clear(void)
             {
                 entityDataMap.clear();
+                entityOrderList.clear();
+                removedOrderCount = 0;
             }
 
             void addEntity(Plugin::Entity * const entity, std::function<void(bool isNewInsert, Data &data, REQUIRED&... components)> onAdded = nullptr)
@@ -117,6 +147,12 @@ namespace Gek
                 if (entity->hasComponents<REQUIRED...>())
                 {
                     auto insertSearch = entityDataMap.insert(std::make_pair(entity, Data()));
+                    if (insertSearch.second)
+                    {
+                        insertSearch.first->second.orderIndex = entityOrderList.size();
+                        entityOrderList.push_back(&(*insertSearch.first));
+                    }
+
                     if (onAdded)
                     {
                         onAdded(insertSearch.second, insertSearch.first->second, entity->getComponent<REQUIRED>()...);
@@ -131,7 +167,12 @@ namespace Gek
                 auto entitySearch = entityDataMap.find(entity);
                 if (entitySearch != std::end(entityDataMap))
                 {
+                    entityOrderList[entitySearch->second.orderIndex] = nullptr;
                     entityDataMap.unsafe_erase(entitySearch);
+                    if (++removedOrderCount > (entityOrderList.size() / 2))
+                    {
+                        compactOrder();
+                    }
                 }
             }
 
@@ -144,19 +185,26 @@ namespace Gek
             {
                 assert(onEntity);
 
-                std::for_each(std::begin(entityDataMap), std::end(entityDataMap), [&](auto &entitySearch) -> void
+                for (auto entityData : entityOrderList)
                 {
-                    onEntity(entitySearch.first, entitySearch.second, entitySearch.first->getComponent<REQUIRED>()...);
-                });
+                    if (entityData)
+                    {
+                        onEntity(entityData->first, entityData->second, entityData->first->getComponent<REQUIRED>()...);
+                    }
+                }
             }
 
             void parallelListEntities(std::function<void(Plugin::Entity * const entity, Data &data, REQUIRED&... components)> &&onEntity)
             {
                 assert(onEntity);
 
-                concurrency::parallel_for_each(std::begin(entityDataMap), std::end(entityDataMap), [&](auto &entitySearch) -> void
+                concurrency::parallel_for(size_t(0), entityOrderList.size(), [&](size_t orderIndex) -> void
                 {
-                    onEntity(entitySearch.first, entitySearch.second, entitySearch.first->getComponent<REQUIRED>()...);
+                    auto entityData = entityOrderList[orderIndex];
+                    if (entityData)
+                    {
+                        onEntity(entityData->first, entityData->second, entityData->first->getComponent<REQUIRED>()...);
+                    }
                 });
             }
         };
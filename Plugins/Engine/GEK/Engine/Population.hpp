@@ -8,6 +8,7 @@
 #pragma once
 
 #include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Identifier.hpp"
 #include "GEK/Utility/Context.hpp"
 #include "GEK/Utility/ShuntingYard.hpp"
 #include "GEK/Engine/Processor.hpp"
@@ -29,7 +30,27 @@ namespace Gek
         {
             struct Action
             {
-                std::string name;
+                // Built in action names, interned the first time they're used so handlers only compare indices,
+                // which is always after the plugin has been handed the shared identifier table
+                struct Names
+                {
+                    Identifier const turn = Identifier("turn"_id);
+                    Identifier const tilt = Identifier("tilt"_id);
+                    Identifier const moveForward = Identifier("move_forward"_id);
+                    Identifier const moveBackward = Identifier("move_backward"_id);
+                    Identifier const strafeLeft = Identifier("strafe_left"_id);
+                    Identifier const strafeRight = Identifier("strafe_right"_id);
+                    Identifier const jump = Identifier("jump"_id);
+                    Identifier const crouch = Identifier("crouch"_id);
+                };
+
+                static Names const &GetNames(void)
+                {
+                    static Names const names;
+                    return names;
+                }
+
+                Identifier name;
                 union
                 {
                     bool state;
@@ -40,6 +61,18 @@ namespace Gek
                 {
                 }
 
+                Action(Identifier name, bool state)
+                    : name(name)
+                    , state(state)
+                {
+                }
+
+                Action(Identifier name, float value)
+                    : name(name)
+                    , value(value)
+                {
+                }
+
                 Action(std::string const &name, bool state)
                     : name(String::GetLower(name))
                     , state(state)
@@ -68,6 +101,30 @@ namespace Gek
 
             virtual ShuntingYard &getShuntingYard(void) = 0;
 
+            // Deterministic mode is enabled by the population.deterministic option, or by recording and replaying
+            //  - every update advances by the fixed population.frameTime instead of the measured frame time
+            //  - updates are held back while a population is loading, so the first update always sees the whole scene
+            //  - entities are visited in creation order instead of in parallel
+            virtual bool isDeterministic(void) const = 0;
+
+            // True from a call to load until all of the loaded entities have been added
+            virtual bool isLoading(void) const = 0;
+
+            // Seed for a subsystem's own random stream, derived from the scene seed and the subsystem name,
+            // so adding random calls to one subsystem doesn't change the sequence another one sees
+            virtual uint32_t getRandomSeed(Identifier subsystem) const = 0;
+
+            // Hash of every entity's saved component data, in creation order
+            virtual uint64_t getStateHash(void) const = 0;
+
+            // Reloads the current population and records the actions and state hash of every update that follows
+            virtual void startRecording(FileSystem::Path const &filePath) = 0;
+            virtual void stopRecording(void) = 0;
+
+            // Reloads the recorded population and feeds the recorded actions back in, reporting the first
+            // update whose state hash doesn't match the recording
+            virtual bool startReplay(FileSystem::Path const &filePath) = 0;
+
             virtual void reset(void) = 0;
             virtual void load(std::string const &populationName) = 0;
             virtual void save(std::string const &populationName) = 0;
@@ -31,12 +31,28 @@ namespace Gek
                 };
             }; // namespace Flags
 
+            // Higher priorities are loaded first, values in between can be used to order by distance
+            struct Priority
+            {
+                enum
+                {
+                    Background = 0,
+                    Normal = 100,
+                    Visible = 200,
+                    Immediate = 300,
+                };
+            }; // namespace Priority
+
             virtual ~Resources(void) = default;
 
-            virtual VisualHandle loadVisual(std::string const &pluginName) = 0;
-            virtual MaterialHandle loadMaterial(std::string const &materialName) = 0;
+            virtual VisualHandle loadVisual(std::string const &pluginName, float priority = Priority::Normal) = 0;
+            virtual MaterialHandle loadMaterial(std::string const &materialName, float priority = Priority::Normal) = 0;
+
+            virtual ResourceHandle loadTexture(std::string const &textureName, uint32_t flags, float priority = Priority::Normal) = 0;
 
-            virtual ResourceHandle loadTexture(std::string const &textureName, uint32_t flags) = 0;
+            virtual void prioritize(VisualHandle handle, float priority) = 0;
+            virtual void prioritize(MaterialHandle handle, float priority) = 0;
+            virtual void prioritize(ResourceHandle handle, float priority) = 0;
             virtual ResourceHandle createPattern(std::string const &pattern, JSON::Reference parameters) = 0;
 
             virtual ResourceHandle createTexture(std::string const &textureName, const Video::Texture::Description &description, uint32_t flags = 0) = 0;
@@ -84,6 +100,10 @@ namespace Gek
         
             virtual void clear(void) = 0;
 
+            // Limits the number of queued loads started each frame, zero removes the limit
+            virtual void setLoadLimit(uint32_t requestsPerFrame) = 0;
+            virtual size_t getPendingLoadCount(void) = 0;
+
             virtual ShaderHandle getMaterialShader(MaterialHandle material) const = 0;
             virtual ResourceHandle getResourceHandle(std::string const &resourceName) const = 0;
 
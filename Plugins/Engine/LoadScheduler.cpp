@@ -0,0 +1,270 @@
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
+#include "LoadScheduler.hpp"
+#include <unordered_set>
+#include <algorithm>
+#include <iostream>
+
+#ifdef _WIN32
+#include <Windows.h>
+#endif
+
+namespace Gek
+{
+    // Request currently being loaded on this thread, used to record dependencies
+    static thread_local LoadScheduler const *activeScheduler = nullptr;
+    static thread_local std::size_t activeKey = 0;
+    static thread_local float activePriority = 0.0f;
+
+    void LoadScheduler::drain(void)
+    {
+        [this](void)
+        {
+            Lock lock(queueMutex);
+            entryQueue = std::priority_queue<Entry>();
+            pendingMap.clear();
+            dependencyMap.clear();
+            activeCount = runningCount;
+        } ();
+
+        if (!workerList.empty())
+        {
+            stop = true;
+            condition.notify_all();
+
+            // Wait for threads to complete work
+            for (std::thread &worker : workerList)
+            {
+                worker.join();
+            }
+
+            workerList.clear();
+        }
+    }
+
+    void LoadScheduler::create(size_t threadCount)
+    {
+        stop = false;
+        workerList.clear();
+        workerList.reserve(threadCount);
+        for (size_t count = 0; count < threadCount; ++count)
+        {
+            // Worker execution loop
+            workerList.emplace_back([this](void) -> void
+            {
+#ifdef _WIN32
+                CoInitializeEx(nullptr, COINITBASE_MULTITHREADED);
+#endif
+                Profiler::SetThreadName("Resource Loader");
+                for (;;)
+                {
+                    std::size_t key = 0;
+                    float priority = 0.0f;
+                    std::function<void(void)> load;
+
+                    // Wait for additional work signal
+                    if (true)
+                    {
+                        Lock lock(queueMutex);
+                        condition.wait(lock, [this](void) -> bool
+                        {
+                            return stop || (!entryQueue.empty() && canStart());
+                        });
+
+                        if (stop)
+                        {
+                            break;
+                        }
+
+                        // Skip entries left behind when a request was raised to a higher priority
+                        while (!entryQueue.empty() && !load)
+                        {
+                            auto entry = entryQueue.top();
+                            entryQueue.pop();
+
+                            auto pendingSearch = pendingMap.find(entry.key);
+                            if (pendingSearch != std::end(pendingMap) && pendingSearch->second.priority == entry.priority)
+                            {
+                                key = entry.key;
+                                priority = entry.priority;
+                                load = std::move(pendingSearch->second.load);
+                                pendingMap.erase(pendingSearch);
+                                ++runningCount;
+                                ++frameCount;
+                            }
+                        };
+
+                        if (!load)
+                        {
+                            continue;
+                        }
+                    }
+
+                    activeScheduler = this;
+                    activeKey = key;
+                    activePriority = priority;
+
+                    try
+                    {
+                        GEK_PROFILE_ZONE("Resource Load");
+                        Memory::Scope memoryScope(Memory::Tag::Resources);
+                        load();
+                    }
+                    catch (std::exception const &exception)
+                    {
+                        LockedWrite{ std::cerr } << String::Format("Exception raised while loading resource: %v", exception.what());
+                    }
+                    catch (...)
+                    {
+                        LockedWrite{ std::cerr } << String::Format("Unknown exception occurred while loading resource");
+                    };
+
+                    activeScheduler = nullptr;
+
+                    Lock lock(queueMutex);
+                    --activeCount;
+                    if (--runningCount == 0 && pendingMap.empty())
+                    {
+                        dependencyMap.clear();
+                    }
+                }
+
+#ifdef _WIN32
+                CoUninitialize();
+#endif
+            });
+        }
+    }
+
+    bool LoadScheduler::canStart(void) const
+    {
+        return (frameLimit == 0 || frameCount < frameLimit);
+    }
+
+    void LoadScheduler::raisePriority(std::size_t key, float priority)
+    {
+        std::unordered_set<std::size_t> visitedSet;
+        std::vector<std::size_t> raiseStack = { key };
+        while (!raiseStack.empty())
+        {
+            auto raiseKey = raiseStack.back();
+            raiseStack.pop_back();
+            if (!visitedSet.insert(raiseKey).second)
+            {
+                continue;
+            }
+
+            auto pendingSearch = pendingMap.find(raiseKey);
+            if (pendingSearch != std::end(pendingMap) && pendingSearch->second.priority < priority)
+            {
+                pendingSearch->second.priority = priority;
+                entryQueue.push({ priority, nextOrder++, raiseKey });
+            }
+
+            // Requests that already started can still be waiting on their dependencies
+            auto dependencySearch = dependencyMap.find(raiseKey);
+            if (dependencySearch != std::end(dependencyMap))
+            {
+                raiseStack.insert(std::end(raiseStack), std::begin(dependencySearch->second), std::end(dependencySearch->second));
+            }
+        };
+    }
+
+    LoadScheduler::LoadScheduler(size_t threadCount)
+    {
+        create(threadCount);
+    }
+
+    LoadScheduler::~LoadScheduler(void)
+    {
+        drain();
+    }
+
+    void LoadScheduler::reset(size_t *threadCount)
+    {
+        auto previousThreadCount = workerList.size();
+        drain();
+        create(threadCount ? *threadCount : previousThreadCount);
+    }
+
+    bool LoadScheduler::request(std::size_t key, float priority, std::function<void(void)> &&load)
+    {
+        if (true)
+        {
+            Lock lock(queueMutex);
+            if (stop)
+            {
+                return false;
+            }
+
+            if (activeScheduler == this)
+            {
+                dependencyMap[activeKey].push_back(key);
+                priority = std::max(priority, activePriority);
+            }
+
+            auto pendingSearch = pendingMap.find(key);
+            if (pendingSearch != std::end(pendingMap))
+            {
+                pendingSearch->second.load = std::move(load);
+                raisePriority(key, priority);
+                return false;
+            }
+
+            auto &request = pendingMap[key];
+            request.priority = priority;
+            request.load = std::move(load);
+            entryQueue.push({ priority, nextOrder++, key });
+            ++activeCount;
+        }
+
+        condition.notify_one();
+        return true;
+    }
+
+    void LoadScheduler::prioritize(std::size_t key, float priority)
+    {
+        // Called every frame for visible resources, skip the lock once everything has loaded
+        if (activeCount == 0)
+        {
+            return;
+        }
+
+        Lock lock(queueMutex);
+        raisePriority(key, priority);
+    }
+
+    void LoadScheduler::setFrameLimit(uint32_t requestCount)
+    {
+        if (true)
+        {
+            Lock lock(queueMutex);
+            frameLimit = requestCount;
+        }
+
+        condition.notify_all();
+    }
+
+    void LoadScheduler::beginFrame(void)
+    {
+        if (true)
+        {
+            Lock lock(queueMutex);
+            if (frameCount == 0)
+            {
+                return;
+            }
+
+            frameCount = 0;
+        }
+
+        condition.notify_all();
+    }
+
+    size_t LoadScheduler::getPendingCount(void)
+    {
+        Lock lock(queueMutex);
+        return pendingMap.size();
+    }
+}; // namespace Gek
@@ -0,0 +1,97 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <condition_variable>
+#include <unordered_map>
+#include <functional>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <mutex>
+#include <queue>
+
+namespace Gek
+{
+    // Prioritized replacement for a FIFO ThreadPool when loading resources
+    //  - requests are keyed by hash, duplicate keys are coalesced into the pending request
+    //  - requests made while another request is loading are recorded as its dependencies,
+    //    and inherit (and follow) the priority of the request that needs them
+    //  - the number of requests started per frame can be limited to spread out uploads
+    class LoadScheduler final
+    {
+        using Lock = std::unique_lock<std::mutex>;
+
+    private:
+        struct Request
+        {
+            float priority = 0.0f;
+            std::function<void(void)> load;
+        };
+
+        struct Entry
+        {
+            float priority;
+            uint64_t order;
+            std::size_t key;
+
+            bool operator < (Entry const &entry) const
+            {
+                // Highest priority first, oldest request first for equal priorities
+                return (priority == entry.priority ? order > entry.order : priority < entry.priority);
+            }
+        };
+
+    private:
+        std::vector<std::thread> workerList;
+        std::priority_queue<Entry> entryQueue;
+        std::unordered_map<std::size_t, Request> pendingMap;
+        std::unordered_map<std::size_t, std::vector<std::size_t>> dependencyMap;
+        uint64_t nextOrder = 0;
+        uint32_t runningCount = 0;
+
+        uint32_t frameLimit = 0;
+        uint32_t frameCount = 0;
+
+        std::mutex queueMutex;
+        std::condition_variable condition;
+        std::atomic<bool> stop = false;
+        std::atomic<uint32_t> activeCount = 0;
+
+    private:
+        void create(size_t threadCount);
+        void raisePriority(std::size_t key, float priority);
+        bool canStart(void) const;
+
+    public:
+        LoadScheduler(size_t threadCount = 1);
+        ~LoadScheduler(void);
+
+        LoadScheduler(LoadScheduler const &) = delete;
+        LoadScheduler(LoadScheduler &&) = delete;
+
+        LoadScheduler &operator = (LoadScheduler const &) = delete;
+        LoadScheduler &operator = (LoadScheduler &&) = delete;
+
+        void drain(void);
+        void reset(size_t *threadCount = nullptr);
+
+        // Returns false if the key was already pending, in which case the new load replaces the
+        // pending one and the request keeps the higher of the two priorities
+        bool request(std::size_t key, float priority, std::function<void(void)> &&load);
+
+        // Raises the priority of a pending request and everything it is waiting on
+        void prioritize(std::size_t key, float priority);
+
+        // Maximum number of requests started between calls to beginFrame, zero is unlimited
+        void setFrameLimit(uint32_t requestCount);
+        void beginFrame(void);
+
+        size_t getPendingCount(void);
+    };
+}; // namespace Gek
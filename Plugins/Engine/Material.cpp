@@ -1,6 +1,7 @@
 ﻿#include "GEK/Utility/String.hpp"
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONView.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/System/VideoDevice.hpp"
 #include "GEK/Engine/Shader.hpp"
@@ -30,18 +31,18 @@ namespace Gek
             {
                 assert(resources);
 
-                JSON::Instance materialNode = JSON::Load(getContext()->getRootFileName("data", "materials", materialName).withExtension(".json"));
-                auto &shaderNode = materialNode.get("shader");
+                auto document = JSON::Document::Load(getContext()->getRootFileName("data", "materials", materialName).withExtension(".json"));
+                auto shaderNode = document.getRoot().get("shader");
                 auto shaderName = shaderNode.get("default").convert(String::Empty);
                 ShaderHandle shaderHandle = resources->getShader(shaderName, materialHandle);
                 Engine::Shader *shader = resources->getShader(shaderHandle);
                 if (shader)
                 {
                     Video::RenderState::Description renderStateInformation;
-                    renderStateInformation.load(shaderNode.get("renderState"));
+                    renderStateInformation.load(shaderNode.get("renderState").getObject());
                     renderState = resources->createRenderState(renderStateInformation);
 
-                    auto &dataNode = shaderNode.get("data");
+                    auto dataNode = shaderNode.get("data");
                     for (auto material = shader->begin(); material; material = material->next())
                     {
                         auto materialName = material->getName();
@@ -49,7 +50,7 @@ namespace Gek
                         for (auto &initializer : material->getInitializerList())
                         {
                             ResourceHandle resourceHandle;
-                            auto &resourceNode = dataNode.get(initializer.name);
+                            auto resourceNode = dataNode.get(initializer.name);
                             if (resourceNode.has("file"))
                             {
                                 auto fileName = resourceNode.get("file").convert(String::Empty);
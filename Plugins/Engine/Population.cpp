@@ -1,7 +1,10 @@
 ﻿#include "GEK/Utility/String.hpp"
 #include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONView.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Population.hpp"
@@ -9,6 +12,10 @@
 #include "GEK/Engine/Entity.hpp"
 #include "GEK/Engine/Component.hpp"
 #include <concurrent_queue.h>
+#include <algorithm>
+#include <sstream>
+#include <cstring>
+#include <atomic>
 #include <ppl.h>
 #include <map>
 
@@ -83,13 +90,49 @@ namespace Gek
         GEK_CONTEXT_USER(Population, Plugin::Core *)
             , public Edit::Population
         {
+        public:
+            // A recording is the header and population name, followed by one frame per deterministic
+            // update: the action count, the state hash after the update, then the actions themselves
+            struct RecordHeader
+            {
+                uint32_t identifier = 0;
+                uint16_t version = 0;
+                uint16_t nameLength = 0;
+                uint32_t randomSeed = 0;
+                uint32_t frameCount = 0;
+                float frameTime = 0.0f;
+            };
+
+            // Followed by the action name, identifier indices are only valid for the run that issued them
+            struct RecordedAction
+            {
+                uint32_t nameLength;
+                uint32_t value;
+            };
+
+            struct RecordedFrame
+            {
+                uint64_t stateHash = 0;
+                std::vector<Action> actionList;
+            };
+
+            static constexpr uint32_t RecordIdentifier = 0x524B4547; // GEKR
+            static constexpr uint16_t RecordVersion = 2;
+
+            enum class Session : uint8_t
+            {
+                None = 0,
+                Recording,
+                Replaying,
+            };
+
         private:
             Plugin::Core *core = nullptr;
 
             ShuntingYard shuntingYard;
             concurrency::concurrent_queue<Action> actionQueue;
 
-            std::unordered_map<std::string, std::type_index> componentTypeNameMap;
+            std::unordered_map<Identifier, std::type_index> componentTypeNameMap;
             std::unordered_map<std::type_index, std::string> componentNameTypeMap;
             ComponentMap componentMap;
 
@@ -99,6 +142,21 @@ namespace Gek
 
             uint32_t uniqueEntityIdentifier = 0;
 
+            std::string currentPopulationName;
+            std::atomic<bool> loading = false;
+            bool deterministic = false;
+            float fixedFrameTime = (1.0f / 60.0f);
+            uint32_t randomSeed = 0;
+
+            Session session = Session::None;
+            FileSystem::Path sessionPath;
+            uint32_t frameIndex = 0;
+            std::vector<Action> frameActionList;
+            std::vector<uint8_t> recordBuffer;
+            std::vector<RecordedFrame> replayFrameList;
+            uint32_t replaySeed = 0;
+            bool replayMatched = true;
+
         public:
             Population(Context *context, Plugin::Core *core)
                 : ContextRegistration(context)
@@ -125,7 +183,7 @@ namespace Gek
                     }
 
                     componentNameTypeMap.insert(std::make_pair(component->getIdentifier(), component->getName()));
-                    componentTypeNameMap.insert(std::make_pair(component->getName(), component->getIdentifier()));
+                    componentTypeNameMap.insert(std::make_pair(Identifier(component->getName()), component->getIdentifier()));
                     componentMap[component->getIdentifier()] = std::move(component);
                 });
 
@@ -183,17 +241,277 @@ namespace Gek
                 return shuntingYard;
             }
 
+            bool isDeterministic(void) const
+            {
+                return deterministic;
+            }
+
+            bool isLoading(void) const
+            {
+                return (loading || !entityQueue.empty());
+            }
+
+            uint32_t getRandomSeed(Identifier subsystem) const
+            {
+                auto hash = subsystem.getHash();
+                return (randomSeed ^ (uint32_t(hash ^ (hash >> 32)) * 2654435761U));
+            }
+
+            uint64_t getStateHash(void) const
+            {
+                uint64_t hash = 14695981039346656037ULL;
+                auto addData = [&hash](std::string const &data) -> void
+                {
+                    for (auto character : data)
+                    {
+                        hash ^= uint8_t(character);
+                        hash *= 1099511628211ULL;
+                    }
+                };
+
+                // Components are stored by type, sort them by name so the order is the same every run
+                std::vector<std::pair<std::string const *, std::string>> componentDataList;
+                for (auto const &entity : entityList)
+                {
+                    componentDataList.clear();
+                    static_cast<Entity *>(entity.get())->listComponents([&](std::type_index const &type, Plugin::Component::Data const *data) -> void
+                    {
+                        auto componentNameSearch = componentNameTypeMap.find(type);
+                        auto componentSearch = componentMap.find(type);
+                        if (componentNameSearch != std::end(componentNameTypeMap) && componentSearch != std::end(componentMap))
+                        {
+                            JSON::Object componentData;
+                            componentSearch->second->save(data, componentData);
+
+                            std::ostringstream stream;
+                            stream << componentData;
+                            componentDataList.push_back(std::make_pair(&componentNameSearch->second, stream.str()));
+                        }
+                    });
+
+                    std::sort(std::begin(componentDataList), std::end(componentDataList), [](auto const &leftData, auto const &rightData) -> bool
+                    {
+                        return (*leftData.first < *rightData.first);
+                    });
+
+                    for (auto const &componentData : componentDataList)
+                    {
+                        addData(*componentData.first);
+                        addData(componentData.second);
+                    }
+                }
+
+                return hash;
+            }
+
+            void startRecording(FileSystem::Path const &filePath)
+            {
+                if (currentPopulationName.empty())
+                {
+                    LockedWrite{ std::cerr } << String::Format("No population loaded to record: %v", filePath.u8string());
+                    return;
+                }
+
+                stopRecording();
+                session = Session::Recording;
+                sessionPath = filePath;
+                frameIndex = 0;
+                frameActionList.clear();
+                recordBuffer.clear();
+                load(currentPopulationName);
+            }
+
+            void stopRecording(void)
+            {
+                if (session != Session::Recording)
+                {
+                    return;
+                }
+
+                session = Session::None;
+
+                RecordHeader header;
+                header.identifier = RecordIdentifier;
+                header.version = RecordVersion;
+                header.nameLength = uint16_t(currentPopulationName.size());
+                header.randomSeed = randomSeed;
+                header.frameCount = frameIndex;
+                header.frameTime = fixedFrameTime;
+
+                std::vector<uint8_t> buffer(sizeof(RecordHeader) + header.nameLength + recordBuffer.size());
+                std::memcpy(buffer.data(), &header, sizeof(RecordHeader));
+                std::memcpy(&buffer[sizeof(RecordHeader)], currentPopulationName.data(), header.nameLength);
+                if (!recordBuffer.empty())
+                {
+                    std::memcpy(&buffer[sizeof(RecordHeader) + header.nameLength], recordBuffer.data(), recordBuffer.size());
+                }
+
+                FileSystem::Save(sessionPath, buffer);
+                recordBuffer.clear();
+
+                LockedWrite{ std::cout } << String::Format("Recorded %v updates of %v: %v", frameIndex, currentPopulationName, sessionPath.u8string());
+            }
+
+            bool startReplay(FileSystem::Path const &filePath)
+            {
+                auto buffer = FileSystem::Load(filePath, std::vector<uint8_t>());
+                if (buffer.size() < sizeof(RecordHeader))
+                {
+                    LockedWrite{ std::cerr } << String::Format("File too small to be a recording: %v", filePath.u8string());
+                    return false;
+                }
+
+                RecordHeader header;
+                std::memcpy(&header, buffer.data(), sizeof(RecordHeader));
+                if (header.identifier != RecordIdentifier)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unknown recording identifier encountered: %v", filePath.u8string());
+                    return false;
+                }
+
+                if (header.version != RecordVersion)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unsupported recording version encountered (requires: %v, has: %v): %v", RecordVersion, header.version, filePath.u8string());
+                    return false;
+                }
+
+                std::size_t position = sizeof(RecordHeader);
+                auto read = [&](void *data, std::size_t size) -> bool
+                {
+                    if ((position + size) > buffer.size())
+                    {
+                        return false;
+                    }
+
+                    std::memcpy(data, &buffer[position], size);
+                    position += size;
+                    return true;
+                };
+
+                std::string populationName(header.nameLength, ' ');
+                std::vector<RecordedFrame> frameList(header.frameCount);
+                bool valid = read(&populationName[0], header.nameLength);
+                for (auto frameSearch = std::begin(frameList); valid && frameSearch != std::end(frameList); ++frameSearch)
+                {
+                    uint32_t actionCount = 0;
+                    valid = (read(&actionCount, sizeof(uint32_t)) && read(&frameSearch->stateHash, sizeof(uint64_t)));
+                    for (uint32_t actionIndex = 0; valid && actionIndex < actionCount; ++actionIndex)
+                    {
+                        RecordedAction recordedAction;
+                        valid = read(&recordedAction, sizeof(RecordedAction));
+                        if (valid)
+                        {
+                            std::string actionName(recordedAction.nameLength, ' ');
+                            valid = (actionName.empty() || read(&actionName[0], recordedAction.nameLength));
+
+                            Action action;
+                            action.name = Identifier(actionName);
+                            std::memcpy(&action.value, &recordedAction.value, sizeof(uint32_t));
+                            frameSearch->actionList.push_back(action);
+                        }
+                    }
+                }
+
+                if (!valid || populationName.empty())
+                {
+                    LockedWrite{ std::cerr } << String::Format("Recording is truncated: %v", filePath.u8string());
+                    return false;
+                }
+
+                stopRecording();
+                session = (frameList.empty() ? Session::None : Session::Replaying);
+                sessionPath = filePath;
+                frameIndex = 0;
+                replayFrameList = std::move(frameList);
+                replaySeed = header.randomSeed;
+                replayMatched = true;
+                fixedFrameTime = header.frameTime;
+
+                LockedWrite{ std::cout } << String::Format("Replaying %v updates of %v: %v", header.frameCount, populationName, filePath.u8string());
+                load(populationName);
+                return true;
+            }
+
+            void finishSessionFrame(void)
+            {
+                auto stateHash = getStateHash();
+                if (session == Session::Recording)
+                {
+                    auto write = [this](void const *data, std::size_t size) -> void
+                    {
+                        auto bytes = static_cast<uint8_t const *>(data);
+                        recordBuffer.insert(std::end(recordBuffer), bytes, (bytes + size));
+                    };
+
+                    uint32_t actionCount = uint32_t(frameActionList.size());
+                    write(&actionCount, sizeof(uint32_t));
+                    write(&stateHash, sizeof(uint64_t));
+                    for (auto const &action : frameActionList)
+                    {
+                        auto const &actionName = action.name.getString();
+
+                        RecordedAction recordedAction;
+                        recordedAction.nameLength = uint32_t(actionName.size());
+                        std::memcpy(&recordedAction.value, &action.value, sizeof(uint32_t));
+                        write(&recordedAction, sizeof(RecordedAction));
+                        write(actionName.data(), actionName.size());
+                    }
+
+                    frameActionList.clear();
+                    ++frameIndex;
+                }
+                else if (session == Session::Replaying)
+                {
+                    if (replayMatched && stateHash != replayFrameList[frameIndex].stateHash)
+                    {
+                        replayMatched = false;
+                        LockedWrite{ std::cerr } << String::Format("Replay diverged from the recording at update %v: %v", frameIndex, sessionPath.u8string());
+                    }
+
+                    if (++frameIndex == replayFrameList.size())
+                    {
+                        LockedWrite{ std::cout } << String::Format("Replay finished, %v: %v", (replayMatched ? "every update matched" : "updates diverged"), sessionPath.u8string());
+                        session = Session::None;
+                        replayFrameList.clear();
+                    }
+                }
+            }
+
             void update(float frameTime)
             {
+                GEK_PROFILE_ZONE("Population Update");
+                Memory::Scope memoryScope(Memory::Tag::Population);
+                GEK_PROFILE_COUNTER("Entities", entityList.size());
+
+                // Hold the simulation until a load has finished and all of its entities have been added
+                if (deterministic && frameTime > 0.0f)
+                {
+                    frameTime = ((loading || !entityQueue.empty()) ? 0.0f : fixedFrameTime);
+                }
+
                 if (frameTime == 0.0f)
                 {
                     actionQueue.clear();
                 }
+                else if (session == Session::Replaying)
+                {
+                    // Live input is dropped while replaying, only the recorded actions are used
+                    actionQueue.clear();
+                    for (auto const &action : replayFrameList[frameIndex].actionList)
+                    {
+                        onAction(action);
+                    }
+                }
                 else
                 {
                     Action action;
                     while (actionQueue.try_pop(action))
                     {
+                        if (session == Session::Recording)
+                        {
+                            frameActionList.push_back(action);
+                        }
+
                         onAction(action);
                     };
                 }
@@ -208,6 +526,11 @@ namespace Gek
                 {
                     entityAction();
                 };
+
+                if (frameTime > 0.0f && session != Session::None)
+                {
+                    finishSessionFrame();
+                }
             }
 
             void action(Action const &action)
@@ -227,48 +550,56 @@ namespace Gek
 
             void load(std::string const &populationName)
             {
+                currentPopulationName = populationName;
+                deterministic = (session != Session::None || core->getOption("population", "deterministic").convert(false));
+                if (session != Session::Replaying)
+                {
+                    fixedFrameTime = core->getOption("population", "frameTime").convert(1.0f / 60.0f);
+                }
+
+                loading = true;
                 reset();
-                workerPool.enqueue([this, populationName](void) -> void
+                workerPool.enqueue([this, populationName, loadDeterministic = deterministic, loadReplay = (session == Session::Replaying), loadSeed = replaySeed](void) -> void
                 {
+                    GEK_PROFILE_ZONE("Population Load");
+                    Memory::Scope memoryScope(Memory::Tag::Population);
                     LockedWrite{ std::cout } << String::Format("Loading population: %v", populationName);
 
-                    JSON::Instance worldNode = JSON::Load(getContext()->getRootFileName("data", "scenes", populationName).withExtension(".json"));
-                    shuntingYard.setRandomSeed(worldNode.get("Seed").convert(uint32_t(std::time(nullptr) & 0xFFFFFFFF)));
+                    // Components are loaded straight from the immutable document, template
+                    // members are only visited when the entity doesn't override them
+                    auto document = JSON::Document::Load(getContext()->getRootFileName("data", "scenes", populationName).withExtension(".json"));
+                    auto worldNode = document.getRoot();
+                    randomSeed = (loadReplay ? loadSeed : worldNode.get("Seed").convert(loadDeterministic ? 0U : uint32_t(std::time(nullptr) & 0xFFFFFFFF)));
+                    shuntingYard.setRandomSeed(randomSeed);
 
                     auto templatesNode = worldNode.get("Templates");
-                    auto &populationNode = worldNode.get("Population");
-                    LockedWrite{ std::cout } << String::Format("Found %v Entity Definitions", populationNode.getArray().size());
-                    for (auto const &entityNode : populationNode.getArray())
+                    auto populationNode = worldNode.get("Population");
+                    LockedWrite{ std::cout } << String::Format("Found %v Entity Definitions", populationNode.getSize());
+
+                    JSON::View::MemberList entityComponentList;
+                    for (auto entityNode : populationNode.getArray())
                     {
-                        std::vector<Component> entityComponentList;
-                        if (entityNode.has_member("Template"))
+                        entityComponentList.clear();
+                        auto templateNode = templatesNode.get(entityNode.get("Template").getString());
+                        for (auto const &componentNode : templateNode.getMembers())
                         {
-                            auto &entityTemplateNode = entityNode["Template"];
-                            auto &templateNode = templatesNode.get(entityTemplateNode.as_string());
-                            for (auto const &componentNode : templateNode.getMembers())
-                            {
-                                entityComponentList.push_back(std::make_pair(componentNode.name(), componentNode.value()));
-                            }
+                            entityComponentList.push_back(componentNode);
                         }
 
-                        for (auto const &componentNode : entityNode.members())
+                        for (auto const &componentNode : entityNode.getMembers())
                         {
-                            auto componentSearch = std::find_if(std::begin(entityComponentList), std::end(entityComponentList), [&](Component const &componentData) -> bool
+                            auto componentSearch = std::find_if(std::begin(entityComponentList), std::end(entityComponentList), [&](auto const &componentData) -> bool
                             {
-                                return (componentData.first == componentNode.name());
+                                return (componentData.first == componentNode.first);
                             });
 
                             if (componentSearch == std::end(entityComponentList))
                             {
-                                entityComponentList.push_back(std::make_pair(componentNode.name(), componentNode.value()));
+                                entityComponentList.push_back(componentNode);
                             }
                             else
                             {
-                                auto &componentData = (*componentSearch);
-                                for (auto const &attribute : componentNode.value().members())
-                                {
-                                    componentData.second[attribute.name()] = attribute.value();
-                                }
+                                componentSearch->second = componentNode.second.withFallback(componentSearch->second);
                             }
                         }
 
@@ -277,13 +608,15 @@ namespace Gek
                         {
                             if (componentData.first != "Template")
                             {
-                                addComponent(populationEntity, componentData);
+                                addComponent(populationEntity, componentData.first, componentData.second);
                             }
                         }
 
                         auto entity = dynamic_cast<Plugin::Entity *>(populationEntity);
                         queueEntity(entity);
                     }
+
+                    loading = false;
                 });
             }
 
@@ -357,10 +690,17 @@ namespace Gek
             }
 
             bool addComponent(Entity *entity, Component const &componentData)
+            {
+                auto document = JSON::Document::Make(componentData.second);
+                return addComponent(entity, componentData.first, document.getRoot());
+            }
+
+            bool addComponent(Entity *entity, std::string_view name, JSON::View componentData)
             {
                 assert(entity);
 
-                auto componentNameSearch = componentTypeNameMap.find(componentData.first);
+                // Interning compares the name itself, so a name that only hashes the same as a component never matches it
+                auto componentNameSearch = componentTypeNameMap.find(Identifier(name));
                 if (componentNameSearch != std::end(componentTypeNameMap))
                 {
                     auto componentSearch = componentMap.find(componentNameSearch->second);
@@ -368,7 +708,7 @@ namespace Gek
                     {
                         Plugin::Component *componentManager = componentSearch->second.get();
                         auto component(componentManager->create());
-                        componentManager->load(component.get(), componentData.second);
+                        componentManager->load(component.get(), componentData);
 
                         entity->addComponent(componentManager, std::move(component));
                         return true;
@@ -380,7 +720,7 @@ namespace Gek
                 }
                 else
                 {
-                    LockedWrite{ std::cerr } << String::Format("Entity contains unknown component: %v", componentData.first);
+                    LockedWrite{ std::cerr } << String::Format("Entity contains unknown component: %v", name);
                 }
 
                 return false;
@@ -407,6 +747,16 @@ namespace Gek
 
             void listEntities(std::function<void(Plugin::Entity *)> onEntity) const
             {
+                if (deterministic)
+                {
+                    for (auto const &entity : entityList)
+                    {
+                        onEntity(entity.get());
+                    }
+
+                    return;
+                }
+
                 concurrency::parallel_for_each(std::begin(entityList), std::end(entityList), [&](auto &entity) -> void
                 {
                     onEntity(entity.get());
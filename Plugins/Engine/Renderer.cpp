@@ -5,6 +5,8 @@
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/Utility/Allocator.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Renderer.hpp"
 #include "GEK/Engine/Resources.hpp"
@@ -182,7 +184,7 @@ namespace Gek
             {
                 Video::Device *videoDevice = nullptr;
                 std::vector<Plugin::Entity *> entityList;
-                concurrency::concurrent_vector<DATA, AlignedAllocator<DATA, 16>> lightList;
+                concurrency::concurrent_vector<DATA, AlignedAllocator<DATA, 16, Memory::Tag::Renderer>> lightList;
                 Video::BufferPtr lightDataBuffer;
 
                 concurrency::critical_section addSection;
@@ -269,10 +271,10 @@ namespace Gek
             struct LightVisibilityData
                 : public LightData<COMPONENT, DATA>
             {
-                std::vector<float, AlignedAllocator<float, 16>> shapeXPositionList;
-                std::vector<float, AlignedAllocator<float, 16>> shapeYPositionList;
-                std::vector<float, AlignedAllocator<float, 16>> shapeZPositionList;
-                std::vector<float, AlignedAllocator<float, 16>> shapeRadiusList;
+                std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Renderer>> shapeXPositionList;
+                std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Renderer>> shapeYPositionList;
+                std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Renderer>> shapeZPositionList;
+                std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Renderer>> shapeRadiusList;
                 std::vector<bool> visibilityList;
 
                 LightVisibilityData(size_t reserve, Video::Device *videoDevice)
@@ -306,9 +308,9 @@ namespace Gek
                         auto &transformComponent = entity->getComponent<Components::Transform>();
                         auto &lightComponent = entity->getComponent<COMPONENT>();
 
-                        shapeXPositionList[entityIndex] = transformComponent.position.x;
-                        shapeYPositionList[entityIndex] = transformComponent.position.y;
-                        shapeZPositionList[entityIndex] = transformComponent.position.z;
+                        shapeXPositionList[entityIndex] = transformComponent.cachedMatrix.translation.x;
+                        shapeYPositionList[entityIndex] = transformComponent.cachedMatrix.translation.y;
+                        shapeZPositionList[entityIndex] = transformComponent.cachedMatrix.translation.z;
                         shapeRadiusList[entityIndex] = (lightComponent.range + lightComponent.radius);
                     }
 
@@ -1080,26 +1082,10 @@ namespace Gek
             }
 
             // Clustered Lighting
-            inline Math::Float3 getLightDirection(Math::Quaternion const &quaternion) const
+            // Lights shine along the negative Y axis of their world matrix
+            inline Math::Float3 getLightDirection(Math::Float4x4 const &matrix) const
             {
-                const float xx(quaternion.x * quaternion.x);
-                const float yy(quaternion.y * quaternion.y);
-                const float zz(quaternion.z * quaternion.z);
-                const float ww(quaternion.w * quaternion.w);
-                const float length(xx + yy + zz + ww);
-                if (length == 0.0f)
-                {
-                    return Math::Float3(0.0f, 1.0f, 0.0f);
-                }
-                else
-                {
-                    const float determinant(1.0f / length);
-                    const float xy(quaternion.x * quaternion.y);
-                    const float xw(quaternion.x * quaternion.w);
-                    const float yz(quaternion.y * quaternion.z);
-                    const float zw(quaternion.z * quaternion.w);
-                    return -Math::Float3((2.0f * (xy - zw) * determinant), ((-xx + yy - zz + ww) * determinant), (2.0f * (yz + xw) * determinant));
-                }
+                return -matrix.ry.xyz;
             }
 
             inline void updateClipRegionRoot(float tangentCoordinate, float lightCoordinate, float lightDepth, float radius, float radiusSquared, float lightRangeSquared, float cameraScale, float& minimum, float& maximum) const
@@ -1244,7 +1230,7 @@ namespace Gek
                 auto lightIterator = pointLightData.lightList.grow_by(1);
                 PointLightData &lightData = (*lightIterator);
                 lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-                lightData.position = currentCamera.viewMatrix.transform(transformComponent.position);
+                lightData.position = currentCamera.viewMatrix.transform(transformComponent.cachedMatrix.translation.xyz);
                 lightData.radius = lightComponent.radius;
                 lightData.range = lightComponent.range;
 
@@ -1260,10 +1246,10 @@ namespace Gek
                 auto lightIterator = spotLightData.lightList.grow_by(1);
                 SpotLightData &lightData = (*lightIterator);
                 lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-                lightData.position = currentCamera.viewMatrix.transform(transformComponent.position);
+                lightData.position = currentCamera.viewMatrix.transform(transformComponent.cachedMatrix.translation.xyz);
                 lightData.radius = lightComponent.radius;
                 lightData.range = lightComponent.range;
-                lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.rotation));
+                lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.cachedMatrix));
                 lightData.innerAngle = lightComponent.innerAngle;
                 lightData.outerAngle = lightComponent.outerAngle;
                 lightData.coneFalloff = lightComponent.coneFalloff;
@@ -1334,6 +1320,9 @@ namespace Gek
             // Plugin::Core Slots
             void onUpdate(float frameTime)
             {
+                GEK_PROFILE_ZONE("Renderer Update");
+                Memory::Scope memoryScope(Memory::Tag::Renderer);
+
                 assert(videoDevice);
                 assert(population);
 
@@ -1400,7 +1389,7 @@ namespace Gek
 
                                     DirectionalLightData lightData;
                                     lightData.radiance = (colorComponent.value.xyz * lightComponent.intensity);
-                                    lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.rotation));
+                                    lightData.direction = currentCamera.viewMatrix.rotate(getLightDirection(transformComponent.cachedMatrix));
                                     directionalLightData.lightList.push_back(lightData);
                                 });
 
@@ -1418,6 +1407,8 @@ namespace Gek
 
                             auto pointLightsDone = workerPool.enqueue([&](void) -> void
                             {
+                                GEK_PROFILE_ZONE("Light Clustering");
+                                Memory::Scope memoryScope(Memory::Tag::Renderer);
                                 pointLightData.update(videoDevice, frustum, [this](Plugin::Entity * const entity, const Components::PointLight &lightComponent) -> void
                                 {
                                     addLight(entity, lightComponent);
@@ -1426,6 +1417,8 @@ namespace Gek
 
                             auto spotLightsDone = workerPool.enqueue([&](void) -> void
                             {
+                                GEK_PROFILE_ZONE("Light Clustering");
+                                Memory::Scope memoryScope(Memory::Tag::Renderer);
                                 spotLightData.update(videoDevice, frustum, [this](Plugin::Entity * const entity, const Components::SpotLight &lightComponent) -> void
                                 {
                                     addLight(entity, lightComponent);
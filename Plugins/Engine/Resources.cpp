@@ -1,7 +1,6 @@
 ﻿#define _ENABLE_ATOMIC_ALIGNMENT_FIX
 
 #include "GEK/Utility/String.hpp"
-#include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/Utility/ShuntingYard.hpp"
 #include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/JSON.hpp"
@@ -21,6 +20,7 @@
 #include "GEK/Components/Light.hpp"
 #include "GEK/Components/Color.hpp"
 #include "GEK/Utility/ContextUser.hpp"
+#include "LoadScheduler.hpp"
 #include <concurrent_unordered_map.h>
 #include <concurrent_unordered_set.h>
 #include <concurrent_queue.h>
@@ -108,7 +108,8 @@ namespace Gek
         {
             virtual ~ResourceRequester(void) = default;
 
-            virtual void addRequest(std::function<void(void)> &&load) = 0;
+            virtual void addRequest(std::size_t key, float priority, std::function<void(void)> &&load) = 0;
+            virtual void prioritizeRequest(std::size_t key, float priority) = 0;
         };
 
         template <class HANDLE, typename TYPE>
@@ -174,62 +175,68 @@ namespace Gek
             {
                 return InterlockedIncrement(&nextIdentifier);
             }
+
+            std::size_t getRequestKey(HANDLE handle) const
+            {
+                return CombineHashes(typeid(TYPE).hash_code(), handle.identifier);
+            }
+
+            void requestLoad(HANDLE handle, float priority, std::function<TypePtr(HANDLE)> &&load)
+            {
+                resources->addRequest(getRequestKey(handle), priority, [this, handle, load = move(load)](void) -> void
+                {
+                    setResource(handle, load(handle));
+                });
+            }
+
+            void prioritize(HANDLE handle, float priority)
+            {
+                resources->prioritizeRequest(getRequestKey(handle), priority);
+            }
         };
 
         template <class HANDLE, typename TYPE>
         class GeneralResourceCache
             : public ResourceCache<HANDLE, TYPE>
         {
-        private:
-            concurrency::concurrent_unordered_set<std::size_t> requestedLoadSet;
-
         public:
             GeneralResourceCache(ResourceRequester *resources)
                 : ResourceCache(resources)
             {
             }
 
-            void clear(void)
+            std::pair<bool, HANDLE> getHandle(std::size_t hash, std::function<TypePtr(HANDLE)> &&load, float priority = Plugin::Resources::Priority::Normal)
             {
-                requestedLoadSet.clear();
-                ResourceCache::clear();
-            }
-
-            std::pair<bool, HANDLE> getHandle(std::size_t hash, std::function<TypePtr(HANDLE)> &&load)
-            {
-                if (requestedLoadSet.count(hash) > 0)
+                auto resourceSearch = resourceHandleMap.find(hash);
+                if (resourceSearch != std::end(resourceHandleMap))
                 {
-                    auto resourceSearch = resourceHandleMap.find(hash);
-                    if (resourceSearch != std::end(resourceHandleMap))
+                    if (!getResource(resourceSearch->second))
                     {
-                        return std::make_pair(false, resourceSearch->second);
+                        prioritize(resourceSearch->second, priority);
                     }
+
+                    return std::make_pair(false, resourceSearch->second);
                 }
-                else
-                {
-                    requestedLoadSet.insert(hash);
-                    HANDLE handle = getNextHandle();
-                    resourceHandleMap[hash] = handle;
-                    resources->addRequest([this, handle, load = move(load)](void) -> void
-                    {
-                        setResource(handle, load(handle));
-                    });
 
-                    return std::make_pair(true, handle);
+                // Only the thread that wins the insert queues the load, everyone else shares its handle
+                auto resourceInsert = resourceHandleMap.insert(std::make_pair(hash, HANDLE(getNextHandle())));
+                HANDLE handle = resourceInsert.first->second;
+                if (!resourceInsert.second)
+                {
+                    prioritize(handle, priority);
+                    return std::make_pair(false, handle);
                 }
 
-                return std::make_pair(false, HANDLE());
+                requestLoad(handle, priority, std::move(load));
+                return std::make_pair(true, handle);
             }
 
             HANDLE getHandle(std::size_t hash) const
             {
-                if (requestedLoadSet.count(hash) > 0)
+                auto resourceSearch = resourceHandleMap.find(hash);
+                if (resourceSearch != std::end(resourceHandleMap))
                 {
-                    auto resourceSearch = resourceHandleMap.find(hash);
-                    if (resourceSearch != std::end(resourceHandleMap))
-                    {
-                        return resourceSearch->second;
-                    }
+                    return resourceSearch->second;
                 }
 
                 return HANDLE();
@@ -264,7 +271,7 @@ namespace Gek
                 setResource(handle, data);
             }
 
-            std::pair<bool, HANDLE> getHandle(std::size_t hash, std::size_t parameters, std::function<TypePtr(HANDLE)> &&load, uint32_t flags)
+            std::pair<bool, HANDLE> getHandle(std::size_t hash, std::size_t parameters, std::function<TypePtr(HANDLE)> &&load, uint32_t flags, float priority = Plugin::Resources::Priority::Normal)
             {
                 HANDLE handle;
                 if (requestedLoadSet.count(hash) > 0)
@@ -285,10 +292,7 @@ namespace Gek
                                 }
                                 else
                                 {
-                                    resources->addRequest([this, handle, load = move(load)](void) -> void
-                                    {
-                                        setResource(handle, load(handle));
-                                    });
+                                    requestLoad(handle, priority, std::move(load));
                                 }
 
                                 return std::make_pair(true, handle);
@@ -310,10 +314,7 @@ namespace Gek
                     }
                     else
                     {
-                        resources->addRequest([this, handle, load = move(load)](void) -> void
-                        {
-                            setResource(handle, load(handle));
-                        });
+                        requestLoad(handle, priority, std::move(load));
                     }
 
                     return std::make_pair(true, handle);
@@ -351,11 +352,9 @@ namespace Gek
             {
                 HANDLE handle;
                 handle = getNextHandle();
-                resources->addRequest([this, handle, load = move(load)](void) -> void
-                {
-                    setResource(handle, load(handle));
-                });
 
+                // Every pass and filter needs its programs before anything can be drawn
+                requestLoad(handle, Plugin::Resources::Priority::Immediate, std::move(load));
                 return handle;
             }
         };
@@ -505,10 +504,11 @@ namespace Gek
         {
         private:
             Plugin::Core *core = nullptr;
+            Plugin::Population *population = nullptr;
             Video::Device *videoDevice = nullptr;
             Plugin::Renderer *renderer = nullptr;
 
-            ThreadPool loadPool;
+            LoadScheduler loadScheduler;
             std::recursive_mutex shaderMutex;
 
             ProgramResourceCache<ProgramHandle, Video::Object> programCache;
@@ -552,6 +552,7 @@ namespace Gek
             Resources(Context *context, Plugin::Core *core)
                 : ContextRegistration(context)
                 , core(core)
+                , population(core->getPopulation())
                 , videoDevice(core->getVideoDevice())
                 , programCache(this)
                 , visualCache(this)
@@ -562,15 +563,17 @@ namespace Gek
                 , renderStateCache(this)
                 , depthStateCache(this)
                 , blendStateCache(this)
-                , loadPool(2)
+                , loadScheduler(2)
             {
                 assert(core);
+                assert(population);
                 assert(videoDevice);
 
                 core->onChangedDisplay.connect(this, &Resources::onReload);
                 core->onChangedSettings.connect(this, &Resources::onReload);
                 core->onInitialized.connect(this, &Resources::onInitialized);
                 core->onShutdown.connect(this, &Resources::onShutdown);
+                population->onUpdate[0].connect(this, &Resources::onUpdate);
             }
 
             Validate &getValid(Video::Device::Context::Pipeline *videoPipeline)
@@ -689,6 +692,7 @@ namespace Gek
                     ImGui::SetNextWindowSize(ImVec2(500.0f, 350.0f), ImGuiSetCond_Once);
                     if (ImGui::Begin("Resources"))
                     {
+                        ImGui::Text(String::Format("Pending Loads: %v", loadScheduler.getPendingCount()).c_str());
                         showProgramCache();
                         showVisualCache();
                         showMaterialCache();
@@ -926,11 +930,13 @@ namespace Gek
             {
                 renderer = core->getRenderer();
                 renderer->onShowUserInterface.connect(this, &Resources::onShowUserInterface);
+                setLoadLimit(core->getOption("resources", "loadsPerFrame").convert(0U));
             }
 
             void onShutdown(void)
             {
-                loadPool.drain();
+                loadScheduler.drain();
+                population->onUpdate[0].disconnect(this, &Resources::onUpdate);
                 if (renderer)
                 {
                     renderer->onShowUserInterface.disconnect(this, &Resources::onShowUserInterface);
@@ -945,17 +951,25 @@ namespace Gek
                 filterCache.reload();
             }
 
+            // Plugin::Population Slots
+            void onUpdate(float frameTime)
+            {
+                loadScheduler.beginFrame();
+            }
+
             // ResourceRequester
-            void addRequest(std::function<void(void)> &&load)
+            void addRequest(std::size_t key, float priority, std::function<void(void)> &&load)
             {
-                loadPool.enqueue([this, load = move(load)](void) -> void
-                {
-                    load();
-                });
+                loadScheduler.request(key, priority, std::move(load));
+            }
+
+            void prioritizeRequest(std::size_t key, float priority)
+            {
+                loadScheduler.prioritize(key, priority);
             }
 
             // Plugin::Resources
-            VisualHandle loadVisual(std::string const &visualName)
+            VisualHandle loadVisual(std::string const &visualName, float priority)
             {
                 auto load = [this, visualName](VisualHandle)->Plugin::VisualPtr
                 {
@@ -963,10 +977,10 @@ namespace Gek
                 };
 
                 auto hash = GetHash(visualName);
-                return visualCache.getHandle(hash, std::move(load)).second;
+                return visualCache.getHandle(hash, std::move(load), priority).second;
             }
 
-            MaterialHandle loadMaterial(std::string const &materialName)
+            MaterialHandle loadMaterial(std::string const &materialName, float priority)
             {
                 auto load = [this, materialName](MaterialHandle handle)->Engine::MaterialPtr
                 {
@@ -974,10 +988,10 @@ namespace Gek
                 };
 
                 auto hash = GetHash(materialName);
-                return materialCache.getHandle(hash, std::move(load)).second;
+                return materialCache.getHandle(hash, std::move(load), priority).second;
             }
 
-            ResourceHandle loadTexture(std::string const &textureName, uint32_t flags)
+            ResourceHandle loadTexture(std::string const &textureName, uint32_t flags, float priority)
             {
                 // iterate over formats in case the texture name has no extension
                 static const std::string formatList[] =
@@ -1005,7 +1019,7 @@ namespace Gek
                         };
 
                         auto hash = GetHash(textureName);
-                        auto resource = dynamicCache.getHandle(hash, flags, std::move(load), false);
+                        auto resource = dynamicCache.getHandle(hash, flags, std::move(load), false, priority);
                         if (resource.first)
                         {
                             auto description = videoDevice->loadTextureDescription(filePath);
@@ -1019,6 +1033,21 @@ namespace Gek
                 return ResourceHandle();
             }
 
+            void prioritize(VisualHandle handle, float priority)
+            {
+                visualCache.prioritize(handle, priority);
+            }
+
+            void prioritize(MaterialHandle handle, float priority)
+            {
+                materialCache.prioritize(handle, priority);
+            }
+
+            void prioritize(ResourceHandle handle, float priority)
+            {
+                dynamicCache.prioritize(handle, priority);
+            }
+
             ResourceHandle createPattern(std::string const &pattern, JSON::Reference parameters)
             {
                 auto lowerPattern = String::GetLower(pattern);
@@ -1373,7 +1402,7 @@ namespace Gek
             {
                 textureDescriptionMap.clear();
                 bufferDescriptionMap.clear();
-                loadPool.reset();
+                loadScheduler.reset();
                 materialShaderMap.clear();
                 programCache.clear();
                 materialCache.clear();
@@ -1385,6 +1414,16 @@ namespace Gek
                 blendStateCache.clear();
             }
 
+            void setLoadLimit(uint32_t requestsPerFrame)
+            {
+                loadScheduler.setFrameLimit(requestsPerFrame);
+            }
+
+            size_t getPendingLoadCount(void)
+            {
+                return loadScheduler.getPendingCount();
+            }
+
             ShaderHandle getMaterialShader(MaterialHandle material) const
             {
                 auto shaderSearch = materialShaderMap.find(material);
@@ -1500,7 +1539,10 @@ namespace Gek
 					FileSystem::Save(debugPath, uncompiledProgram);
 #endif
 					compiledProgram = videoDevice->compileProgram(pipelineType, name, uncompiledProgram, entryFunction);
-                    FileSystem::Save(cachePath, compiledProgram);
+                    if (!compiledProgram.empty())
+                    {
+                        FileSystem::Save(cachePath, compiledProgram);
+                    }
                 }
 
                 return compiledProgram;
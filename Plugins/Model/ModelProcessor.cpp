@@ -4,7 +4,10 @@
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/ThreadPool.hpp"
 #include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/Identifier.hpp"
 #include "GEK/Utility/Allocator.hpp"
 #include "GEK/Utility/ContextUser.hpp"
 #include "GEK/System/VideoDevice.hpp"
@@ -54,7 +57,7 @@ namespace Gek
             componentData = data->name;
         }
 
-        void load(Components::Model * const data, JSON::Reference componentData)
+        void load(Components::Model * const data, JSON::View componentData)
         {
             data->name = parse(componentData, String::Empty);
         }
@@ -239,12 +242,12 @@ namespace Gek
         Video::BufferPtr instanceBuffer;
         ThreadPool loadPool;
 
-        concurrency::concurrent_unordered_map<std::size_t, Group> groupMap;
+        concurrency::concurrent_unordered_map<Identifier, Group> groupMap;
 
-        std::vector<float, AlignedAllocator<float, 16>> halfSizeXList;
-        std::vector<float, AlignedAllocator<float, 16>> halfSizeYList;
-        std::vector<float, AlignedAllocator<float, 16>> halfSizeZList;
-        std::vector<float, AlignedAllocator<float, 16>> transformList[16];
+        std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Models>> halfSizeXList;
+        std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Models>> halfSizeYList;
+        std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Models>> halfSizeZList;
+        std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Models>> transformList[16];
         std::vector<bool> visibilityList;
 
         using EntityDataList = concurrency::concurrent_vector<std::tuple<Plugin::Entity * const, Data const *, uint32_t>>;
@@ -284,7 +287,7 @@ namespace Gek
             population->onComponentRemoved.connect(this, &ModelProcessor::onComponentRemoved);
             renderer->onQueueDrawCalls.connect(this, &ModelProcessor::onQueueDrawCalls);
 
-            visual = resources->loadVisual("model");
+            visual = resources->loadVisual("model", Plugin::Resources::Priority::Immediate);
 
             Video::Buffer::Description instanceDescription;
             instanceDescription.stride = sizeof(Math::Float4x4);
@@ -299,7 +302,7 @@ namespace Gek
         {
             ProcessorMixin::addEntity(entity, [&](bool isNewInsert, auto &data, auto &modelComponent, auto &transformComponent) -> void
             {
-                auto pair = groupMap.insert(std::make_pair(GetHash(modelComponent.name), Group()));
+                auto pair = groupMap.insert(std::make_pair(Identifier(modelComponent.name), Group()));
                 if (pair.second)
                 {
                     LockedWrite{ std::cout } << String::Format("Queueing group for load: %v", modelComponent.name);
@@ -357,13 +360,27 @@ namespace Gek
                             auto &filePath = modelPathList[modelIndex];
                             loadPool.enqueue([this, name = name, filePath, &group, &model](void) -> void
                             {
+                                GEK_PROFILE_ZONE("Model Load");
+                                Memory::Scope memoryScope(Memory::Tag::Models);
                                 auto fileName(filePath.getFileName());
 
-                                static const std::vector<uint8_t> EmptyBuffer;
-                                std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer));
+                                // Buffers copy their initial data, so the model can be read straight out of the mapped file
+                                // Models inside a mounted archive can't be mapped on their own, those are loaded whole instead
+                                FileSystem::MappedFile mappedFile;
+                                std::vector<uint8_t> packedFile;
+                                if (FileSystem::IsPackedFile(filePath))
+                                {
+                                    packedFile = FileSystem::Load(filePath, std::vector<uint8_t>());
+                                }
+                                else
+                                {
+                                    mappedFile = FileSystem::MappedFile(filePath);
+                                }
 
-                                Header *header = (Header *)buffer.data();
-                                if (buffer.size() < (sizeof(Header) + (sizeof(Header::Mesh) * header->meshCount)))
+                                uint8_t const *fileData = (mappedFile ? mappedFile.getData() : packedFile.data());
+                                size_t fileSize = (mappedFile ? mappedFile.getSize() : packedFile.size());
+                                Header const *header = (Header const *)fileData;
+                                if (fileSize < sizeof(Header) || fileSize < (sizeof(Header) + (sizeof(Header::Mesh) * header->meshCount)))
                                 {
                                     LockedWrite{ std::cerr } << String::Format("Model file too small to contain mesh headers: %v", filePath.u8string());
                                     return;
@@ -375,10 +392,10 @@ namespace Gek
                                 group.boundingBox.extend(model.boundingBox.minimum);
                                 group.boundingBox.extend(model.boundingBox.maximum);
                                 model.meshList.resize(header->meshCount);
-                                uint8_t *bufferData = (uint8_t *)&header->meshList[header->meshCount];
+                                uint8_t const *bufferData = (uint8_t const *)&header->meshList[header->meshCount];
                                 for (uint32_t meshIndex = 0; meshIndex < header->meshCount; ++meshIndex)
                                 {
-                                    Header::Mesh &meshHeader = header->meshList[meshIndex];
+                                    Header::Mesh const &meshHeader = header->meshList[meshIndex];
                                     Group::Model::Mesh &mesh = model.meshList[meshIndex];
 
                                     mesh.material = resources->loadMaterial(meshHeader.material);
@@ -387,30 +404,30 @@ namespace Gek
                                     indexBufferDescription.format = Video::Format::R16_UINT;
                                     indexBufferDescription.count = (meshHeader.faceCount * 3);
                                     indexBufferDescription.type = Video::Buffer::Type::Index;
-                                    mesh.indexBuffer = resources->createBuffer(String::Format("model:%v.%v.%v:indices", meshIndex, fileName, name), indexBufferDescription, reinterpret_cast<uint16_t *>(bufferData));
+                                    mesh.indexBuffer = resources->createBuffer(String::Format("model:%v.%v.%v:indices", meshIndex, fileName, name), indexBufferDescription, reinterpret_cast<uint16_t const *>(bufferData));
                                     bufferData += (sizeof(Face) * meshHeader.faceCount);
 
                                     Video::Buffer::Description vertexBufferDescription;
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
                                     vertexBufferDescription.count = meshHeader.vertexCount;
                                     vertexBufferDescription.type = Video::Buffer::Type::Vertex;
-                                    mesh.vertexBufferList[0] = resources->createBuffer(String::Format("model:%v.%v.%v:positions", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[0] = resources->createBuffer(String::Format("model:%v.%v.%v:positions", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float2);
-                                    mesh.vertexBufferList[1] = resources->createBuffer(String::Format("model:%v.%v.%v:texcoords", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float2 *>(bufferData));
+                                    mesh.vertexBufferList[1] = resources->createBuffer(String::Format("model:%v.%v.%v:texcoords", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float2 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float2) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[2] = resources->createBuffer(String::Format("model:%v.%v.%v:tangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[2] = resources->createBuffer(String::Format("model:%v.%v.%v:tangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[3] = resources->createBuffer(String::Format("model:%v.%v.%v:bitangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[3] = resources->createBuffer(String::Format("model:%v.%v.%v:bitangents", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     vertexBufferDescription.stride = sizeof(Math::Float3);
-                                    mesh.vertexBufferList[4] = resources->createBuffer(String::Format("model:%v.%v.%v:normals", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 *>(bufferData));
+                                    mesh.vertexBufferList[4] = resources->createBuffer(String::Format("model:%v.%v.%v:normals", meshIndex, fileName, name), vertexBufferDescription, reinterpret_cast<Math::Float3 const *>(bufferData));
                                     bufferData += (sizeof(Math::Float3) * meshHeader.vertexCount);
 
                                     mesh.indexCount = indexBufferDescription.count;
@@ -460,7 +477,7 @@ namespace Gek
         // Model::Processor
         Shapes::AlignedBox getBoundingBox(std::string const &modelName)
         {
-            auto modelSearch = groupMap.find(GetHash(modelName));
+            auto modelSearch = groupMap.find(Identifier(modelName));
             if (modelSearch != std::end(groupMap))
             {
                 return modelSearch->second.boundingBox;
@@ -507,6 +524,9 @@ namespace Gek
         // Plugin::Renderer Slots
         void onQueueDrawCalls(const Shapes::Frustum &viewFrustum, Math::Float4x4 const &viewMatrix, Math::Float4x4 const &projectionMatrix)
         {
+            GEK_PROFILE_ZONE("Model Draw Calls");
+            Memory::Scope memoryScope(Memory::Tag::Models);
+
             assert(renderer);
 
             // Cull by entity/group
@@ -527,9 +547,9 @@ namespace Gek
             parallelListEntities([&](Plugin::Entity * const entity, auto &data, auto &modelComponent, auto &transformComponent) -> void
             {
                 auto group = data.group;
-                auto matrix(transformComponent.getMatrix());
+                auto matrix(transformComponent.cachedMatrix);
                 matrix.translation.xyz += group->boundingBox.getCenter();
-                auto halfSize(group->boundingBox.getHalfSize() * transformComponent.scale);
+                auto halfSize(group->boundingBox.getHalfSize() * transformComponent.getWorldScale());
 
                 auto entityInsert = entityDataList.push_back(std::make_tuple(entity, &data, 0));
                 auto entityIndex = std::get<2>(*entityInsert) = std::distance(std::begin(entityDataList), entityInsert);
@@ -581,11 +601,11 @@ namespace Gek
                     auto group = data->group;
 
                     auto &transformComponent = entity->getComponent<Components::Transform>();
-                    auto matrix(transformComponent.getMatrix());
+                    auto matrix(transformComponent.cachedMatrix);
 
                     concurrency::parallel_for_each(std::begin(group->modelList), std::end(group->modelList), [&](Group::Model const &model) -> void
                     {
-                        auto halfSize(group->boundingBox.getHalfSize() * transformComponent.scale);
+                        auto halfSize(group->boundingBox.getHalfSize() * transformComponent.getWorldScale());
                         auto center = Math::Float4x4::MakeTranslation(model.boundingBox.getCenter());
 
                         auto entityInsert = entityModelList.push_back(std::make_tuple(entity, &model, 0));
@@ -614,7 +634,7 @@ namespace Gek
                     auto model = std::get<1>(entitySearch);
 
                     auto &transformComponent = entity->getComponent<Components::Transform>();
-                    auto modelViewMatrix(transformComponent.getScaledMatrix() * viewMatrix);
+                    auto modelViewMatrix(transformComponent.cachedScaledMatrix * viewMatrix);
 
                     concurrency::parallel_for_each(std::begin(model->meshList), std::end(model->meshList), [&](Group::Model::Mesh const &mesh) -> void
                     {
@@ -640,6 +660,7 @@ namespace Gek
                     materialInstanceCount += materialInstanceList.size();
                 }
 
+                float nearestDepth = Math::Infinity;
                 std::vector<DrawData> drawDataList(materialMap.size());
                 std::vector<Math::Float4x4> instanceList(materialInstanceCount);
                 for (auto &levelPair : materialMap)
@@ -648,12 +669,20 @@ namespace Gek
                     if (level)
                     {
                         auto &levelInstanceList = levelPair.second;
+                        for (auto const &instance : levelInstanceList)
+                        {
+                            nearestDepth = std::min(nearestDepth, instance.translation.z);
+                        }
+
                         drawDataList.push_back(DrawData(instanceList.size(), levelInstanceList.size(), level));
                         instanceList.insert(std::end(instanceList), std::begin(levelInstanceList), std::end(levelInstanceList));
                         levelInstanceList.clear();
                     }
                 }
 
+                // Materials blocking a visible draw load before everything else, closest first
+                resources->prioritize(material, Plugin::Resources::Priority::Visible + (1.0f / (1.0f + std::max(nearestDepth, 0.0f))));
+
                 InterlockedExchange(&maximumInstanceCount, std::max(maximumInstanceCount, instanceList.size()));
                 renderer->queueDrawCall(visual, material, std::move([this, drawDataList = move(drawDataList), instanceList = move(instanceList)](Video::Device::Context *videoContext) -> void
                 {
@@ -0,0 +1,118 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include "GEK/Utility/Allocator.hpp"
+#include "GEK/Shapes/AlignedBox.hpp"
+#include <xmmintrin.h>
+#include <cstdint>
+#include <vector>
+
+namespace Gek
+{
+    namespace Particles
+    {
+        // Every particle in the world lives in one pool, with each attribute in its own aligned stream
+        //  - emitters own a range of the pool, their live particles are kept packed at the start of it
+        //  - ranges start on a multiple of four and are padded to one, so kernels never need a scalar tail
+        //  - the first UploadStreamCount streams are exactly what the sprite shader reads
+        //  - Life only drives the sprite animation, particles are removed once they reach KillAge
+        class Pool
+        {
+        public:
+            enum Stream : uint8_t
+            {
+                PositionX = 0,
+                PositionY,
+                PositionZ,
+                Angle,
+                HalfSize,
+                Age,
+                Life,
+                Frames,
+                VelocityX,
+                VelocityY,
+                VelocityZ,
+                Torque,
+                AccelerationY,
+                Growth,
+                SizeLimit,
+                KillAge,
+                Count,
+            };
+
+            static constexpr uint32_t UploadStreamCount = (Stream::Frames + 1);
+
+            struct Range
+            {
+                uint32_t first = 0;
+                uint32_t capacity = 0;
+                uint32_t liveCount = 0;
+            };
+
+            using StreamData = std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Particles>>;
+
+        private:
+            uint32_t capacity = 0;
+            uint32_t usedCount = 0;
+            StreamData streamList[Stream::Count];
+
+        public:
+            Pool(uint32_t capacity);
+
+            uint32_t getCapacity(void) const
+            {
+                return capacity;
+            }
+
+            // End of the last allocated range, everything past it is unused
+            uint32_t getUsedCount(void) const
+            {
+                return usedCount;
+            }
+
+            float *getStream(Stream stream)
+            {
+                return streamList[stream].data();
+            }
+
+            float const *getStream(Stream stream) const
+            {
+                return streamList[stream].data();
+            }
+
+            // Returns false if the pool doesn't have room for the range
+            bool allocate(Range &range, uint32_t count);
+
+            // Drops every range, without releasing the stream memory
+            void clear(void);
+
+            // Moves the listed ranges down to close the gaps left by ranges that are no longer used,
+            // the list must be in the order the ranges were allocated
+            void compact(std::vector<Range *> const &rangeList);
+
+            // Adds up to count particles to the end of the range's live particles, and returns the
+            // pool index of the first one, the caller fills in their streams
+            uint32_t spawn(Range &range, uint32_t &count);
+
+            // Advances every live particle in the range, four at a time
+            void integrate(Range const &range, float frameTime);
+
+            // Removes particles that have reached their kill age, keeping the survivors packed
+            void kill(Range &range);
+
+            // Box around the live particles in the range, grown by the largest sprite half size,
+            // returns false if the range has no live particles
+            bool getBoundingBox(Range const &range, Shapes::AlignedBox &boundingBox) const;
+
+            // Copies the used part of each upload stream to its own section of the buffer,
+            // each stream section holds bufferCapacity elements
+            void copyTo(float *buffer, uint32_t bufferCapacity) const;
+        };
+    }; // namespace Particles
+}; // namespace Gek
@@ -0,0 +1,222 @@
+#include "GEK/Particles/Pool.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace Gek
+{
+    namespace Particles
+    {
+        Pool::Pool(uint32_t capacity)
+            : capacity(capacity & ~3U)
+        {
+        }
+
+        bool Pool::allocate(Range &range, uint32_t count)
+        {
+            count = ((count + 3) & ~3U);
+            if (count == 0 || (usedCount + count) > capacity)
+            {
+                return false;
+            }
+
+            range.first = usedCount;
+            range.capacity = count;
+            range.liveCount = 0;
+            usedCount += count;
+
+            // Grow geometrically so a burst of new emitters doesn't reallocate every stream each time
+            if (usedCount > streamList[0].size())
+            {
+                auto streamSize = std::min(capacity, std::max(usedCount, uint32_t(streamList[0].size() * 2)));
+                for (auto &stream : streamList)
+                {
+                    stream.resize(streamSize, 0.0f);
+                }
+            }
+
+            return true;
+        }
+
+        void Pool::clear(void)
+        {
+            usedCount = 0;
+        }
+
+        void Pool::compact(std::vector<Range *> const &rangeList)
+        {
+            uint32_t cursor = 0;
+            for (auto range : rangeList)
+            {
+                if (range->first != cursor)
+                {
+                    for (auto &stream : streamList)
+                    {
+                        std::memmove(&stream[cursor], &stream[range->first], (sizeof(float) * range->liveCount));
+                    }
+
+                    range->first = cursor;
+                }
+
+                cursor += range->capacity;
+            }
+
+            usedCount = cursor;
+        }
+
+        uint32_t Pool::spawn(Range &range, uint32_t &count)
+        {
+            count = std::min(count, (range.capacity - range.liveCount));
+            auto first = (range.first + range.liveCount);
+            range.liveCount += count;
+            return first;
+        }
+
+        void Pool::integrate(Range const &range, float frameTime)
+        {
+            auto positionX = getStream(Stream::PositionX);
+            auto positionY = getStream(Stream::PositionY);
+            auto positionZ = getStream(Stream::PositionZ);
+            auto angle = getStream(Stream::Angle);
+            auto halfSize = getStream(Stream::HalfSize);
+            auto age = getStream(Stream::Age);
+            auto velocityX = getStream(Stream::VelocityX);
+            auto velocityY = getStream(Stream::VelocityY);
+            auto velocityZ = getStream(Stream::VelocityZ);
+            auto torque = getStream(Stream::Torque);
+            auto accelerationY = getStream(Stream::AccelerationY);
+            auto growth = getStream(Stream::Growth);
+            auto sizeLimit = getStream(Stream::SizeLimit);
+
+            __m128 time = _mm_set_ps1(frameTime);
+            auto end = (range.first + ((range.liveCount + 3) & ~3U));
+            for (auto index = range.first; index < end; index += 4)
+            {
+                __m128 currentVelocityX = _mm_load_ps(&velocityX[index]);
+                __m128 currentVelocityY = _mm_add_ps(_mm_load_ps(&velocityY[index]), _mm_mul_ps(_mm_load_ps(&accelerationY[index]), time));
+                __m128 currentVelocityZ = _mm_load_ps(&velocityZ[index]);
+                _mm_store_ps(&velocityY[index], currentVelocityY);
+
+                _mm_store_ps(&positionX[index], _mm_add_ps(_mm_load_ps(&positionX[index]), _mm_mul_ps(currentVelocityX, time)));
+                _mm_store_ps(&positionY[index], _mm_add_ps(_mm_load_ps(&positionY[index]), _mm_mul_ps(currentVelocityY, time)));
+                _mm_store_ps(&positionZ[index], _mm_add_ps(_mm_load_ps(&positionZ[index]), _mm_mul_ps(currentVelocityZ, time)));
+                _mm_store_ps(&angle[index], _mm_add_ps(_mm_load_ps(&angle[index]), _mm_mul_ps(_mm_load_ps(&torque[index]), time)));
+                _mm_store_ps(&halfSize[index], _mm_min_ps(_mm_add_ps(_mm_load_ps(&halfSize[index]), _mm_mul_ps(_mm_load_ps(&growth[index]), time)), _mm_load_ps(&sizeLimit[index])));
+                _mm_store_ps(&age[index], _mm_add_ps(_mm_load_ps(&age[index]), time));
+            }
+        }
+
+        void Pool::kill(Range &range)
+        {
+            auto age = getStream(Stream::Age);
+            auto killAge = getStream(Stream::KillAge);
+            for (uint32_t offset = 0; offset < range.liveCount; offset += 4)
+            {
+                auto index = (range.first + offset);
+                if (_mm_movemask_ps(_mm_cmplt_ps(_mm_load_ps(&age[index]), _mm_load_ps(&killAge[index]))) == 0xF)
+                {
+                    continue;
+                }
+
+                // Replace each expired particle with the last live one, then test the same slot again
+                for (uint32_t lane = 0; lane < 4; )
+                {
+                    auto particle = (index + lane);
+                    if (particle >= (range.first + range.liveCount))
+                    {
+                        break;
+                    }
+
+                    if (age[particle] < killAge[particle])
+                    {
+                        ++lane;
+                        continue;
+                    }
+
+                    auto last = (range.first + --range.liveCount);
+                    for (auto &stream : streamList)
+                    {
+                        stream[particle] = stream[last];
+                    }
+                }
+            }
+        }
+
+        bool Pool::getBoundingBox(Range const &range, Shapes::AlignedBox &boundingBox) const
+        {
+            if (range.liveCount == 0)
+            {
+                return false;
+            }
+
+            auto positionX = getStream(Stream::PositionX);
+            auto positionY = getStream(Stream::PositionY);
+            auto positionZ = getStream(Stream::PositionZ);
+            auto halfSize = getStream(Stream::HalfSize);
+
+            // Padding lanes hold stale particles, so only whole groups of live particles go through SSE
+            __m128 minimumX = _mm_set_ps1(positionX[range.first]);
+            __m128 minimumY = _mm_set_ps1(positionY[range.first]);
+            __m128 minimumZ = _mm_set_ps1(positionZ[range.first]);
+            __m128 maximumX = minimumX;
+            __m128 maximumY = minimumY;
+            __m128 maximumZ = minimumZ;
+            __m128 maximumSize = _mm_setzero_ps();
+            auto vectorEnd = (range.first + (range.liveCount & ~3U));
+            for (auto index = range.first; index < vectorEnd; index += 4)
+            {
+                __m128 x = _mm_load_ps(&positionX[index]);
+                __m128 y = _mm_load_ps(&positionY[index]);
+                __m128 z = _mm_load_ps(&positionZ[index]);
+                minimumX = _mm_min_ps(minimumX, x);
+                minimumY = _mm_min_ps(minimumY, y);
+                minimumZ = _mm_min_ps(minimumZ, z);
+                maximumX = _mm_max_ps(maximumX, x);
+                maximumY = _mm_max_ps(maximumY, y);
+                maximumZ = _mm_max_ps(maximumZ, z);
+                maximumSize = _mm_max_ps(maximumSize, _mm_load_ps(&halfSize[index]));
+            }
+
+            auto end = (range.first + range.liveCount);
+            for (auto index = vectorEnd; index < end; ++index)
+            {
+                minimumX = _mm_min_ss(minimumX, _mm_set_ss(positionX[index]));
+                minimumY = _mm_min_ss(minimumY, _mm_set_ss(positionY[index]));
+                minimumZ = _mm_min_ss(minimumZ, _mm_set_ss(positionZ[index]));
+                maximumX = _mm_max_ss(maximumX, _mm_set_ss(positionX[index]));
+                maximumY = _mm_max_ss(maximumY, _mm_set_ss(positionY[index]));
+                maximumZ = _mm_max_ss(maximumZ, _mm_set_ss(positionZ[index]));
+                maximumSize = _mm_max_ss(maximumSize, _mm_set_ss(halfSize[index]));
+            }
+
+            alignas(16) float lanes[7][4];
+            _mm_store_ps(lanes[0], minimumX);
+            _mm_store_ps(lanes[1], minimumY);
+            _mm_store_ps(lanes[2], minimumZ);
+            _mm_store_ps(lanes[3], maximumX);
+            _mm_store_ps(lanes[4], maximumY);
+            _mm_store_ps(lanes[5], maximumZ);
+            _mm_store_ps(lanes[6], maximumSize);
+
+            float reduced[7];
+            for (uint32_t element = 0; element < 7; ++element)
+            {
+                auto &lane = lanes[element];
+                reduced[element] = (element < 3 ? std::min(std::min(lane[0], lane[1]), std::min(lane[2], lane[3])) : std::max(std::max(lane[0], lane[1]), std::max(lane[2], lane[3])));
+            }
+
+            auto size = reduced[6];
+            boundingBox.minimum.set(reduced[0] - size, reduced[1] - size, reduced[2] - size);
+            boundingBox.maximum.set(reduced[3] + size, reduced[4] + size, reduced[5] + size);
+            return true;
+        }
+
+        void Pool::copyTo(float *buffer, uint32_t bufferCapacity) const
+        {
+            auto count = std::min(usedCount, bufferCapacity);
+            for (uint32_t stream = 0; stream < UploadStreamCount; ++stream)
+            {
+                std::memcpy(&buffer[stream * bufferCapacity], streamList[stream].data(), (sizeof(float) * count));
+            }
+        }
+    }; // namespace Particles
+}; // namespace Gek
@@ -1,10 +1,14 @@
-﻿#include "GEK/Math/Float4x4.hpp"
+﻿#include "GEK/Math/Common.hpp"
+#include "GEK/Math/Matrix4x4.hpp"
+#include "GEK/Math/SIMD.hpp"
 #include "GEK/Shapes/AlignedBox.hpp"
-#include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/String.hpp"
-#include "GEK/Utility/XML.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/Identifier.hpp"
 #include "GEK/Utility/Allocator.hpp"
 #include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/System/VideoDevice.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Processor.hpp"
@@ -13,10 +17,11 @@
 #include "GEK/Engine/Entity.hpp"
 #include "GEK/Engine/Renderer.hpp"
 #include "GEK/Engine/Resources.hpp"
+#include "GEK/Engine/Editor.hpp"
 #include "GEK/Components/Transform.hpp"
-#include "GEK/Components/Color.hpp"
-#include <concurrent_unordered_map.h>
-#include <functional>
+#include "GEK/Particles/Pool.hpp"
+#include <algorithm>
+#include <limits>
 #include <random>
 #include <ppl.h>
 
@@ -26,44 +31,48 @@ namespace Gek
     {
         GEK_COMPONENT(Explosion)
         {
-            float strength;
-
-            void save(Xml::Leaf &componentData) const
-            {
-                componentData.attributes[L"strength"] = strength;
-            }
-
-            void load(const Xml::Leaf &componentData)
-            {
-                strength = loadAttribute(componentData, L"strength", 10.0f);
-            }
+            float strength = 10.0f;
         };
     }; // namespace Components
 
     namespace Sprites
     {
-        GEK_CONTEXT_USER(Explosion)
+        GEK_CONTEXT_USER(Explosion, Plugin::Population *)
             , public Plugin::ComponentMixin<Components::Explosion, Edit::Component>
         {
         public:
-            Explosion(Context *context)
+            Explosion(Context *context, Plugin::Population *population)
                 : ContextRegistration(context)
+                , ComponentMixin(population)
             {
             }
 
-            // Edit::Component
-            void show(ImGuiContext *guiContext, Plugin::Component::Data *data)
+            // Plugin::Component
+            void save(Components::Explosion const * const data, JSON::Object &componentData) const
             {
+                componentData.set("strength", data->strength);
             }
 
-            void edit(ImGuiContext *guiContext, const Math::Float4x4 &viewMatrix, const Math::Float4x4 &projectionMatrix, Plugin::Component::Data *data)
+            void load(Components::Explosion * const data, JSON::View componentData)
             {
+                data->strength = parse(componentData.get("strength"), 10.0f);
             }
 
-            // Plugin::Component
-            const wchar_t * const getName(void) const
+            // Edit::Component
+            bool onUserInterface(ImGuiContext * const guiContext, Plugin::Entity * const entity, Plugin::Component::Data *data)
             {
-                return L"explosion";
+                bool changed = false;
+                ImGui::SetCurrentContext(guiContext);
+
+                auto &explosionComponent = *dynamic_cast<Components::Explosion *>(data);
+
+                changed |= editorElement("Strength", [&](void) -> bool
+                {
+                    return ImGui::InputFloat("##strength", &explosionComponent.strength, 1.0f, 10.0f, 3, ImGuiInputTextFlags_CharsDecimal | ImGuiInputTextFlags_CharsNoBlank);
+                });
+
+                ImGui::SetCurrentContext(nullptr);
+                return changed;
             }
         };
 
@@ -72,339 +81,518 @@ namespace Gek
         {
         public:
             static const uint32_t SpritesBufferCount = 1000000;
-            static std::random_device randomDevice;
-            static std::mt19937 mersineTwister;
+            static const Math::Float3 Gravity;
 
-            struct Sprite
+            // Particles are simulated at a tenth of real time, detail intervals are still measured in real time
+            static const float TimeScale;
+
+            // Level of detail, picked each update from how large the emitter appeared to the cameras last frame
+            enum class Detail : uint8_t
             {
-                Math::Float3 position;
-                Math::Float3 velocity;
-                float angle;
-                float torque;
-                float halfSize;
-                float age;
-                float life;
-                uint32_t frames;
+                Full = 0,
+                Reduced,
+                Minimal,
+                Frozen,
+                Count,
+            };
+
+            struct DetailLevel
+            {
+                // Smallest projected radius, as a fraction of half the screen height, that selects this level
+                float screenSize;
+
+                // Seconds of accumulated time between simulation steps
+                float interval;
+
+                // Fraction of the emitter's range that can be alive at once
+                float budget;
             };
 
-            struct EmitterData
+            static const DetailLevel DetailLevelList[uint8_t(Detail::Count)];
+
+            // Emitters that haven't spawned yet have no extent, but still need to register as visible
+            static const float MinimumRadius;
+
+            struct Emitter
             {
+                enum class Type : uint8_t
+                {
+                    Smoke = 0,
+                    Spark,
+                };
+
+                Plugin::Entity *entity = nullptr;
+                Type type = Type::Smoke;
+                MaterialHandle material;
+                Particles::Pool::Range range;
+                Shapes::AlignedBox boundingBox;
+                std::mt19937 random;
+
                 Math::Float3 position;
                 Math::Float3 velocity;
+                float accelerationY = 0.0f;
 
-                MaterialHandle material;
-                std::vector<Sprite> spritesList;
+                // Particles left to emit, smoke puffs once while sparks trail until the emitter is destroyed
+                uint32_t spawnRemaining = 0;
 
-                uint32_t tail;
-                std::function<void(const Plugin::Entity *, EmitterData &, float)> update;
+                Detail detail = Detail::Full;
+                float accumulatedTime = 0.0f;
 
-                EmitterData(void)
-                    : tail(0)
-                {
-                }
+                // Largest projected radius across the cameras drawn since the last update, zero if no camera saw it
+                float screenSize = 0.0f;
             };
 
         private:
-            Plugin::Population *population;
-            Plugin::Resources *resources;
-            Plugin::Renderer *renderer;
+            Plugin::Core *core = nullptr;
+            Video::Device *videoDevice = nullptr;
+            Plugin::Population *population = nullptr;
+            Plugin::Resources *resources = nullptr;
+            Plugin::Renderer *renderer = nullptr;
 
             VisualHandle visual;
+            MaterialHandle smokeMaterial;
+            MaterialHandle sparkMaterial;
             Video::BufferPtr spritesBuffer;
+            bool uploadPending = false;
 
-            using EntityEmitterMap = std::unordered_map<Plugin::Entity *, std::vector<EmitterData>>;
-            EntityEmitterMap entityEmitterMap;
+            // Emitters are kept in the order their ranges were allocated, so the pool can compact them in place
+            Particles::Pool pool;
+            std::vector<Emitter> emitterList;
 
-            using VisibleMap = concurrency::concurrent_unordered_multimap<MaterialHandle, const EmitterData *>;
-            VisibleMap visibleMap;
+            std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Particles>> centerXList;
+            std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Particles>> centerYList;
+            std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Particles>> centerZList;
+            std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Particles>> radiusList;
+            std::vector<bool> visibilityList;
+            std::vector<std::pair<MaterialHandle, uint32_t>> visibleList;
 
         public:
             EmitterProcessor(Context *context, Plugin::Core *core)
                 : ContextRegistration(context)
+                , core(core)
+                , videoDevice(core->getVideoDevice())
                 , population(core->getPopulation())
                 , resources(core->getResources())
                 , renderer(core->getRenderer())
+                , pool(SpritesBufferCount)
             {
-                GEK_REQUIRE(population);
-                GEK_REQUIRE(resources);
-                GEK_REQUIRE(renderer);
-
-                population->onLoadBegin.connect<EmitterProcessor, &EmitterProcessor::onLoadBegin>(this);
-                population->onLoadSucceeded.connect<EmitterProcessor, &EmitterProcessor::onLoadSucceeded>(this);
-                population->onEntityCreated.connect<EmitterProcessor, &EmitterProcessor::onEntityCreated>(this);
-                population->onEntityDestroyed.connect<EmitterProcessor, &EmitterProcessor::onEntityDestroyed>(this);
-                population->onUpdate[60].connect<EmitterProcessor, &EmitterProcessor::onUpdate>(this);
-                renderer->onRenderScene.connect<EmitterProcessor, &EmitterProcessor::onRenderScene>(this);
-
-                visual = resources->loadVisual(L"Sprites");
-                spritesBuffer = renderer->getVideoDevice()->createBuffer(sizeof(Sprite), SpritesBufferCount, Video::BufferType::Structured, Video::BufferFlags::Mappable | Video::BufferFlags::Resource, false);
+                assert(core);
+                assert(videoDevice);
+                assert(population);
+                assert(resources);
+                assert(renderer);
+
+                LockedWrite{ std::cout } << "Initializing sprite system";
+
+                core->onShutdown.connect(this, &EmitterProcessor::onShutdown);
+                population->onReset.connect(this, &EmitterProcessor::onReset);
+                population->onEntityCreated.connect(this, &EmitterProcessor::onEntityCreated);
+                population->onEntityDestroyed.connect(this, &EmitterProcessor::onEntityDestroyed);
+                population->onComponentAdded.connect(this, &EmitterProcessor::onComponentAdded);
+                population->onComponentRemoved.connect(this, &EmitterProcessor::onComponentRemoved);
+                population->onUpdate[60].connect(this, &EmitterProcessor::onUpdate);
+                renderer->onQueueDrawCalls.connect(this, &EmitterProcessor::onQueueDrawCalls);
+
+                visual = resources->loadVisual("Sprites", Plugin::Resources::Priority::Immediate);
+                smokeMaterial = resources->loadMaterial("Sprites/Smoke");
+                sparkMaterial = resources->loadMaterial("Sprites/Spark");
+
+                // Each upload stream of the pool gets its own section of the buffer, see Sprites/Basic.hlsl
+                Video::Buffer::Description spritesDescription;
+                spritesDescription.stride = sizeof(float);
+                spritesDescription.count = (SpritesBufferCount * Particles::Pool::UploadStreamCount);
+                spritesDescription.type = Video::Buffer::Type::Structured;
+                spritesDescription.flags = Video::Buffer::Flags::Mappable | Video::Buffer::Flags::Resource;
+                spritesBuffer = videoDevice->createBuffer(spritesDescription);
+                spritesBuffer->setName("sprites:pool");
             }
 
-            ~EmitterProcessor(void)
+            void addEmitter(Plugin::Entity * const entity, Emitter::Type type, float strength, Math::Float3 const &position, uint32_t seed)
             {
-                renderer->onRenderScene.disconnect<EmitterProcessor, &EmitterProcessor::onRenderScene>(this);
-                population->onUpdate[60].disconnect<EmitterProcessor, &EmitterProcessor::onUpdate>(this);
-                population->onEntityDestroyed.disconnect<EmitterProcessor, &EmitterProcessor::onEntityDestroyed>(this);
-                population->onEntityCreated.disconnect<EmitterProcessor, &EmitterProcessor::onEntityCreated>(this);
-                population->onLoadSucceeded.disconnect<EmitterProcessor, &EmitterProcessor::onLoadSucceeded>(this);
-                population->onLoadBegin.disconnect<EmitterProcessor, &EmitterProcessor::onLoadBegin>(this);
-            }
+                std::uniform_real_distribution<float> spawnTheta(0.0f, (Math::Pi * 2.0f));
+                std::uniform_real_distribution<float> spawnPhi(-1.0f, 1.0f);
+
+                Emitter emitter;
+                emitter.entity = entity;
+                emitter.type = type;
+                emitter.random.seed(seed);
+                emitter.position = position;
+                emitter.boundingBox = Shapes::AlignedBox(position, position);
+
+                float theta = spawnTheta(emitter.random);
+                float phi = std::acos(spawnPhi(emitter.random));
+                emitter.velocity.x = std::sin(phi) * std::sin(theta);
+                emitter.velocity.y = -std::sin(phi) * std::cos(theta);
+                emitter.velocity.z = std::cos(phi);
+
+                uint32_t particleCount = 0;
+                switch (type)
+                {
+                case Emitter::Type::Smoke:
+                    if (true)
+                    {
+                        std::uniform_real_distribution<float> spawnStrength(0.1f, 0.5f);
+                        emitter.velocity *= (spawnStrength(emitter.random) * strength);
+                        emitter.material = smokeMaterial;
+                        particleCount = emitter.spawnRemaining = 100;
+                    }
 
-            // Plugin::Population Slots
-            void onLoadBegin(const String &populationName)
-            {
-                entityEmitterMap.clear();
+                    break;
+
+                case Emitter::Type::Spark:
+                    if (true)
+                    {
+                        std::uniform_real_distribution<float> spawnStrength(0.5f, 1.0f);
+                        emitter.velocity *= (spawnStrength(emitter.random) * strength);
+                        emitter.accelerationY = Gravity.y;
+                        emitter.material = sparkMaterial;
+                        emitter.spawnRemaining = std::numeric_limits<uint32_t>::max();
+                        particleCount = 10;
+                    }
+
+                    break;
+                };
+
+                if (!pool.allocate(emitter.range, particleCount))
+                {
+                    LockedWrite{ std::cerr } << String::Format("Sprite pool full, unable to add %v particles", particleCount);
+                    return;
+                }
+
+                emitterList.push_back(std::move(emitter));
             }
 
-            void onLoadSucceeded(const String &populationName)
+            void addEntity(Plugin::Entity * const entity)
             {
-                population->listEntities<Components::Transform, Components::Explosion>([&](Plugin::Entity *entity, const wchar_t *, auto &transformComponent, auto &explosionComponent) -> void
+                if (entity->hasComponents<Components::Transform, Components::Explosion>())
                 {
-                    static const Math::Float3 gravity(0.0f, -32.174f, 0.0f);
-                    static const std::uniform_real_distribution<float> spawnTheta(0.0f, (Gek::Math::Pi * 2.0f));
-                    static const std::uniform_real_distribution<float> spawnPhi(-1.0f, 1.0f);
-                    static const std::uniform_real_distribution<float> spawnTorque(0.0f, (Gek::Math::Pi * 0.5f));
-
-                    auto smoke = [this, &transformComponent, &explosionComponent](const Plugin::Entity *entity, EmitterData &emitter) -> void
+                    auto existingSearch = std::find_if(std::begin(emitterList), std::end(emitterList), [entity](Emitter const &emitter) -> bool
                     {
-                        static const auto update = [](const Plugin::Entity *entity, EmitterData &emitter, float frameTime) -> void
-                        {
-                            static const auto update = [](const Plugin::Entity *entity, EmitterData &emitter, float frameTime) -> void
-                            {
-                                concurrency::parallel_for_each(emitter.spritesList.begin(), emitter.spritesList.end(), [&emitter, frameTime](Sprite &sprite) -> void
-                                {
-                                    sprite.age += frameTime;
-                                    sprite.halfSize = (Math::saturate(sprite.age / sprite.life) * 1.0f);
-                                    sprite.angle += (sprite.torque * frameTime);
-                                    sprite.position += (sprite.velocity * frameTime);
-                                    sprite.position -= (gravity * 0.1f * frameTime);
-                                });
-                            };
-
-                            emitter.position += (emitter.velocity * frameTime);
-                            if (emitter.tail < emitter.spritesList.size())
-                            {
-                                auto &sprite = emitter.spritesList[emitter.tail++];
-                                sprite.position = emitter.position;
-                                sprite.age = 0.0f;
-                                update(entity, emitter, frameTime);
-                            }
-                            else
-                            {
-                                emitter.update = update;
-                            }
-                        };
-
-                        static const std::uniform_real_distribution<float> spawnStrength(0.1f, 0.5f);
-
-                        emitter.update = update;
-                        emitter.material = resources->loadMaterial(L"Sprites\\Smoke");
-                        emitter.spritesList.resize(100);
-                        emitter.position = transformComponent.position;
-                        float theta = spawnTheta(mersineTwister);
-                        float phi = acos(spawnPhi(mersineTwister));
-                        emitter.velocity.x = std::sin(phi) * std::sin(theta);
-                        emitter.velocity.y = -std::sin(phi) * std::cos(theta);
-                        emitter.velocity.z = std::cos(phi);
-                        emitter.velocity *= (spawnStrength(mersineTwister) * explosionComponent.strength);
-                        concurrency::parallel_for_each(emitter.spritesList.begin(), emitter.spritesList.end(), [transformComponent](Sprite &sprite) -> void
-                        {
-                            static const std::uniform_real_distribution<float> spawnLife(1.0f, 2.0f);
-
-                            float theta = spawnTheta(mersineTwister);
-                            float phi = acos(spawnPhi(mersineTwister));
-                            sprite.velocity.x = std::sin(phi) * std::sin(theta);
-                            sprite.velocity.y = -std::sin(phi) * std::cos(theta);
-                            sprite.velocity.z = std::cos(phi);
-                            sprite.velocity *= 0.1f;
-                            sprite.angle = spawnTheta(mersineTwister);
-                            sprite.torque = spawnTorque(mersineTwister);
-                            sprite.life = spawnLife(mersineTwister);
-                            sprite.frames = 6;
-                        });
-                    };
-
-                    auto spark = [this, &transformComponent, &explosionComponent](const Plugin::Entity *entity, EmitterData &emitter) -> void
+                        return (emitter.entity == entity);
+                    });
+
+                    if (existingSearch != std::end(emitterList))
                     {
-                        static const auto update = [](const Plugin::Entity *entity, EmitterData &emitter, float frameTime) -> void
-                        {
-                            emitter.position += (emitter.velocity * frameTime);
-                            emitter.velocity += (gravity * frameTime);
-                            auto &sprite = emitter.spritesList[emitter.tail++];
-                            if (emitter.tail >= emitter.spritesList.size())
-                            {
-                                emitter.tail = 0;
-                            }
+                        return;
+                    }
 
-                            sprite.position = emitter.position;
-                            sprite.age = 0.0f;
+                    auto &transformComponent = entity->getComponent<Components::Transform>();
+                    auto &explosionComponent = entity->getComponent<Components::Explosion>();
 
-                            concurrency::parallel_for_each(emitter.spritesList.begin(), emitter.spritesList.end(), [&emitter, frameTime](Sprite &sprite) -> void
-                            {
-                                sprite.age += frameTime;
-                                sprite.angle += (sprite.torque * frameTime);
-                                sprite.position += (sprite.velocity * frameTime);
-                            });
-                        };
-
-                        static const std::uniform_real_distribution<float> spawnStrength(0.5f, 1.0f);
-
-                        emitter.update = update;
-                        emitter.material = resources->loadMaterial(L"Sprites\\Spark");
-                        emitter.spritesList.resize(10);
-                        emitter.position = transformComponent.position;
-                        float theta = spawnTheta(mersineTwister);
-                        float phi = acos(spawnPhi(mersineTwister));
-                        emitter.velocity.x = std::sin(phi) * std::sin(theta);
-                        emitter.velocity.y = -std::sin(phi) * std::cos(theta);
-                        emitter.velocity.z = std::cos(phi);
-                        emitter.velocity *= (spawnStrength(mersineTwister) * explosionComponent.strength);
-                        concurrency::parallel_for_each(emitter.spritesList.begin(), emitter.spritesList.end(), [transformComponent](Sprite &sprite) -> void
-                        {
-                            static const std::uniform_real_distribution<float> spawnLife(2.0f, 4.0f);
-
-                            float theta = spawnTheta(mersineTwister);
-                            float phi = acos(spawnPhi(mersineTwister));
-                            sprite.velocity.x = std::sin(phi) * std::sin(theta);
-                            sprite.velocity.y = -std::sin(phi) * std::cos(theta);
-                            sprite.velocity.z = std::cos(phi);
-                            sprite.velocity *= 0.1f;
-                            sprite.angle = spawnTheta(mersineTwister);
-                            sprite.torque = spawnTorque(mersineTwister);
-                            sprite.life = spawnLife(mersineTwister);
-                            sprite.halfSize = 0.025f;
-                            sprite.frames = 5;
-                        });
-                    };
-
-                    if (entity->hasComponent<Components::Explosion>())
+                    // Emitters draw from their own streams, seeded in creation order, so a deterministic
+                    // population spawns the same particles regardless of how the updates are scheduled
+                    static Identifier const ParticlesSeed("particles"_id);
+                    std::mt19937 seedGenerator(population->getRandomSeed(ParticlesSeed) + uint32_t(emitterList.size()));
+                    for (uint32_t index = 0; index < 20; ++index)
                     {
-                        auto &entityEmitterList = entityEmitterMap[entity];
-
-                        entityEmitterList.resize(30);
-                        for (uint32_t index = 0; index < 20; index++)
-                        {
-                            smoke(entity, entityEmitterList[index]);
-                        }
+                        addEmitter(entity, Emitter::Type::Smoke, explosionComponent.strength, transformComponent.getWorldPosition(), seedGenerator());
+                    }
 
-                        for (uint32_t index = 20; index < 30; index++)
-                        {
-                            spark(entity, entityEmitterList[index]);
-                        }
+                    for (uint32_t index = 0; index < 10; ++index)
+                    {
+                        addEmitter(entity, Emitter::Type::Spark, explosionComponent.strength, transformComponent.getWorldPosition(), seedGenerator());
                     }
+                }
+            }
+
+            void removeEntity(Plugin::Entity * const entity)
+            {
+                auto removeSearch = std::remove_if(std::begin(emitterList), std::end(emitterList), [entity](Emitter const &emitter) -> bool
+                {
+                    return (emitter.entity == entity);
                 });
+
+                if (removeSearch != std::end(emitterList))
+                {
+                    emitterList.erase(removeSearch, std::end(emitterList));
+
+                    std::vector<Particles::Pool::Range *> rangeList;
+                    rangeList.reserve(emitterList.size());
+                    for (auto &emitter : emitterList)
+                    {
+                        rangeList.push_back(&emitter.range);
+                    }
+
+                    pool.compact(rangeList);
+                }
             }
 
-            void onEntityCreated(Plugin::Entity *entity, const wchar_t *entityName)
+            // Emits new particles at the emitter, the kernels only ever touch the integration streams
+            // Sparks live for trailLength, so the emitter keeps a trail of its most recent particles
+            void spawnParticles(Emitter &emitter, uint32_t count, float trailLength)
             {
-                GEK_REQUIRE(resources);
-                GEK_REQUIRE(entity);
+                std::uniform_real_distribution<float> spawnTheta(0.0f, (Math::Pi * 2.0f));
+                std::uniform_real_distribution<float> spawnPhi(-1.0f, 1.0f);
+                std::uniform_real_distribution<float> spawnTorque(0.0f, (Math::Pi * 0.5f));
+                std::uniform_real_distribution<float> spawnSmokeLife(1.0f, 2.0f);
+
+                count = std::min(count, emitter.spawnRemaining);
+                auto first = pool.spawn(emitter.range, count);
+                emitter.spawnRemaining -= count;
+                for (auto index = first; index < (first + count); ++index)
+                {
+                    float theta = spawnTheta(emitter.random);
+                    float phi = std::acos(spawnPhi(emitter.random));
+                    pool.getStream(Particles::Pool::PositionX)[index] = emitter.position.x;
+                    pool.getStream(Particles::Pool::PositionY)[index] = emitter.position.y;
+                    pool.getStream(Particles::Pool::PositionZ)[index] = emitter.position.z;
+                    pool.getStream(Particles::Pool::VelocityX)[index] = (std::sin(phi) * std::sin(theta) * 0.1f);
+                    pool.getStream(Particles::Pool::VelocityY)[index] = (-std::sin(phi) * std::cos(theta) * 0.1f);
+                    pool.getStream(Particles::Pool::VelocityZ)[index] = (std::cos(phi) * 0.1f);
+                    pool.getStream(Particles::Pool::Angle)[index] = spawnTheta(emitter.random);
+                    pool.getStream(Particles::Pool::Torque)[index] = spawnTorque(emitter.random);
+                    pool.getStream(Particles::Pool::Age)[index] = 0.0f;
+                    pool.getStream(Particles::Pool::AccelerationY)[index] = 0.0f;
+                    if (emitter.type == Emitter::Type::Smoke)
+                    {
+                        // Smoke rises against gravity, grows to full size and animates over its life, then lingers until the emitter is removed
+                        float life = spawnSmokeLife(emitter.random);
+                        pool.getStream(Particles::Pool::VelocityY)[index] -= (Gravity.y * 0.1f);
+                        pool.getStream(Particles::Pool::Life)[index] = life;
+                        pool.getStream(Particles::Pool::KillAge)[index] = Math::Infinity;
+                        pool.getStream(Particles::Pool::HalfSize)[index] = 0.0f;
+                        pool.getStream(Particles::Pool::Growth)[index] = (1.0f / life);
+                        pool.getStream(Particles::Pool::SizeLimit)[index] = 1.0f;
+                        pool.getStream(Particles::Pool::Frames)[index] = 6.0f;
+                    }
+                    else
+                    {
+                        pool.getStream(Particles::Pool::Life)[index] = trailLength;
+                        pool.getStream(Particles::Pool::KillAge)[index] = trailLength;
+                        pool.getStream(Particles::Pool::HalfSize)[index] = 0.025f;
+                        pool.getStream(Particles::Pool::Growth)[index] = 0.0f;
+                        pool.getStream(Particles::Pool::SizeLimit)[index] = 0.025f;
+                        pool.getStream(Particles::Pool::Frames)[index] = 5.0f;
+                    }
+                }
+            }
 
-                if (entity->hasComponent<Components::Transform>())
+            static Detail getDetail(float screenSize)
+            {
+                for (uint8_t detail = 0; detail < uint8_t(Detail::Frozen); ++detail)
                 {
+                    if (screenSize > 0.0f && screenSize >= DetailLevelList[detail].screenSize)
+                    {
+                        return Detail(detail);
+                    }
                 }
+
+                return Detail::Frozen;
+            }
+
+            // Plugin::Core Slots
+            void onShutdown(void)
+            {
+                population->onReset.disconnect(this, &EmitterProcessor::onReset);
+                population->onEntityCreated.disconnect(this, &EmitterProcessor::onEntityCreated);
+                population->onEntityDestroyed.disconnect(this, &EmitterProcessor::onEntityDestroyed);
+                population->onComponentAdded.disconnect(this, &EmitterProcessor::onComponentAdded);
+                population->onComponentRemoved.disconnect(this, &EmitterProcessor::onComponentRemoved);
+                population->onUpdate[60].disconnect(this, &EmitterProcessor::onUpdate);
+                renderer->onQueueDrawCalls.disconnect(this, &EmitterProcessor::onQueueDrawCalls);
+            }
+
+            // Plugin::Population Slots
+            void onReset(void)
+            {
+                emitterList.clear();
+                pool.clear();
             }
 
-            void onEntityDestroyed(Plugin::Entity *entity)
+            void onEntityCreated(Plugin::Entity * const entity)
             {
-                GEK_REQUIRE(entity);
+                addEntity(entity);
+            }
 
-                auto entitySearch = entityEmitterMap.find(entity);
-                if (entitySearch != entityEmitterMap.end())
+            void onEntityDestroyed(Plugin::Entity * const entity)
+            {
+                removeEntity(entity);
+            }
+
+            void onComponentAdded(Plugin::Entity * const entity)
+            {
+                addEntity(entity);
+            }
+
+            void onComponentRemoved(Plugin::Entity * const entity)
+            {
+                if (!entity->hasComponents<Components::Transform, Components::Explosion>())
                 {
-                    entityEmitterMap.erase(entitySearch);
+                    removeEntity(entity);
                 }
             }
 
-            void onUpdate(void)
+            void onUpdate(float frameTime)
             {
-                GEK_REQUIRE(population);
+                GEK_PROFILE_ZONE("Sprite Update");
+                Memory::Scope memoryScope(Memory::Tag::Particles);
 
-                const float frameTime = population->getFrameTime() * 0.1f;
-                concurrency::parallel_for_each(entityEmitterMap.begin(), entityEmitterMap.end(), [&](auto &entityEmitterPair) -> void
+                assert(population);
+
+                bool editorActive = core->getOption("editor", "active").convert(false);
+                if (frameTime > 0.0f && !editorActive)
                 {
-                    const Plugin::Entity *entity = entityEmitterPair.first;
-                    concurrency::parallel_for_each(entityEmitterPair.second.begin(), entityEmitterPair.second.end(), [&](auto &emitter) -> void
+                    // Deterministic populations simulate everything at full detail, so the result doesn't depend on the camera
+                    bool deterministic = population->isDeterministic();
+
+                    // Ranges never overlap, so every emitter can run its kernels independently
+                    concurrency::parallel_for(size_t(0), emitterList.size(), [&](size_t emitterIndex) -> void
                     {
-                        emitter.update(entity, emitter, frameTime);
+                        auto &emitter = emitterList[emitterIndex];
+                        emitter.detail = (deterministic ? Detail::Full : getDetail(emitter.screenSize));
+                        emitter.screenSize = 0.0f;
+                        if (emitter.detail == Detail::Frozen)
+                        {
+                            return;
+                        }
+
+                        auto const &detailLevel = DetailLevelList[uint8_t(emitter.detail)];
+                        emitter.accumulatedTime += frameTime;
+                        if (emitter.accumulatedTime < detailLevel.interval)
+                        {
+                            return;
+                        }
+
+                        auto stepTime = (emitter.accumulatedTime * TimeScale);
+                        emitter.accumulatedTime = 0.0f;
+
+                        emitter.velocity.y += (emitter.accelerationY * stepTime);
+                        emitter.position += (emitter.velocity * stepTime);
+
+                        pool.integrate(emitter.range, stepTime);
+                        pool.kill(emitter.range);
+
+                        // One particle is spawned each step, so a trail as long as the budget in steps replaces its oldest particle every step
+                        auto budget = uint32_t(emitter.range.capacity * detailLevel.budget);
+                        if (emitter.range.liveCount < budget)
+                        {
+                            spawnParticles(emitter, 1, (stepTime * budget));
+                        }
+
+                        if (!pool.getBoundingBox(emitter.range, emitter.boundingBox))
+                        {
+                            emitter.boundingBox = Shapes::AlignedBox(emitter.position, emitter.position);
+                        }
                     });
-                });
+                }
             }
 
             // Plugin::Renderer Slots
-            static void drawCall(Video::Device *videoDevice, Video::Device::Context *videoContext, Plugin::Resources *resources, const VisibleMap::iterator visibleBegin, const VisibleMap::iterator visibleEnd, Video::Buffer *spritesBuffer)
+            void onQueueDrawCalls(const Shapes::Frustum &viewFrustum, Math::Float4x4 const &viewMatrix, Math::Float4x4 const &projectionMatrix)
             {
-                GEK_REQUIRE(videoContext);
-                GEK_REQUIRE(resources);
+                GEK_PROFILE_ZONE("Sprite Draw Calls");
+                Memory::Scope memoryScope(Memory::Tag::Particles);
+
+                assert(renderer);
+
+                // Cull the spheres around each emitter's bounding box, four emitters at a time, empty emitters
+                // are included so they can still be given a level of detail
+                const auto emitterCount = emitterList.size();
+                auto buffer = (emitterCount % 4);
+                buffer = (buffer ? (4 - buffer) : buffer);
+                const auto bufferedEmitterCount = (emitterCount + buffer);
+                centerXList.resize(bufferedEmitterCount);
+                centerYList.resize(bufferedEmitterCount);
+                centerZList.resize(bufferedEmitterCount);
+                radiusList.resize(bufferedEmitterCount);
+                for (size_t emitterIndex = 0; emitterIndex < emitterCount; ++emitterIndex)
+                {
+                    auto const &boundingBox = emitterList[emitterIndex].boundingBox;
+                    auto center(boundingBox.getCenter());
+                    centerXList[emitterIndex] = center.x;
+                    centerYList[emitterIndex] = center.y;
+                    centerZList[emitterIndex] = center.z;
+                    radiusList[emitterIndex] = std::max(boundingBox.getHalfSize().getLength(), MinimumRadius);
+                }
 
-                videoContext->vertexPipeline()->setResourceList({ spritesBuffer }, 0);
+                visibilityList.resize(bufferedEmitterCount);
+                auto frustum = Math::SIMD::loadFrustum((Math::Float4 *)viewFrustum.planeList);
+                Math::SIMD::cullSpheres(frustum, bufferedEmitterCount, centerXList, centerYList, centerZList, radiusList, visibilityList);
 
-                uint32_t bufferCopied = 0;
-                Sprite *bufferData = nullptr;
-                videoDevice->mapBuffer(spritesBuffer, bufferData);
-                for (auto emitterSearch = visibleBegin; emitterSearch != visibleEnd; ++emitterSearch)
+                visibleList.clear();
+                for (uint32_t emitterIndex = 0; emitterIndex < emitterCount; ++emitterIndex)
                 {
-                    auto const &emitter = *emitterSearch->second;
-
-                    uint32_t spritesCopied = 0;
-                    uint32_t spritesCount = emitter.spritesList.size();
-                    const Sprite *spriteData = emitter.spritesList.data();
-                    while (spritesCopied < spritesCount)
+                    if (visibilityList[emitterIndex])
                     {
-                        uint32_t bufferRemaining = (SpritesBufferCount - bufferCopied);
-                        uint32_t spritesRemaining = (spritesCount - spritesCopied);
-                        uint32_t copyCount = std::min(bufferRemaining, spritesRemaining);
-                        std::copy(&bufferData[bufferCopied], &bufferData[bufferCopied + copyCount], &spriteData[spritesCopied]);
-
-                        bufferCopied += copyCount;
-                        spritesCopied += copyCount;
-                        if (bufferCopied >= SpritesBufferCount)
+                        auto &emitter = emitterList[emitterIndex];
+
+                        // Projected radius relative to half the screen height, the camera being inside the sphere counts as full screen
+                        auto radius = radiusList[emitterIndex];
+                        auto depth = viewMatrix.transform(Math::Float3(centerXList[emitterIndex], centerYList[emitterIndex], centerZList[emitterIndex])).z;
+                        auto screenSize = (depth > radius ? ((radius * projectionMatrix._22) / depth) : 1.0f);
+                        emitter.screenSize = std::max(emitter.screenSize, screenSize);
+                        if (emitter.range.liveCount > 0)
                         {
-                            videoDevice->unmapBuffer(spritesBuffer);
-                            videoContext->drawPrimitive((SpritesBufferCount * 6), 0);
-                            videoDevice->mapBuffer(spritesBuffer, bufferData);
-                            bufferCopied = 0;
+                            visibleList.push_back(std::make_pair(emitter.material, emitterIndex));
                         }
-                    };
+                    }
                 }
 
-                videoDevice->unmapBuffer(spritesBuffer);
-                if (bufferCopied > 0)
+                if (visibleList.empty())
                 {
-                    videoContext->drawPrimitive((bufferCopied * 6), 0);
+                    return;
                 }
-            }
 
-            void onRenderScene(const Plugin::Entity *cameraEntity, const Math::Float4x4 &viewMatrix, const Shapes::Frustum &viewFrustum)
-            {
-                GEK_REQUIRE(renderer);
-                GEK_REQUIRE(cameraEntity);
+                std::sort(std::begin(visibleList), std::end(visibleList), [](auto const &leftPair, auto const &rightPair) -> bool
+                {
+                    return (std::size_t(leftPair.first) < std::size_t(rightPair.first));
+                });
 
-                visibleMap.clear();
-                concurrency::parallel_for_each(entityEmitterMap.begin(), entityEmitterMap.end(), [&](auto &entityEmitterPair) -> void
+                // The whole pool goes up in one copy, by whichever draw call the renderer executes first
+                uploadPending = true;
+                for (auto materialStart = std::begin(visibleList); materialStart != std::end(visibleList); )
                 {
-                    concurrency::parallel_for_each(entityEmitterPair.second.begin(), entityEmitterPair.second.end(), [&](auto &emitter) -> void
+                    auto material = materialStart->first;
+                    auto materialEnd = std::find_if(materialStart, std::end(visibleList), [material](auto const &visiblePair) -> bool
                     {
-                        //if (viewFrustum.isVisible(emitter.box))
+                        return (visiblePair.first != material);
+                    });
+
+                    std::vector<Particles::Pool::Range> rangeList;
+                    rangeList.reserve(std::distance(materialStart, materialEnd));
+                    for (auto visibleSearch = materialStart; visibleSearch != materialEnd; ++visibleSearch)
+                    {
+                        rangeList.push_back(emitterList[visibleSearch->second].range);
+                    }
+
+                    renderer->queueDrawCall(visual, material, std::move([this, rangeList = move(rangeList)](Video::Device::Context *videoContext) -> void
+                    {
+                        if (uploadPending)
+                        {
+                            float *bufferData = nullptr;
+                            if (videoDevice->mapBuffer(spritesBuffer.get(), bufferData))
+                            {
+                                pool.copyTo(bufferData, SpritesBufferCount);
+                                videoDevice->unmapBuffer(spritesBuffer.get());
+                            }
+
+                            uploadPending = false;
+                        }
+
+                        videoContext->vertexPipeline()->setResourceList({ spritesBuffer.get() }, 0);
+                        for (auto const &range : rangeList)
                         {
-                            visibleMap.insert(std::make_pair(emitter.material, &emitter));
+                            videoContext->drawPrimitive((range.liveCount * 6), (range.first * 6));
                         }
-                    });
-                });
+                    }));
 
-                for (auto propertiesSearch = visibleMap.begin(); propertiesSearch != visibleMap.end(); )
-                {
-                    const auto emittersRange = visibleMap.equal_range(propertiesSearch->first);
-                    renderer->queueDrawCall(visual, propertiesSearch->first, std::bind(drawCall, renderer->getVideoDevice(), std::placeholders::_1, resources, emittersRange.first, emittersRange.second, spritesBuffer.get()));
-                    propertiesSearch = emittersRange.second;
+                    materialStart = materialEnd;
                 }
             }
         };
 
-        std::random_device EmitterProcessor::randomDevice;
-        std::mt19937 EmitterProcessor::mersineTwister(randomDevice());
+        const Math::Float3 EmitterProcessor::Gravity(0.0f, -32.174f, 0.0f);
+        const float EmitterProcessor::TimeScale = 0.1f;
+        const float EmitterProcessor::MinimumRadius = 1.0f;
+        const EmitterProcessor::DetailLevel EmitterProcessor::DetailLevelList[uint8_t(EmitterProcessor::Detail::Count)] =
+        {
+            { 0.05f, 0.0f, 1.0f },
+            { 0.01f, (1.0f / 30.0f), 0.5f },
+            { 0.0f, (1.0f / 10.0f), 0.25f },
+            { 0.0f, Math::Infinity, 0.0f },
+        };
 
         GEK_REGISTER_CONTEXT_USER(Explosion)
         GEK_REGISTER_CONTEXT_USER(EmitterProcessor)
     }; // namespace Sprites
-}; // namespace Gek
\ No newline at end of file
+}; // namespace Gek
@@ -8,10 +8,13 @@
 #pragma once
 
 #include "GEK/Math/Vector3.hpp"
+#include "GEK/Math/Quaternion.hpp"
 #include "GEK/Engine/Component.hpp"
 #include "GEK/Engine/Entity.hpp"
 #include <wink/signal.hpp>
 #include <Newton.h>
+#include <future>
+#include <vector>
 
 namespace Gek
 {
@@ -48,13 +51,17 @@ namespace Gek
             virtual uint32_t getSurface(Math::Float3 const &position, Math::Float3 const &normal) = 0;
 
             // Called before the update phase to set the frame data for the body
-            // Applies to rigid and player bodies
+            // Applies to player bodies only
             virtual void onPreUpdate(float frameTime, int threadHandle) { };
 
             // Called after the update phase to react to changes in the world
             // Applies to player bodies only
             virtual void onPostUpdate(float frameTime, int threadHandle) { };
 
+            // Called by Newton for awake bodies only, to set the forces for the step
+            // Applies to rigid bodies only, their force is precomputed by the world
+            virtual void onApplyForce(int threadHandle) { };
+
             // Called when setting the transformation matrix of the body
             // Applies to rigid bodies only
             virtual void onSetTransform(const float* const matrixData, int threadHandle) { };
@@ -70,13 +77,65 @@ namespace Gek
                 float elasticity = 0.4f;
                 float softness = 1.0f;
             };
+
+            struct Query
+            {
+                enum class Type : uint8_t
+                {
+                    Ray = 0,
+                    Sphere,
+                    Convex,
+                };
+
+                Type type = Type::Ray;
+                Math::Float3 start = Math::Float3::Zero;
+                Math::Float3 end = Math::Float3::Zero;
+
+                // Sphere casts only
+                float radius = 0.0f;
+
+                // Convex casts only, the shape is swept from start to end with a fixed rotation
+                NewtonCollision const *shape = nullptr;
+                Math::Quaternion rotation = Math::Quaternion::Identity;
+
+                // Bodies belonging to this entity are skipped, so casts can start inside their owner
+                Plugin::Entity *ignoreEntity = nullptr;
+            };
+
+            struct Hit
+            {
+                bool valid = false;
+
+                // Null for the static scene and for bodies without an entity
+                Plugin::Entity *entity = nullptr;
+
+                // Fraction of the way from start to end that the hit occurred
+                float distance = 1.0f;
+                Math::Float3 position = Math::Float3::Zero;
+                Math::Float3 normal = Math::Float3::Zero;
+            };
+
+            using QueryList = std::vector<Query>;
+            using HitList = std::vector<Hit>;
             
             wink::signal<wink::slot<void(Plugin::Entity *entity0, Math::Float3 const &position, Math::Float3 const &normal, Plugin::Entity *entity1)>> onCollision;
 
             virtual ~World(void) = default;
 
+            // Gravity is uniform and set by the physics.gravity option, the position is ignored
             virtual Math::Float3 getGravity(Math::Float3 const &position) = 0;
 
+            // Rigid bodies copy their simulated matrix in to a staging list by body slot, the world
+            // converts and interpolates them in a single pass once the update has finished
+            virtual void setBodyMatrix(uint32_t slot, float const * const matrixData) = 0;
+
+            // Force Newton should apply to the rigid body in the slot, its mass times the world gravity
+            virtual Math::Float3 getBodyForce(uint32_t slot) const = 0;
+
+            // Queries are batched and resolved in parallel once the next update's step has finished,
+            // the returned future holds one hit per query in the order they were submitted
+            virtual std::future<HitList> castQueries(QueryList &&queryList) = 0;
+
             virtual uint32_t loadSurface(std::string const &surfaceName) = 0;
             virtual const Surface &getSurface(uint32_t surfaceIndex) const = 0;
         };
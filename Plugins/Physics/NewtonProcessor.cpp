@@ -6,6 +6,10 @@
 #include "GEK/Utility/String.hpp"
 #include "GEK/Utility/Hash.hpp"
 #include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/Identifier.hpp"
+#include "GEK/Utility/ThreadPool.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
 #include "GEK/Engine/Core.hpp"
 #include "GEK/Engine/Processor.hpp"
 #include "GEK/Engine/Population.hpp"
@@ -17,6 +21,12 @@
 #include "GEK/Model/Base.hpp"
 #include <concurrent_unordered_map.h>
 #include <concurrent_vector.h>
+#include <concurrent_queue.h>
+#include <unordered_set>
+#include <algorithm>
+#include <future>
+#include <ppl.h>
+#include <xmmintrin.h>
 
 #include <Newton.h>
 
@@ -25,7 +35,7 @@ namespace Gek
     namespace Newton
     {
         extern EntityPtr createPlayerBody(Plugin::Core *core, Plugin::Population *population, NewtonWorld *newtonWorld, Plugin::Entity * const entity);
-        extern EntityPtr createRigidBody(NewtonWorld *newton, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity);
+        extern EntityPtr createRigidBody(NewtonWorld *newton, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity, uint32_t stateSlot);
 
         GEK_CONTEXT_USER(Processor, Plugin::Core *)
             , public Plugin::Processor
@@ -71,6 +81,92 @@ namespace Gek
                 uint32_t indexCount;
             };
 
+            // Simulated rigid body state from the last two fixed steps, as parallel lists indexed by body slot
+            //  - currentMatrixList is the staging list Newton's transform callbacks copy in to
+            //  - commitCountList counts down the stepped frames a body still needs its transform written
+            //  - the force lists hold each body's mass times the world gravity, Newton's force callback reads them
+            //    for the bodies it has awake, so resting bodies cost nothing per step
+            struct BodyStateList
+            {
+                std::vector<float> massList;
+                std::vector<float> forceXList;
+                std::vector<float> forceYList;
+                std::vector<float> forceZList;
+                std::vector<Components::Transform *> transformList;
+                std::vector<Math::Float4x4> previousMatrixList;
+                std::vector<Math::Float4x4> currentMatrixList;
+                std::vector<uint8_t> commitCountList;
+                std::vector<uint32_t> freeSlotList;
+
+                void clear(void)
+                {
+                    massList.clear();
+                    forceXList.clear();
+                    forceYList.clear();
+                    forceZList.clear();
+                    transformList.clear();
+                    previousMatrixList.clear();
+                    currentMatrixList.clear();
+                    commitCountList.clear();
+                    freeSlotList.clear();
+                }
+            };
+
+            struct CollisionData
+            {
+                Identifier identifier;
+                std::string name;
+                FileSystem::MappedFile mappedFile;
+                std::vector<uint8_t> packedFile;
+                uint64_t contentHash = 0;
+                bool valid = false;
+
+                // Loose files are mapped, files inside a mounted archive are loaded whole
+                uint8_t const *getData(void) const
+                {
+                    return (mappedFile ? mappedFile.getData() : packedFile.data());
+                }
+
+                size_t getSize(void) const
+                {
+                    return (mappedFile ? mappedFile.getSize() : packedFile.size());
+                }
+            };
+
+            struct Collision
+            {
+                NewtonCollision *newtonCollision = nullptr;
+                bool loading = false;
+            };
+
+            // Queries from one castQueries call, resolved together and handed back through the promise
+            struct QueryBatch
+            {
+                QueryList queryList;
+                HitList hitList;
+                std::vector<NewtonBody const *> ignoreBodyList;
+                std::vector<NewtonCollision const *> shapeList;
+                std::promise<HitList> promise;
+            };
+
+            struct QueryJob
+            {
+                Processor *processor;
+                QueryBatch *queryBatch;
+                std::size_t first;
+                std::size_t last;
+            };
+
+            struct CastData
+            {
+                NewtonBody const *ignoreBody;
+                Hit *hit;
+            };
+
+            static constexpr float StepTime = (1.0f / 120.0f);
+            static const Math::Float3 DefaultGravity;
+            static constexpr std::size_t QueriesPerJob = 64;
+
         private:
             Plugin::Core *core = nullptr;
             Plugin::Population *population = nullptr;
@@ -85,13 +181,33 @@ namespace Gek
 
             concurrency::concurrent_vector<Surface> surfaceList;
             concurrency::concurrent_unordered_map<std::size_t, uint32_t> surfaceIndexMap;
-            concurrency::concurrent_unordered_map<std::size_t, NewtonCollision *> collisionMap;
+            concurrency::critical_section criticalSection;
+            ThreadPool loadPool;
+            NewtonCollision *placeholderCollision = nullptr;
+            concurrency::concurrent_unordered_map<Identifier, Collision> collisionMap;
+            concurrency::concurrent_unordered_map<uint64_t, NewtonCollision *> contentCollisionMap;
+            concurrency::concurrent_queue<std::shared_ptr<CollisionData>> loadedCollisionQueue;
+            std::unordered_map<Plugin::Entity *, Identifier> pendingEntityMap;
             concurrency::concurrent_unordered_map<Plugin::Entity *, Newton::EntityPtr> entityMap;
 
             using SurfaceMap = std::unordered_map<uint32_t, uint32_t>;
             concurrency::concurrent_unordered_map<NewtonCollision *, SurfaceMap> sceneSurfaceMap;
             concurrency::concurrent_unordered_map<Plugin::Entity *, void *> sceneMap;
 
+            // Scene collision changes are queued and committed in one add/remove block per update
+            std::vector<std::pair<Plugin::Entity *, NewtonCollision *>> sceneAddList;
+            std::vector<void *> sceneRemoveList;
+            std::unordered_set<Plugin::Entity *> sceneMoveSet;
+
+            BodyStateList bodyStateList;
+            bool bodyForcesChanged = false;
+            concurrency::concurrent_unordered_map<Plugin::Entity *, uint32_t> bodySlotMap;
+            std::vector<Newton::Entity *> playerBodyList;
+            Math::Float3 gravity = DefaultGravity;
+            float accumulatedTime = 0.0f;
+
+            concurrency::concurrent_queue<std::shared_ptr<QueryBatch>> queryBatchQueue;
+            std::unordered_map<uint32_t, NewtonCollision *> sphereCollisionMap;
 
         public:
             Processor(Context *context, Plugin::Core *core)
@@ -100,10 +216,14 @@ namespace Gek
                 , population(core->getPopulation())
                 , renderer(core->getRenderer())
                 , newtonWorld(NewtonCreate())
+                , loadPool(1)
             {
                 assert(core);
                 assert(newtonWorld);
 
+                placeholderCollision = NewtonCreateNull(newtonWorld);
+                gravity = core->getOption("physics", "gravity").convert(DefaultGravity);
+
                 NewtonSetSolverModel(newtonWorld, 4);
                 NewtonWorldSetUserData(newtonWorld, static_cast<Newton::World *>(this));
 
@@ -127,116 +247,323 @@ namespace Gek
                 renderer->onShowUserInterface.connect(this, &Processor::onShowUserInterface);
             }
 
-            NewtonCollision *loadCollision(const Components::Model &modelComponent)
+            static uint64_t GetContentHash(uint8_t const *data, std::size_t size)
             {
-                NewtonCollision *newtonCollision = nullptr;
+                uint64_t hash = 14695981039346656037ULL;
+                for (auto end = (data + size); data != end; ++data)
+                {
+                    hash ^= (*data);
+                    hash *= 1099511628211ULL;
+                }
 
-                auto hash = GetHash(String::Format("model:%v", modelComponent.name));
-                auto collisionSearch = collisionMap.find(hash);
-                if (collisionSearch != std::end(collisionMap))
+                return hash;
+            }
+
+            // Runs on the load thread, only reads and validates the file
+            std::shared_ptr<CollisionData> readCollision(Identifier identifier, std::string const &name)
+            {
+                auto collisionData = std::make_shared<CollisionData>();
+                collisionData->identifier = identifier;
+                collisionData->name = name;
+
+                auto filePath = getContext()->getRootFileName("data", "physics", name).withExtension(".gek");
+                if (FileSystem::IsPackedFile(filePath))
                 {
-                    if (collisionSearch->second)
-                    {
-                        newtonCollision = collisionSearch->second;
-                    }
+                    collisionData->packedFile = FileSystem::Load(filePath, std::vector<uint8_t>());
                 }
                 else
                 {
-                    collisionMap[hash] = nullptr;
+                    collisionData->mappedFile = FileSystem::MappedFile(filePath);
+                }
+
+                if (collisionData->getSize() < sizeof(Header))
+                {
+                    LockedWrite{ std::cerr } << String::Format("File too small to be collision model: %v", name);
+                    return collisionData;
+                }
+
+                Header const *header = (Header const *)collisionData->getData();
+                if (header->identifier != *(uint32_t *)"GEKX")
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unknown model file identifier encountered: %v", name);
+                    return collisionData;
+                }
+
+                if (header->version != 2)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unsupported model version encountered (requires: 2, has: %v): %v", header->version, name);
+                    return collisionData;
+                }
 
-                    LockedWrite{ std::cout } << String::Format("Loading collision model: %v", modelComponent.name);
+                if (header->newtonVersion != NewtonWorldGetVersion())
+                {
+                    LockedWrite{ std::cerr } << String::Format("Model created with different version of Newton Dynamics (requires: %v, has: %v): %v", NewtonWorldGetVersion(), header->newtonVersion, name);
+                    return collisionData;
+                }
+
+                if (header->type != 1 && header->type != 2)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unsupported model type encountered: %v", name);
+                    return collisionData;
+                }
+
+                collisionData->contentHash = GetContentHash(collisionData->getData(), collisionData->getSize());
+                collisionData->valid = true;
+                return collisionData;
+            }
+
+            // Runs on the update thread between steps, models with identical files share one collision
+            NewtonCollision *createCollision(CollisionData const &collisionData)
+            {
+                auto contentSearch = contentCollisionMap.find(collisionData.contentHash);
+                if (contentSearch != std::end(contentCollisionMap))
+                {
+                    return contentSearch->second;
+                }
 
-					static const std::vector<uint8_t> EmptyBuffer;
-					auto filePath = getContext()->getRootFileName("data", "physics", modelComponent.name).withExtension(".gek");
-                    std::vector<uint8_t> buffer(FileSystem::Load(filePath, EmptyBuffer));
-					if (buffer.size() < sizeof(Header))
-					{
-						LockedWrite{ std::cerr } << String::Format("File too small to be collision model: %v", modelComponent.name);
-						return nullptr;
-					}
+                // Newton reads directly out of the file data, no intermediate copy of the whole file
+                struct DeSerializationData
+                {
+                    uint8_t const *current;
+                    uint8_t const *end;
 
-                    Header *header = (Header *)buffer.data();
-                    if (header->identifier != *(uint32_t *)"GEKX")
+                    DeSerializationData(CollisionData const &collisionData, uint8_t const *start)
+                        : current(start)
+                        , end(collisionData.getData() + collisionData.getSize())
                     {
-						LockedWrite{ std::cerr } << String::Format("Unknown model file identifier encountered: %v", modelComponent.name);
-						return nullptr;
                     }
+                };
 
-                    if (header->version != 2)
-                    {
-                        LockedWrite{ std::cerr } << String::Format("Unsupported model version encountered (requires: 2, has: %v): %v", header->version, modelComponent.name);
-						return nullptr;
-					}
+                auto deSerializeCollision = [](void* const serializeHandle, void* const buffer, int size) -> void
+                {
+                    auto data = (DeSerializationData *)serializeHandle;
+                    std::size_t available = std::min(std::size_t(size), std::size_t(data->end - data->current));
+                    memcpy(buffer, data->current, available);
+                    data->current += available;
+                };
 
-                    if (header->newtonVersion != NewtonWorldGetVersion())
-                    {
-						LockedWrite{ std::cerr } << String::Format("Model created with different version of Newton Dynamics (requires: %v, has: %v): %v", NewtonWorldGetVersion(), header->newtonVersion, modelComponent.name);
-						return nullptr;
-					}
+                NewtonCollision *newtonCollision = nullptr;
+                Header const *header = (Header const *)collisionData.getData();
+                if (header->type == 1)
+                {
+                    LockedWrite{ std::cout } << String::Format("Loading hull collision: %v", collisionData.name);
 
-                    struct DeSerializationData
-                    {
-                        std::vector<uint8_t> &buffer;
-                        std::size_t offset;
+                    HullHeader const *hullHeader = (HullHeader const *)header;
+                    DeSerializationData data(collisionData, &hullHeader->serializationData[0]);
+                    newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
+                }
+                else
+                {
+                    LockedWrite{ std::cout } << String::Format("Loading tree collision: %v", collisionData.name);
 
-                        DeSerializationData(std::vector<uint8_t> &buffer, uint8_t *start)
-                            : buffer(buffer)
-                            , offset(start - &buffer.at(0))
+                    TreeHeader const *treeHeader = (TreeHeader const *)header;
+                    DeSerializationData data(collisionData, (uint8_t const *)&treeHeader->materialList[treeHeader->materialCount]);
+                    newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
+                    if (newtonCollision)
+                    {
+                        auto &surfaceMap = sceneSurfaceMap[newtonCollision];
+                        for (uint32_t materialIndex = 0; materialIndex < treeHeader->materialCount; ++materialIndex)
                         {
+                            TreeHeader::Material const &materialHeader = treeHeader->materialList[materialIndex];
+                            surfaceMap[materialIndex] = loadSurface(materialHeader.name);
                         }
-                    };
+                    }
+                }
+
+                if (newtonCollision == nullptr)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unable to create model collision object: %v", collisionData.name);
+                    return nullptr;
+                }
+
+                NewtonCollisionSetMode(newtonCollision, true);
+                NewtonCollisionSetScale(newtonCollision, 1.0f, 1.0f, 1.0f);
+                NewtonCollisionSetMatrix(newtonCollision, Math::Float4x4::Identity.data);
+                contentCollisionMap[collisionData.contentHash] = newtonCollision;
+
+                LockedWrite{ std::cout } << String::Format("Collision model successfully loaded: %v", collisionData.name);
+                return newtonCollision;
+            }
+
+            Collision &requestCollision(Components::Model const &modelComponent)
+            {
+                Identifier identifier(modelComponent.name);
+                auto collisionSearch = collisionMap.find(identifier);
+                if (collisionSearch != std::end(collisionMap))
+                {
+                    return collisionSearch->second;
+                }
 
-                    auto deSerializeCollision = [](void* const serializeHandle, void* const buffer, int size) -> void
+                auto &collision = collisionMap[identifier];
+                collision.loading = true;
+
+                // Deterministic runs can't let load timing decide which update a body starts simulating on,
+                // so the file is read right away and handed over at the start of the next update
+                if (population->isDeterministic())
+                {
+                    loadedCollisionQueue.push(readCollision(identifier, modelComponent.name));
+                    return collision;
+                }
+
+                LockedWrite{ std::cout } << String::Format("Queueing collision model for load: %v", modelComponent.name);
+                loadPool.enqueue([this, identifier, name = modelComponent.name](void) -> void
+                {
+                    loadedCollisionQueue.push(readCollision(identifier, name));
+                });
+
+                return collision;
+            }
+
+            // Every body gets its own instance of the shared collision, so scale is per body
+            NewtonCollision *createCollisionInstance(NewtonCollision *newtonCollision, Components::Transform const &transformComponent)
+            {
+                auto newtonInstance = NewtonCollisionCreateInstance(newtonCollision);
+                NewtonCollisionSetScale(newtonInstance, transformComponent.getWorldScale().x, transformComponent.getWorldScale().y, transformComponent.getWorldScale().z);
+                return newtonInstance;
+            }
+
+            void addSceneEntity(Plugin::Entity * const entity, NewtonCollision *newtonCollision)
+            {
+                sceneAddList.push_back(std::make_pair(entity, newtonCollision));
+            }
+
+            void commitSceneChanges(void)
+            {
+                concurrency::critical_section::scoped_lock lock(criticalSection);
+                if (sceneAddList.empty() && sceneRemoveList.empty() && sceneMoveSet.empty())
+                {
+                    return;
+                }
+
+                createSceneCollision();
+                NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
+                for (auto collisionNode : sceneRemoveList)
+                {
+                    NewtonSceneCollisionRemoveSubCollision(newtonSceneCollision, collisionNode);
+                }
+
+                for (auto const &addPair : sceneAddList)
+                {
+                    auto entity = addPair.first;
+                    auto newtonCollision = addPair.second;
+                    auto const &transformComponent = entity->getComponent<Components::Transform>();
+
+                    auto newtonInstance = createCollisionInstance(newtonCollision, transformComponent);
+                    auto collisionNode = NewtonSceneCollisionAddSubCollision(newtonSceneCollision, newtonInstance);
+                    NewtonDestroyCollision(newtonInstance);
+                    if (collisionNode)
                     {
-                        auto data = (DeSerializationData *)serializeHandle;
-                        memcpy(buffer, &data->buffer.at(data->offset), size);
-                        data->offset += size;
-                    };
+                        NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, collisionNode, transformComponent.getMatrix().data);
+                        auto subCollision = NewtonSceneCollisionGetCollisionFromNode(newtonSceneCollision, collisionNode);
+                        if (subCollision)
+                        {
+                            auto surfaceMapSearch = sceneSurfaceMap.find(newtonCollision);
+                            if (surfaceMapSearch != std::end(sceneSurfaceMap))
+                            {
+                                NewtonCollisionSetUserData(subCollision, &surfaceMapSearch->second);
+                            }
+                        }
+
+                        sceneMap.insert(std::make_pair(entity, collisionNode));
+                    }
+                }
 
-                    if (header->type == 1)
+                for (auto entity : sceneMoveSet)
+                {
+                    auto sceneSearch = sceneMap.find(entity);
+                    if (sceneSearch != std::end(sceneMap))
                     {
-						LockedWrite{ std::cout } << String::Format("Loading hull collision: %v", modelComponent.name);
+                        auto const &transformComponent = entity->getComponent<Components::Transform>();
+                        NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, sceneSearch->second, transformComponent.getMatrix().data);
+                    }
+                }
+
+                NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
+                NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
+
+                sceneAddList.clear();
+                sceneRemoveList.clear();
+                sceneMoveSet.clear();
+            }
+
+            void setRigidBodyCollision(Plugin::Entity * const entity, NewtonCollision *newtonCollision)
+            {
+                auto entitySearch = entityMap.find(entity);
+                if (entitySearch != std::end(entityMap))
+                {
+                    auto const &physicalComponent = entity->getComponent<Components::Physical>();
+                    auto const &transformComponent = entity->getComponent<Components::Transform>();
+
+                    auto newtonBody = entitySearch->second->getNewtonBody();
+                    auto newtonInstance = createCollisionInstance(newtonCollision, transformComponent);
+                    NewtonBodySetCollision(newtonBody, newtonInstance);
+                    NewtonBodySetMassProperties(newtonBody, physicalComponent.mass, newtonInstance);
+                    NewtonBodySetFreezeState(newtonBody, 0);
 
-						HullHeader *hullHeader = (HullHeader *)header;
-                        DeSerializationData data(buffer, (uint8_t *)&hullHeader->serializationData[0]);
-                        newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
+                    auto slotSearch = bodySlotMap.find(entity);
+                    if (slotSearch != std::end(bodySlotMap))
+                    {
+                        bodyStateList.massList[slotSearch->second] = physicalComponent.mass;
+                        bodyForcesChanged = true;
                     }
-                    else if (header->type == 2)
+
+                    NewtonDestroyCollision(newtonInstance);
+                }
+            }
+
+            // Hands finished loads to the entities that were waiting on them, the world isn't updating here
+            void processLoadedCollisions(void)
+            {
+                std::vector<Plugin::Entity *> failedList;
+                concurrency::critical_section::scoped_lock lock(criticalSection);
+
+                std::shared_ptr<CollisionData> collisionData;
+                std::vector<Identifier> loadedList;
+                while (loadedCollisionQueue.try_pop(collisionData))
+                {
+                    auto &collision = collisionMap[collisionData->identifier];
+                    collision.newtonCollision = (collisionData->valid ? createCollision(*collisionData) : nullptr);
+                    collision.loading = false;
+                    loadedList.push_back(collisionData->identifier);
+                };
+
+                if (loadedList.empty())
+                {
+                    return;
+                }
+
+                for (auto pendingSearch = std::begin(pendingEntityMap); pendingSearch != std::end(pendingEntityMap); )
+                {
+                    if (std::find(std::begin(loadedList), std::end(loadedList), pendingSearch->second) == std::end(loadedList))
                     {
-						LockedWrite{ std::cout } << String::Format("Loading tree collision: %v", modelComponent.name);
-						
-						TreeHeader *treeHeader = (TreeHeader *)header;
-                        DeSerializationData data(buffer, (uint8_t *)&treeHeader->materialList[treeHeader->materialCount]);
-                        newtonCollision = NewtonCreateCollisionFromSerialization(newtonWorld, deSerializeCollision, &data);
+                        ++pendingSearch;
+                        continue;
+                    }
 
-                        auto &surfaceMap = sceneSurfaceMap[newtonCollision];
-                        for (uint32_t materialIndex = 0; materialIndex < treeHeader->materialCount; ++materialIndex)
+                    auto entity = pendingSearch->first;
+                    auto newtonCollision = collisionMap[pendingSearch->second].newtonCollision;
+                    pendingSearch = pendingEntityMap.erase(pendingSearch);
+                    if (entity->hasComponent<Components::Scene>())
+                    {
+                        if (newtonCollision)
                         {
-                            TreeHeader::Material &materialHeader = treeHeader->materialList[materialIndex];
-                            surfaceMap[materialIndex] = loadSurface(materialHeader.name);
+                            addSceneEntity(entity, newtonCollision);
                         }
                     }
-                    else
+                    else if (newtonCollision)
                     {
-						LockedWrite{ std::cerr } << String::Format("Unsupported model type encountered: %v", modelComponent.name);
-						return nullptr;
+                        setRigidBodyCollision(entity, newtonCollision);
                     }
-
-                    if (newtonCollision == nullptr)
+                    else
                     {
-						LockedWrite{ std::cerr } << String::Format("Unable to create model collision object: %v", modelComponent.name);
-						return nullptr;
-					}
-
-                    NewtonCollisionSetMode(newtonCollision, true);
-                    NewtonCollisionSetScale(newtonCollision, 1.0f, 1.0f, 1.0f);
-                    NewtonCollisionSetMatrix(newtonCollision, Math::Float4x4::Identity.data);
-                    collisionMap[hash] = newtonCollision;
-
-					LockedWrite{ std::cout } << String::Format("Collision model successfully loaded: %v", modelComponent.name);
-				}
+                        failedList.push_back(entity);
+                    }
+                }
 
-                return newtonCollision;
+                for (auto entity : failedList)
+                {
+                    removeBody(entity);
+                }
             }
 
             void createSceneCollision(void)
@@ -260,7 +587,6 @@ namespace Gek
                 }
             }
 
-            concurrency::critical_section criticalSection;
             void addEntity(Plugin::Entity * const entity)
             {
                 if (entity->hasComponent<Components::Transform>())
@@ -270,31 +596,14 @@ namespace Gek
                     if (entity->hasComponents<Components::Model, Components::Scene>())
                     {
                         auto const &modelComponent = entity->getComponent<Components::Model>();
-                        auto newtonCollision = loadCollision(modelComponent);
-                        if (newtonCollision)
+                        auto const &collision = requestCollision(modelComponent);
+                        if (collision.newtonCollision)
                         {
-                            createSceneCollision();
-                            NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
-                            auto collisionNode = NewtonSceneCollisionAddSubCollision(newtonSceneCollision, newtonCollision);
-                            if (collisionNode)
-                            {
-                                NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, collisionNode, transformComponent.getMatrix().data);
-                                //NewtonCollisionSetScale(subCollision, transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
-                                auto subCollision = NewtonSceneCollisionGetCollisionFromNode(newtonSceneCollision, collisionNode);
-                                if (subCollision)
-                                {
-                                    auto surfaceMapSearch = sceneSurfaceMap.find(newtonCollision);
-                                    if (surfaceMapSearch != std::end(sceneSurfaceMap))
-                                    {
-                                        NewtonCollisionSetUserData(subCollision, &surfaceMapSearch->second);
-                                    }
-                                }
-
-                                sceneMap.insert(std::make_pair(entity, collisionNode));
-                            }
-
-                            NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
-                            NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
+                            addSceneEntity(entity, collision.newtonCollision);
+                        }
+                        else if (collision.loading)
+                        {
+                            pendingEntityMap[entity] = Identifier(modelComponent.name);
                         }
                     }
                     else if (entity->hasComponents<Components::Physical>())
@@ -306,21 +615,39 @@ namespace Gek
                             if (playerBody)
                             {
                                 NewtonBodySetTransformCallback(playerBody->getNewtonBody(), newtonSetTransform);
+                                playerBodyList.push_back(playerBody.get());
                                 entityMap[entity] = std::move(playerBody);
                             }
                         }
                         else if (entity->hasComponent<Components::Model>())
                         {
                             auto const &modelComponent = entity->getComponent<Components::Model>();
-                            auto newtonCollision = loadCollision(modelComponent);
-                            if (newtonCollision)
+                            auto const &collision = requestCollision(modelComponent);
+                            if (collision.newtonCollision || collision.loading)
                             {
-                                auto rigidBody(createRigidBody(newtonWorld, newtonCollision, entity));
+                                // Until the collision is ready the body sits frozen with an empty placeholder shape
+                                auto newtonInstance = (collision.newtonCollision ? createCollisionInstance(collision.newtonCollision, transformComponent) : NewtonCollisionCreateInstance(placeholderCollision));
+                                auto stateSlot = addBodyState(entity, transformComponent);
+                                auto rigidBody(createRigidBody(newtonWorld, newtonInstance, entity, stateSlot));
+                                NewtonDestroyCollision(newtonInstance);
                                 if (rigidBody)
                                 {
+                                    bodyStateList.massList[stateSlot] = physicalComponent.mass;
+                                    bodyForcesChanged = true;
                                     NewtonBodySetTransformCallback(rigidBody->getNewtonBody(), newtonSetTransform);
+                                    NewtonBodySetForceAndTorqueCallback(rigidBody->getNewtonBody(), newtonApplyForceAndTorque);
+                                    if (!collision.newtonCollision)
+                                    {
+                                        NewtonBodySetFreezeState(rigidBody->getNewtonBody(), 1);
+                                        pendingEntityMap[entity] = Identifier(modelComponent.name);
+                                    }
+
                                     entityMap[entity] = std::move(rigidBody);
                                 }
+                                else
+                                {
+                                    removeBodyState(entity);
+                                }
                             }
                         }
                     }
@@ -328,24 +655,36 @@ namespace Gek
             }
 
             void removeEntity(Plugin::Entity * const entity)
+            {
+                concurrency::critical_section::scoped_lock lock(criticalSection);
+                pendingEntityMap.erase(entity);
+                removeBody(entity);
+            }
+
+            void removeBody(Plugin::Entity * const entity)
             {
                 auto entitySearch = entityMap.find(entity);
                 if (entitySearch != std::end(entityMap))
                 {
+                    playerBodyList.erase(std::remove(std::begin(playerBodyList), std::end(playerBodyList), entitySearch->second.get()), std::end(playerBodyList));
                     NewtonDestroyBody(entitySearch->second->getNewtonBody());
-                    auto newtonCollision = NewtonBodyGetCollision(entitySearch->second->getNewtonBody());
                     entityMap.unsafe_erase(entitySearch);
                 }
 
+                removeBodyState(entity);
+
                 auto sceneSearch = sceneMap.find(entity);
                 if (sceneSearch != std::end(sceneMap))
                 {
-                    NewtonSceneCollisionBeginAddRemove(newtonSceneCollision);
-                    NewtonSceneCollisionRemoveSubCollision(newtonSceneCollision, sceneSearch->second);
-                    NewtonSceneCollisionEndAddRemove(newtonSceneCollision);
-                    NewtonBodySetCollision(newtonSceneBody, newtonSceneCollision);
+                    sceneRemoveList.push_back(sceneSearch->second);
                     sceneMap.unsafe_erase(sceneSearch);
                 }
+
+                sceneMoveSet.erase(entity);
+                sceneAddList.erase(std::remove_if(std::begin(sceneAddList), std::end(sceneAddList), [entity](auto const &addPair) -> bool
+                {
+                    return (addPair.first == entity);
+                }), std::end(sceneAddList));
             }
 
             // Plugin::Core
@@ -378,6 +717,7 @@ namespace Gek
 
                 onReset();
 
+                NewtonDestroyCollision(placeholderCollision);
                 NewtonDestroy(newtonWorld);
                 assert(NewtonGetMemoryUsed() == 0);
             }
@@ -393,13 +733,22 @@ namespace Gek
                     if (entitySearch != std::end(entityMap))
                     {
                         NewtonBodySetMatrix(entitySearch->second->getNewtonBody(), transformComponent.getMatrix().data);
-                        NewtonBodySetCollisionScale(entitySearch->second->getNewtonBody(), transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
+                        NewtonBodySetCollisionScale(entitySearch->second->getNewtonBody(), transformComponent.getWorldScale().x, transformComponent.getWorldScale().y, transformComponent.getWorldScale().z);
                     }
 
-                    auto sceneSearch = sceneMap.find(entity);
-                    if (sceneSearch != std::end(sceneMap))
+                    // Moved by hand, so don't interpolate from where the simulation last had it
+                    auto slotSearch = bodySlotMap.find(entity);
+                    if (slotSearch != std::end(bodySlotMap))
                     {
-                        NewtonSceneCollisionSetSubCollisionMatrix(newtonSceneCollision, sceneSearch->second, transformComponent.getMatrix().data);
+                        auto slot = slotSearch->second;
+                        bodyStateList.previousMatrixList[slot] = bodyStateList.currentMatrixList[slot] = transformComponent.getMatrix();
+                        bodyStateList.commitCountList[slot] = 0;
+                    }
+
+                    if (sceneMap.count(entity) > 0)
+                    {
+                        concurrency::critical_section::scoped_lock lock(criticalSection);
+                        sceneMoveSet.insert(entity);
                     }
                 }
                 else if (type == typeid(Components::Model))
@@ -415,15 +764,31 @@ namespace Gek
             // Plugin::Population Slots
             void onReset(void)
             {
+                loadPool.drain();
+                loadedCollisionQueue.clear();
+                pendingEntityMap.clear();
+
                 NewtonWaitForUpdateToFinish(newtonWorld);
-                for (auto const &collisionPair : collisionMap)
+
+                // Nothing left to cast against, so outstanding queries resolve without any hits
+                std::shared_ptr<QueryBatch> queryBatch;
+                while (queryBatchQueue.try_pop(queryBatch))
                 {
-                    if (collisionPair.second)
-                    {
-                        NewtonDestroyCollision(collisionPair.second);
-                    }
+                    queryBatch->promise.set_value(HitList(queryBatch->queryList.size()));
+                }
+
+                for (auto const &spherePair : sphereCollisionMap)
+                {
+                    NewtonDestroyCollision(spherePair.second);
                 }
 
+                sphereCollisionMap.clear();
+                for (auto const &collisionPair : contentCollisionMap)
+                {
+                    NewtonDestroyCollision(collisionPair.second);
+                }
+
+                contentCollisionMap.clear();
                 collisionMap.clear();
                 newtonSceneBody = nullptr;
                 if (newtonSceneCollision)
@@ -433,6 +798,14 @@ namespace Gek
                 }
 
                 sceneMap.clear();
+                sceneAddList.clear();
+                sceneRemoveList.clear();
+                sceneMoveSet.clear();
+                bodySlotMap.clear();
+                bodyStateList.clear();
+                bodyForcesChanged = false;
+                playerBodyList.clear();
+                accumulatedTime = 0.0f;
                 sceneSurfaceMap.clear();
                 entityMap.clear();
                 surfaceList.clear();
@@ -466,20 +839,251 @@ namespace Gek
 
             void onUpdate(float frameTime)
             {
+                GEK_PROFILE_ZONE("Physics Update");
+                Memory::Scope memoryScope(Memory::Tag::Physics);
+
                 assert(population);
                 assert(newtonWorld);
 
+                processLoadedCollisions();
+                commitSceneChanges();
+
                 bool editorActive = core->getOption("editor", "active").convert(false);
                 if (frameTime > 0.0f && !editorActive)
                 {
-                    static const float StepTime = (1.0f / 120.0f);
-                    while (frameTime > 0.0f)
+                    // Time the step budget can't cover is dropped, instead of carrying it over and
+                    // making every following frame take even longer
+                    uint32_t maximumStepCount = std::max(core->getOption("physics", "maximumStepCount").convert(8U), 1U);
+                    accumulatedTime = std::min((accumulatedTime + frameTime), (StepTime * maximumStepCount));
+
+                    uint32_t stepCount = uint32_t(accumulatedTime / StepTime);
+                    for (uint32_t stepIndex = 0; stepIndex < stepCount; ++stepIndex)
                     {
-                        NewtonUpdate(newtonWorld, std::min(frameTime, StepTime));
-                        frameTime -= StepTime;
-                    };
+                        // Only the state before the final step is needed to interpolate
+                        if ((stepIndex + 1) == stepCount)
+                        {
+                            bodyStateList.previousMatrixList = bodyStateList.currentMatrixList;
+                        }
+
+                        GEK_PROFILE_ZONE("Physics Step");
+                        NewtonUpdate(newtonWorld, StepTime);
+                    }
 
+                    accumulatedTime -= (stepCount * StepTime);
                     NewtonWaitForUpdateToFinish(newtonWorld);
+                    commitBodyStates((accumulatedTime / StepTime), (stepCount > 0));
+                }
+
+                processQueries();
+            }
+
+            uint32_t addBodyState(Plugin::Entity * const entity, Components::Transform &transformComponent)
+            {
+                uint32_t slot = 0;
+                auto matrix(transformComponent.getMatrix());
+                if (bodyStateList.freeSlotList.empty())
+                {
+                    slot = uint32_t(bodyStateList.transformList.size());
+                    bodyStateList.massList.push_back(0.0f);
+                    bodyStateList.forceXList.push_back(0.0f);
+                    bodyStateList.forceYList.push_back(0.0f);
+                    bodyStateList.forceZList.push_back(0.0f);
+                    bodyStateList.transformList.push_back(&transformComponent);
+                    bodyStateList.previousMatrixList.push_back(matrix);
+                    bodyStateList.currentMatrixList.push_back(matrix);
+                    bodyStateList.commitCountList.push_back(0);
+                }
+                else
+                {
+                    slot = bodyStateList.freeSlotList.back();
+                    bodyStateList.freeSlotList.pop_back();
+                    bodyStateList.massList[slot] = 0.0f;
+                    bodyStateList.forceXList[slot] = bodyStateList.forceYList[slot] = bodyStateList.forceZList[slot] = 0.0f;
+                    bodyStateList.transformList[slot] = &transformComponent;
+                    bodyStateList.previousMatrixList[slot] = bodyStateList.currentMatrixList[slot] = matrix;
+                    bodyStateList.commitCountList[slot] = 0;
+                }
+
+                bodySlotMap[entity] = slot;
+                return slot;
+            }
+
+            void removeBodyState(Plugin::Entity * const entity)
+            {
+                auto slotSearch = bodySlotMap.find(entity);
+                if (slotSearch != std::end(bodySlotMap))
+                {
+                    bodyStateList.transformList[slotSearch->second] = nullptr;
+                    bodyStateList.freeSlotList.push_back(slotSearch->second);
+                    bodySlotMap.unsafe_erase(slotSearch);
+                }
+            }
+
+            // Runs from the pre update listener, before Newton integrates the step
+            //  - gravity is uniform, so every force is just the body's mass times the world gravity
+            //  - forces only change with the masses, so they're recomputed four at a time when one does instead of every step
+            void updateBodyForces(void)
+            {
+                if (!bodyForcesChanged)
+                {
+                    return;
+                }
+
+                bodyForcesChanged = false;
+                auto slotCount = bodyStateList.massList.size();
+                auto vectorCount = (slotCount & ~std::size_t(3));
+
+                __m128 gravityX = _mm_set_ps1(gravity.x);
+                __m128 gravityY = _mm_set_ps1(gravity.y);
+                __m128 gravityZ = _mm_set_ps1(gravity.z);
+                for (std::size_t slot = 0; slot < vectorCount; slot += 4)
+                {
+                    __m128 mass = _mm_loadu_ps(&bodyStateList.massList[slot]);
+                    _mm_storeu_ps(&bodyStateList.forceXList[slot], _mm_mul_ps(gravityX, mass));
+                    _mm_storeu_ps(&bodyStateList.forceYList[slot], _mm_mul_ps(gravityY, mass));
+                    _mm_storeu_ps(&bodyStateList.forceZList[slot], _mm_mul_ps(gravityZ, mass));
+                }
+
+                for (std::size_t slot = vectorCount; slot < slotCount; ++slot)
+                {
+                    auto mass = bodyStateList.massList[slot];
+                    bodyStateList.forceXList[slot] = (gravity.x * mass);
+                    bodyStateList.forceYList[slot] = (gravity.y * mass);
+                    bodyStateList.forceZList[slot] = (gravity.z * mass);
+                }
+            }
+
+            // Runs after NewtonWaitForUpdateToFinish, so nothing else is touching the staging list
+            void commitBodyStates(float factor, bool stepped)
+            {
+                concurrency::parallel_for(size_t(0), bodyStateList.transformList.size(), [&](size_t slot) -> void
+                {
+                    auto transformComponent = bodyStateList.transformList[slot];
+                    auto &commitCount = bodyStateList.commitCountList[slot];
+                    if (transformComponent && commitCount > 0)
+                    {
+                        auto const &previousMatrix = bodyStateList.previousMatrixList[slot];
+                        auto const &currentMatrix = bodyStateList.currentMatrixList[slot];
+                        transformComponent->position = Math::Interpolate(previousMatrix.translation.xyz, currentMatrix.translation.xyz, factor);
+                        transformComponent->rotation = previousMatrix.getRotation().slerp(currentMatrix.getRotation(), factor);
+                        transformComponent->setDirty();
+                        if (stepped)
+                        {
+                            --commitCount;
+                        }
+                    }
+                });
+            }
+
+            NewtonCollision const *getSphereCollision(float radius)
+            {
+                uint32_t radiusKey = 0;
+                std::memcpy(&radiusKey, &radius, sizeof(float));
+                auto &sphereCollision = sphereCollisionMap[radiusKey];
+                if (!sphereCollision)
+                {
+                    sphereCollision = NewtonCreateSphere(newtonWorld, radius, 0, nullptr);
+                }
+
+                return sphereCollision;
+            }
+
+            // Runs after the step has finished, so the world isn't changing while the casts read from it
+            //  - shapes and ignored bodies are resolved here on the main thread
+            //  - the casts themselves are split in to jobs across Newton's worker threads
+            void processQueries(void)
+            {
+                std::vector<std::shared_ptr<QueryBatch>> queryBatchList;
+                std::shared_ptr<QueryBatch> pendingBatch;
+                while (queryBatchQueue.try_pop(pendingBatch))
+                {
+                    queryBatchList.push_back(pendingBatch);
+                }
+
+                if (queryBatchList.empty())
+                {
+                    return;
+                }
+
+                GEK_PROFILE_ZONE("Physics Queries");
+                std::vector<QueryJob> queryJobList;
+                for (auto &queryBatch : queryBatchList)
+                {
+                    auto queryCount = queryBatch->queryList.size();
+                    queryBatch->hitList.resize(queryCount);
+                    queryBatch->ignoreBodyList.resize(queryCount, nullptr);
+                    queryBatch->shapeList.resize(queryCount, nullptr);
+                    for (std::size_t queryIndex = 0; queryIndex < queryCount; ++queryIndex)
+                    {
+                        auto const &query = queryBatch->queryList[queryIndex];
+                        if (query.ignoreEntity)
+                        {
+                            auto entitySearch = entityMap.find(query.ignoreEntity);
+                            if (entitySearch != std::end(entityMap))
+                            {
+                                queryBatch->ignoreBodyList[queryIndex] = entitySearch->second->getNewtonBody();
+                            }
+                        }
+
+                        switch (query.type)
+                        {
+                        case Query::Type::Sphere:
+                            queryBatch->shapeList[queryIndex] = (query.radius > 0.0f ? getSphereCollision(query.radius) : nullptr);
+                            break;
+
+                        case Query::Type::Convex:
+                            queryBatch->shapeList[queryIndex] = query.shape;
+                            break;
+                        };
+                    }
+
+                    for (std::size_t first = 0; first < queryCount; first += QueriesPerJob)
+                    {
+                        queryJobList.push_back({ this, queryBatch.get(), first, std::min((first + QueriesPerJob), queryCount) });
+                    }
+                }
+
+                for (auto &queryJob : queryJobList)
+                {
+                    NewtonDispachThreadJob(newtonWorld, [](NewtonWorld* const world, void* const userData, int threadIndex) -> void
+                    {
+                        auto queryJob = static_cast<QueryJob *>(userData);
+                        queryJob->processor->castQueryRange(*queryJob->queryBatch, queryJob->first, queryJob->last, threadIndex);
+                    }, &queryJob);
+                }
+
+                NewtonSyncThreadJobs(newtonWorld);
+                for (auto &queryBatch : queryBatchList)
+                {
+                    queryBatch->promise.set_value(std::move(queryBatch->hitList));
+                }
+            }
+
+            void castQueryRange(QueryBatch &queryBatch, std::size_t first, std::size_t last, int threadIndex)
+            {
+                for (auto queryIndex = first; queryIndex < last; ++queryIndex)
+                {
+                    auto const &query = queryBatch.queryList[queryIndex];
+                    auto &hit = queryBatch.hitList[queryIndex];
+                    CastData castData = { queryBatch.ignoreBodyList[queryIndex], &hit };
+                    if (query.type == Query::Type::Ray)
+                    {
+                        NewtonWorldRayCast(newtonWorld, query.start.data, query.end.data, newtonQueryRayFilter, &castData, newtonQueryPreFilter, threadIndex);
+                    }
+                    else if (queryBatch.shapeList[queryIndex])
+                    {
+                        float distance = 1.0f;
+                        NewtonWorldConvexCastReturnInfo contactInformation;
+                        auto matrix(Math::Float4x4::MakeQuaternionRotation(query.rotation, query.start));
+                        if (NewtonWorldConvexCast(newtonWorld, matrix.data, query.end.data, queryBatch.shapeList[queryIndex], &distance, &castData, newtonQueryPreFilter, &contactInformation, 1, threadIndex) > 0)
+                        {
+                            hit.valid = true;
+                            hit.entity = getBodyEntity(contactInformation.m_hitBody);
+                            hit.distance = distance;
+                            hit.position.set(contactInformation.m_point);
+                            hit.normal.set(contactInformation.m_normal);
+                        }
+                    }
                 }
             }
 
@@ -502,8 +1106,29 @@ namespace Gek
             // Newton::World
             Math::Float3 getGravity(Math::Float3 const &position)
             {
-                const Math::Float3 Gravity(0.0f, -32.174f, 0.0f);
-                return Gravity;
+                return gravity;
+            }
+
+            std::future<HitList> castQueries(QueryList &&queryList)
+            {
+                auto queryBatch = std::make_shared<QueryBatch>();
+                queryBatch->queryList = std::move(queryList);
+                auto hitFuture = queryBatch->promise.get_future();
+                queryBatchQueue.push(queryBatch);
+                return hitFuture;
+            }
+
+            Math::Float3 getBodyForce(uint32_t slot) const
+            {
+                // Called from Newton's worker threads, the lists are only written before the step starts
+                return Math::Float3(bodyStateList.forceXList[slot], bodyStateList.forceYList[slot], bodyStateList.forceZList[slot]);
+            }
+
+            void setBodyMatrix(uint32_t slot, float const * const matrixData)
+            {
+                // Called from Newton's worker threads, every body owns its own slot so no locking is needed
+                std::memcpy(bodyStateList.currentMatrixList[slot].data, matrixData, sizeof(Math::Float4x4));
+                bodyStateList.commitCountList[slot] = 2;
             }
 
             uint32_t loadSurface(std::string const &surfaceName)
@@ -548,16 +1173,20 @@ namespace Gek
             // Processor
             static void newtonWorldPreUpdate(const NewtonWorld* const world, void* const userData, float frameTime)
             {
-                std::map<Newton::Entity *, float> updateMap;
                 Processor *processor = static_cast<Processor *>(userData);
-                for (auto const &entityPair : processor->entityMap)
+                processor->updateBodyForces();
+
+                // Reserved up front, the jobs hold pointers in to the list
+                std::vector<std::pair<Newton::Entity *, float>> updateList;
+                updateList.reserve(processor->playerBodyList.size());
+                for (auto playerBody : processor->playerBodyList)
                 {
-                    auto updatePair = (*updateMap.insert(std::make_pair(entityPair.second.get(), frameTime)).first);
+                    updateList.push_back(std::make_pair(playerBody, frameTime));
                     NewtonDispachThreadJob(processor->newtonWorld, [](NewtonWorld* const world, void* const userData, int threadIndex) -> void
                     {
                         auto updatePair = static_cast<std::pair<Newton::Entity *, float> *>(userData);
                         updatePair->first->onPreUpdate(updatePair->second, threadIndex);
-                    }, &updatePair);
+                    }, &updateList.back());
                 }
 
                 NewtonSyncThreadJobs(processor->newtonWorld);
@@ -565,21 +1194,58 @@ namespace Gek
 
             static void newtonWorldPostUpdate(const NewtonWorld* const world, void* const userData, float frameTime)
             {
-                std::map<Newton::Entity *, float> updateMap;
                 Processor *processor = static_cast<Processor *>(userData);
-                for (auto const &entityPair : processor->entityMap)
+                std::vector<std::pair<Newton::Entity *, float>> updateList;
+                updateList.reserve(processor->playerBodyList.size());
+                for (auto playerBody : processor->playerBodyList)
                 {
-                    auto updatePair = (*updateMap.insert(std::make_pair(entityPair.second.get(), frameTime)).first);
+                    updateList.push_back(std::make_pair(playerBody, frameTime));
                     NewtonDispachThreadJob(processor->newtonWorld, [](NewtonWorld* const world, void* const userData, int threadIndex) -> void
                     {
                         auto updatePair = static_cast<std::pair<Newton::Entity *, float> *>(userData);
                         updatePair->first->onPostUpdate(updatePair->second, threadIndex);
-                    }, &updatePair);
+                    }, &updateList.back());
                 }
 
                 NewtonSyncThreadJobs(processor->newtonWorld);
             }
 
+            static Plugin::Entity *getBodyEntity(const NewtonBody* const body)
+            {
+                Newton::Entity *newtonEntity = static_cast<Newton::Entity *>(NewtonBodyGetUserData(body));
+                return (newtonEntity ? newtonEntity->getEntity() : nullptr);
+            }
+
+            static unsigned newtonQueryPreFilter(const NewtonBody* const body, const NewtonCollision* const collision, void* const userData)
+            {
+                CastData *castData = static_cast<CastData *>(userData);
+                return (body != castData->ignoreBody ? NewtonCollisionGetMode(collision) : 0);
+            }
+
+            // Keeps the closest hit, returning its distance clips the rest of the ray to it
+            static float newtonQueryRayFilter(const NewtonBody* const body, const NewtonCollision* const shapeHit, const float* const hitContact, const float* const hitNormal, dLong collisionIdentifier, void* const userData, float intersectParameter)
+            {
+                CastData *castData = static_cast<CastData *>(userData);
+                Hit *hit = castData->hit;
+                if (intersectParameter < hit->distance)
+                {
+                    hit->valid = true;
+                    hit->entity = getBodyEntity(body);
+                    hit->distance = intersectParameter;
+                    hit->position.set(hitContact);
+                    hit->normal.set(hitNormal);
+                }
+
+                return hit->distance;
+            }
+
+            // Newton only calls this for bodies that are awake, sleeping and frozen bodies are skipped entirely
+            static void newtonApplyForceAndTorque(const NewtonBody* const body, float frameTime, int threadHandle)
+            {
+                Newton::Entity *newtonEntity = static_cast<Newton::Entity *>(NewtonBodyGetUserData(body));
+                newtonEntity->onApplyForce(threadHandle);
+            }
+
             static void newtonSetTransform(const NewtonBody* const body, const float* const matrixData, int threadHandle)
             {
                 Newton::Entity *newtonEntity = static_cast<Newton::Entity *>(NewtonBodyGetUserData(body));
@@ -641,6 +1307,8 @@ namespace Gek
             }
         };
 
+        const Math::Float3 Processor::DefaultGravity(0.0f, -32.174f, 0.0f);
+
         GEK_REGISTER_CONTEXT_USER(Processor)
     }; // namespace Newton
 }; // namespace Gek
@@ -24,7 +24,7 @@ namespace Gek
                 componentData.set("mass", data->mass);
             }
 
-            void load(Components::Physical * const data, JSON::Reference componentData)
+            void load(Components::Physical * const data, JSON::View componentData)
             {
                 data->mass = parse(componentData.get("mass"), 0.0f);
             }
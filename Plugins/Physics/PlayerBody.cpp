@@ -408,32 +408,33 @@ namespace Gek
                     return;
                 }
 
-                if (action.name == "turn")
+                auto const &actionNames = Plugin::Population::Action::GetNames();
+                if (action.name == actionNames.turn)
 				{
 					headingAngle += (action.value * 0.01f);
 				}
-                else if (action.name == "tilt")
+                else if (action.name == actionNames.tilt)
                 {
                     lookingAngle += (action.value * 0.01f);
                     lookingAngle = Math::Clamp(lookingAngle, -Math::Pi * 0.5f, Math::Pi * 0.5f);
                 }
-                else if (action.name == "move_forward")
+                else if (action.name == actionNames.moveForward)
 				{
 					moveForward = action.state;
 				}
-				else if (action.name == "move_backward")
+				else if (action.name == actionNames.moveBackward)
 				{
 					moveBackward = action.state;
 				}
-				else if (action.name == "strafe_left")
+				else if (action.name == actionNames.strafeLeft)
 				{
 					strafeLeft = action.state;
 				}
-				else if (action.name == "strafe_right")
+				else if (action.name == actionNames.strafeRight)
 				{
 					strafeRight = action.state;
 				}
-				else if (action.name == "crouch")
+				else if (action.name == actionNames.crouch)
 				{
 				}
 
@@ -662,6 +663,7 @@ namespace Gek
                 auto &transformComponent = entity->getComponent<Components::Transform>();
                 transformComponent.position = (matrix.translation.xyz + (matrix.ry.xyz * playerComponent.height));
                 transformComponent.rotation = (Math::Quaternion::MakePitchRotation(lookingAngle) * matrix.getRotation());
+                transformComponent.setDirty();
                 forwardSpeed = 0.0f;
                 lateralSpeed = 0.0f;
                 verticalSpeed = 0.0f;
@@ -675,26 +677,28 @@ namespace Gek
 
 		StatePtr IdleState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
 		{
-			if (action.name == "crouch" && action.state)
+			auto const &actionNames = Plugin::Population::Action::GetNames();
+
+			if (action.name == actionNames.crouch && action.state)
 			{
 			}
-			else if (action.name == "move_forward" && action.state)
+			else if (action.name == actionNames.moveForward && action.state)
 			{
 				return std::make_unique<WalkingState>();
 			}
-			else if (action.name == "move_backward" && action.state)
+			else if (action.name == actionNames.moveBackward && action.state)
 			{
 				return std::make_unique<WalkingState>();
 			}
-			else if (action.name == "strafe_left" && action.state)
+			else if (action.name == actionNames.strafeLeft && action.state)
 			{
 				return std::make_unique<WalkingState>();
 			}
-			else if (action.name == "strafe_right" && action.state)
+			else if (action.name == actionNames.strafeRight && action.state)
 			{
 				return std::make_unique<WalkingState>();
 			}
-			else if (action.name == "jump" && action.state && player->touchingSurface)
+			else if (action.name == actionNames.jump && action.state && player->touchingSurface)
 			{
 				return std::make_unique<JumpingState>();
 			}
@@ -716,7 +720,9 @@ namespace Gek
 
 		StatePtr WalkingState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
 		{
-			if (action.name == "jump" && action.state && player->touchingSurface)
+			auto const &actionNames = Plugin::Population::Action::GetNames();
+
+			if (action.name == actionNames.jump && action.state && player->touchingSurface)
 			{
 				return std::make_unique<JumpingState>();
 			}
@@ -749,7 +755,9 @@ namespace Gek
 
         StatePtr JumpingState::onAction(PlayerBody *player, Plugin::Population::Action const &action)
         {
-            if (action.name == "jump" && action.state && player->touchingSurface)
+            auto const &actionNames = Plugin::Population::Action::GetNames();
+
+            if (action.name == actionNames.jump && action.state && player->touchingSurface)
             {
                 return std::make_unique<JumpingState>();
             }
@@ -34,7 +34,7 @@ namespace Gek
                 componentData.set("stairStep", data->stairStep);
             }
 
-            void load(Components::Player * const data, JSON::Reference componentData)
+            void load(Components::Player * const data, JSON::View componentData)
             {
                 data->height = parse(componentData.get("height"), 0.0f);
                 data->outerRadius = parse(componentData.get("outerRadius"), 0.0f);
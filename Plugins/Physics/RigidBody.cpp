@@ -19,11 +19,13 @@ namespace Gek
             Newton::World *world = nullptr;
             Plugin::Entity * const entity = nullptr;
             NewtonBody *newtonBody = nullptr;
+            uint32_t stateSlot = 0;
 
         public:
-            RigidBody(NewtonWorld *newtonWorld, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity)
+            RigidBody(NewtonWorld *newtonWorld, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity, uint32_t stateSlot)
                 : world(static_cast<Newton::World *>(NewtonWorldGetUserData(newtonWorld)))
                 , entity(entity)
+                , stateSlot(stateSlot)
             {
                 assert(world);
                 assert(entity);
@@ -35,7 +37,6 @@ namespace Gek
                 newtonBody = NewtonCreateDynamicBody(newtonWorld, newtonCollision, matrix.data);
 				assert(newtonBody && "Unable to create rigid body");
 
-                NewtonBodySetCollisionScale(newtonBody, transformComponent.scale.x, transformComponent.scale.y, transformComponent.scale.z);
                 NewtonBodySetUserData(newtonBody, dynamic_cast<Newton::Entity *>(this));
                 NewtonBodySetMassProperties(newtonBody, physicalComponent.mass, newtonCollision);
                 NewtonBodySetCollidable(newtonBody, true);
@@ -62,27 +63,20 @@ namespace Gek
                 return 0;
             }
 
-            void onPreUpdate(float frameTime, int threadHandle)
+            void onApplyForce(int threadHandle)
             {
-				auto const &physicalComponent = entity->getComponent<Components::Physical>();
-				auto const &transformComponent = entity->getComponent<Components::Transform>();
-
-                Math::Float3 gravity(world->getGravity(transformComponent.position));
-                NewtonBodyAddForce(newtonBody, (gravity * physicalComponent.mass).data);
+                NewtonBodySetForce(newtonBody, world->getBodyForce(stateSlot).data);
             }
 
             void onSetTransform(const float* const matrixData, int threadHandle)
             {
-                Math::Float4x4 matrix(matrixData);
-				auto &transformComponent = entity->getComponent<Components::Transform>();
-                transformComponent.rotation = matrix.getRotation();
-                transformComponent.position = matrix.translation.xyz;
+                world->setBodyMatrix(stateSlot, matrixData);
             }
         };
 
-        Newton::EntityPtr createRigidBody(NewtonWorld *newtonWorld, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity)
+        Newton::EntityPtr createRigidBody(NewtonWorld *newtonWorld, const NewtonCollision* const newtonCollision, Plugin::Entity * const entity, uint32_t stateSlot)
         {
-            return std::make_unique<RigidBody>(newtonWorld, newtonCollision, entity);
+            return std::make_unique<RigidBody>(newtonWorld, newtonCollision, entity, stateSlot);
         }
     }; // namespace Newton
 }; // namespace Gek
\ No newline at end of file
@@ -259,10 +259,29 @@ namespace Gek
                 return nullptr;
             }
 
+            void setVoiceBudget(uint32_t voiceCount)
+            {
+            }
+
+            Audio::BufferPtr createBuffer(uint32_t sampleRate, uint32_t channelCount, uint32_t frameCount, float const *sampleList)
+            {
+                return nullptr;
+            }
+
+            Audio::StreamPtr openStream(FileSystem::Path const &filePath)
+            {
+                return nullptr;
+            }
+
             Audio::SoundPtr createSound(void)
             {
                 return nullptr;
             }
+
+            // Buffers are mixed by DirectSound
+            void update(float frameTime)
+            {
+            }
 /*
 			Audio::EffectPtr loadEffect(FileSystem::Path const &filePath)
 			{
@@ -9,6 +9,7 @@
 
 #include "GEK/Math/Vector4.hpp"
 #include "GEK/Math/Matrix4x4.hpp"
+#include "GEK/Utility/FileSystem.hpp"
 #include "GEK/Utility/Context.hpp"
 
 namespace Gek
@@ -18,11 +19,53 @@ namespace Gek
 		GEK_INTERFACE(Buffer)
 		{
             virtual ~Buffer(void) = default;
+
+            virtual uint32_t getSampleRate(void) const = 0;
+            virtual uint32_t getChannelCount(void) const = 0;
+            virtual uint32_t getFrameCount(void) const = 0;
         };
 
+        // Decoded a piece at a time on a worker thread while it plays, so only a short ring of frames is kept in memory
+        //  - a stream can only be played by one sound at a time
+        //  - stopping the sound rewinds the stream, and seeking takes effect once the worker has caught up
+        GEK_INTERFACE(Stream)
+        {
+            virtual ~Stream(void) = default;
+
+            virtual uint32_t getSampleRate(void) const = 0;
+            virtual uint32_t getChannelCount(void) const = 0;
+            virtual uint32_t getFrameCount(void) const = 0;
+
+            // Looping sounds continue from the start frame when they reach the end frame, an empty range loops the whole stream
+            virtual void setLoopPoints(uint32_t startFrame, uint32_t endFrame) = 0;
+            virtual void seek(uint32_t frame) = 0;
+        };
+
+        // A voice, which plays one buffer or stream at a time
+        //  - play(loop) plays at the listener, play(origin, loop) is attenuated and panned from the origin
+        //  - buffers and streams need to outlive the sounds that play them
 		GEK_INTERFACE(Sound)
 		{
             virtual ~Sound(void) = default;
+
+            virtual void setBuffer(Buffer *buffer) = 0;
+            virtual void setStream(Stream *stream) = 0;
+            virtual void setVolume(float volume) = 0;
+
+            // Higher priority voices are kept audible when more voices are playing than the device's budget
+            virtual void setPriority(float priority) = 0;
+
+            virtual void setDistance(float minimum, float maximum) = 0;
+            virtual void setPosition(Math::Float3 const &position) = 0;
+
+            virtual void play(bool loop) = 0;
+            virtual void play(Math::Float3 const &origin, bool loop) = 0;
+            virtual void stop(void) = 0;
+
+            virtual bool isPlaying(void) const = 0;
+
+            // Still playing, but advanced without being mixed since it was over the budget
+            virtual bool isVirtual(void) const = 0;
         };
 
         GEK_INTERFACE(Device)
@@ -34,8 +77,20 @@ namespace Gek
 
             virtual void setListener(Math::Float4x4 const &matrix) = 0;
 
+            // Maximum number of voices that are mixed at once, quieter voices past it are virtualized
+            virtual void setVoiceBudget(uint32_t voiceCount) = 0;
+
 			virtual BufferPtr loadBuffer(FileSystem::Path const &filePath) = 0;
+
+            // Interleaved float samples, in the range -1 to 1
+            virtual BufferPtr createBuffer(uint32_t sampleRate, uint32_t channelCount, uint32_t frameCount, float const *sampleList) = 0;
+
+            virtual StreamPtr openStream(FileSystem::Path const &filePath) = 0;
+
 			virtual SoundPtr createSound(void) = 0;
+
+            // Called once per frame, devices that mix in software mix the elapsed time to their output
+            virtual void update(float frameTime) = 0;
         };
     }; // namespace Audio
 }; // namespace Gek
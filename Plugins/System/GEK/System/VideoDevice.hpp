@@ -739,5 +739,31 @@ namespace Gek
                 virtual void *getDevice(void) = 0;
             };
         }; // namespace Debug
+
+        namespace Recording
+        {
+            // Device that keeps count of the commands it's given instead of executing them
+            GEK_INTERFACE(Device)
+                : public Video::Device
+            {
+                struct Counters
+                {
+                    uint64_t drawCallCount = 0;
+                    uint64_t instanceCount = 0;
+                    uint64_t primitiveCount = 0;
+                    uint64_t dispatchCount = 0;
+                    uint64_t commandListCount = 0;
+                };
+
+                virtual ~Device(void) = default;
+
+                // Commands executed between the last two calls to present
+                virtual Counters const &getFrameCounters(void) const = 0;
+
+                // Commands executed since the device was created, or since the last resetCounters
+                virtual Counters const &getTotalCounters(void) const = 0;
+                virtual void resetCounters(void) = 0;
+            };
+        }; // namespace Recording
     }; // namespace Video
 }; // namespace Gek
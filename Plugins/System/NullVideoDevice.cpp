@@ -0,0 +1,654 @@
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/System/VideoDevice.hpp"
+#include "GEK/System/Window.hpp"
+#include <algorithm>
+#include <memory>
+
+namespace Gek
+{
+    namespace Null
+    {
+        static char const * const SemanticNameList[] =
+        {
+            "POSITION",
+            "TEXCOORD",
+            "TANGENT",
+            "BINORMAL",
+            "NORMAL",
+            "COLOR",
+        };
+
+        static_assert((sizeof(SemanticNameList) / sizeof(SemanticNameList[0])) == static_cast<uint8_t>(Video::InputElement::Semantic::Count), "New input element semantic added without adding to all SemanticNameList.");
+
+        using Counters = Video::Recording::Device::Counters;
+
+        static void AddCounters(Counters &counters, Counters const &source)
+        {
+            counters.drawCallCount += source.drawCallCount;
+            counters.instanceCount += source.instanceCount;
+            counters.primitiveCount += source.primitiveCount;
+            counters.dispatchCount += source.dispatchCount;
+            counters.commandListCount += source.commandListCount;
+        }
+
+        template <typename BASE = Video::Object>
+        class NamedObject
+            : public BASE
+        {
+        public:
+            std::string name;
+
+        public:
+            std::type_index getTypeInfo(void) const
+            {
+                return typeid(BASE);
+            }
+
+            void setName(std::string const &name)
+            {
+                this->name = name;
+            }
+
+            std::string const &getName(void) const
+            {
+                return name;
+            }
+        };
+
+        template <typename BASE>
+        class DescribedObject
+            : public NamedObject<BASE>
+        {
+        public:
+            typename BASE::Description description;
+
+        public:
+            DescribedObject(typename BASE::Description const &description)
+                : description(description)
+            {
+            }
+
+            typename BASE::Description const &getDescription(void) const
+            {
+                return description;
+            }
+        };
+
+        using Object = NamedObject<>;
+        using RenderState = DescribedObject<Video::RenderState>;
+        using DepthState = DescribedObject<Video::DepthState>;
+        using BlendState = DescribedObject<Video::BlendState>;
+        using SamplerState = DescribedObject<Video::SamplerState>;
+        using Query = NamedObject<Video::Query>;
+
+        class CommandList
+            : public NamedObject<>
+        {
+        public:
+            Counters counters;
+
+        public:
+            CommandList(Counters const &counters)
+                : counters(counters)
+            {
+            }
+        };
+
+        class Buffer
+            : public DescribedObject<Video::Buffer>
+        {
+        public:
+            // Backs mapBuffer, so anything written to a mapped buffer still has somewhere to go
+            std::vector<uint8_t> data;
+
+        public:
+            Buffer(Video::Buffer::Description const &description)
+                : DescribedObject(description)
+            {
+                // No format is wider than sixteen bytes, so that covers typed buffers without a format table
+                uint32_t stride = (description.format == Video::Format::Unknown ? description.stride : 16);
+                data.resize(size_t(stride) * description.count);
+            }
+        };
+
+        // Every texture is also a target, since nothing is ever actually drawn to them
+        class Texture
+            : public NamedObject<Video::Target>
+        {
+        public:
+            Video::Texture::Description description;
+            Video::ViewPort viewPort;
+
+        public:
+            Texture(Video::Texture::Description const &description)
+                : description(description)
+                , viewPort(Math::Float2(0.0f, 0.0f), Math::Float2(float(description.width), float(description.height)), 0.0f, 1.0f)
+            {
+            }
+
+            std::type_index getTypeInfo(void) const
+            {
+                return (description.flags & Video::Texture::Flags::RenderTarget ? typeid(Video::Target) : typeid(Video::Texture));
+            }
+
+            // Video::Texture
+            Video::Texture::Description const &getDescription(void) const
+            {
+                return description;
+            }
+
+            // Video::Target
+            Video::ViewPort const &getViewPort(void) const
+            {
+                return viewPort;
+            }
+        };
+
+        // Records nothing but the number of commands executed, so a frame can be rendered on any machine
+        //  - every command is accepted and discarded, programs aren't compiled and textures aren't loaded
+        //  - mapped buffers are backed by memory, and queries are always ready with zeroed results
+        //  - deferred contexts keep their own counts, which are added to the frame when their command list is executed
+        GEK_CONTEXT_USER(Device, Window *, Video::Device::Description)
+            , public Video::Recording::Device
+        {
+            class Context
+                : public Video::Device::Context
+            {
+                class EmptyPipeline
+                    : public Video::Device::Context::Pipeline
+                {
+                private:
+                    Video::PipelineType type;
+
+                public:
+                    EmptyPipeline(Video::PipelineType type)
+                        : type(type)
+                    {
+                    }
+
+                    // Video::Pipeline
+                    Video::PipelineType getType(void) const
+                    {
+                        return type;
+                    }
+
+                    void setProgram(Video::Object *program)
+                    {
+                    }
+
+                    void setSamplerStateList(const std::vector<Video::Object *> &list, uint32_t firstStage)
+                    {
+                    }
+
+                    void setConstantBufferList(const std::vector<Video::Buffer *> &list, uint32_t firstStage)
+                    {
+                    }
+
+                    void setResourceList(const std::vector<Video::Object *> &list, uint32_t firstStage)
+                    {
+                    }
+
+                    void setUnorderedAccessList(const std::vector<Video::Object *> &list, uint32_t firstStage, uint32_t *countList)
+                    {
+                    }
+
+                    void clearSamplerStateList(uint32_t count, uint32_t firstStage)
+                    {
+                    }
+
+                    void clearConstantBufferList(uint32_t count, uint32_t firstStage)
+                    {
+                    }
+
+                    void clearResourceList(uint32_t count, uint32_t firstStage)
+                    {
+                    }
+
+                    void clearUnorderedAccessList(uint32_t count, uint32_t firstStage)
+                    {
+                    }
+                };
+
+            public:
+                PipelinePtr computeSystemHandler;
+                PipelinePtr vertexSystemHandler;
+                PipelinePtr geomtrySystemHandler;
+                PipelinePtr pixelSystemHandler;
+
+                Video::PrimitiveType primitiveType = Video::PrimitiveType::TriangleList;
+                Counters counters;
+
+            public:
+                Context(void)
+                    : computeSystemHandler(new EmptyPipeline(Video::PipelineType::Compute))
+                    , vertexSystemHandler(new EmptyPipeline(Video::PipelineType::Vertex))
+                    , geomtrySystemHandler(new EmptyPipeline(Video::PipelineType::Geometry))
+                    , pixelSystemHandler(new EmptyPipeline(Video::PipelineType::Pixel))
+                {
+                }
+
+                void recordDraw(uint32_t instanceCount, uint32_t vertexCount)
+                {
+                    uint32_t primitiveCount = 0;
+                    switch (primitiveType)
+                    {
+                    case Video::PrimitiveType::PointList:
+                        primitiveCount = vertexCount;
+                        break;
+
+                    case Video::PrimitiveType::LineList:
+                        primitiveCount = (vertexCount / 2);
+                        break;
+
+                    case Video::PrimitiveType::LineStrip:
+                        primitiveCount = (vertexCount > 1 ? (vertexCount - 1) : 0);
+                        break;
+
+                    case Video::PrimitiveType::TriangleList:
+                        primitiveCount = (vertexCount / 3);
+                        break;
+
+                    case Video::PrimitiveType::TriangleStrip:
+                        primitiveCount = (vertexCount > 2 ? (vertexCount - 2) : 0);
+                        break;
+                    };
+
+                    ++counters.drawCallCount;
+                    counters.instanceCount += instanceCount;
+                    counters.primitiveCount += (uint64_t(primitiveCount) * instanceCount);
+                }
+
+                // Video::Context
+                Pipeline * const computePipeline(void)
+                {
+                    return computeSystemHandler.get();
+                }
+
+                Pipeline * const vertexPipeline(void)
+                {
+                    return vertexSystemHandler.get();
+                }
+
+                Pipeline * const geometryPipeline(void)
+                {
+                    return geomtrySystemHandler.get();
+                }
+
+                Pipeline * const pixelPipeline(void)
+                {
+                    return pixelSystemHandler.get();
+                }
+
+                void begin(Video::Query *query)
+                {
+                    assert(query);
+                }
+
+                void end(Video::Query *query)
+                {
+                    assert(query);
+                }
+
+                Video::Query::Status getData(Video::Query *query, void *data, size_t dataSize, bool waitUntilReady = false)
+                {
+                    assert(query);
+
+                    if (data)
+                    {
+                        std::fill_n(static_cast<uint8_t *>(data), dataSize, uint8_t(0));
+                    }
+
+                    return Video::Query::Status::Ready;
+                }
+
+                void generateMipMaps(Video::Texture *texture)
+                {
+                    assert(texture);
+                }
+
+                void resolveSamples(Video::Texture *destination, Video::Texture *source)
+                {
+                    assert(destination);
+                    assert(source);
+                }
+
+                void clearState(void)
+                {
+                    primitiveType = Video::PrimitiveType::TriangleList;
+                }
+
+                void setViewportList(const std::vector<Video::ViewPort> &viewPortList)
+                {
+                }
+
+                void setScissorList(const std::vector<Math::UInt4> &rectangleList)
+                {
+                }
+
+                void clearUnorderedAccess(Video::Object *object, Math::Float4 const &value)
+                {
+                    assert(object);
+                }
+
+                void clearUnorderedAccess(Video::Object *object, Math::UInt4 const &value)
+                {
+                    assert(object);
+                }
+
+                void clearRenderTarget(Video::Target *renderTarget, Math::Float4 const &clearColor)
+                {
+                    assert(renderTarget);
+                }
+
+                void clearDepthStencilTarget(Video::Object *depthBuffer, uint32_t flags, float clearDepth, uint32_t clearStencil)
+                {
+                    assert(depthBuffer);
+                }
+
+                void clearIndexBuffer(void)
+                {
+                }
+
+                void clearVertexBufferList(uint32_t count, uint32_t firstSlot)
+                {
+                }
+
+                void clearRenderTargetList(uint32_t count, bool depthBuffer)
+                {
+                }
+
+                void setRenderTargetList(const std::vector<Video::Target *> &renderTargetList, Video::Object *depthBuffer)
+                {
+                }
+
+                void setRenderState(Video::Object *renderState)
+                {
+                    assert(renderState);
+                }
+
+                void setDepthState(Video::Object *depthState, uint32_t stencilReference)
+                {
+                    assert(depthState);
+                }
+
+                void setBlendState(Video::Object *blendState, Math::Float4 const &blendFactor, uint32_t mask)
+                {
+                    assert(blendState);
+                }
+
+                void setInputLayout(Video::Object *inputLayout)
+                {
+                }
+
+                void setIndexBuffer(Video::Buffer *indexBuffer, uint32_t offset)
+                {
+                    assert(indexBuffer);
+                }
+
+                void setVertexBufferList(const std::vector<Video::Buffer *> &vertexBufferList, uint32_t firstSlot, uint32_t *offsetList)
+                {
+                }
+
+                void setPrimitiveType(Video::PrimitiveType primitiveType)
+                {
+                    this->primitiveType = primitiveType;
+                }
+
+                void drawPrimitive(uint32_t vertexCount, uint32_t firstVertex)
+                {
+                    recordDraw(1, vertexCount);
+                }
+
+                void drawInstancedPrimitive(uint32_t instanceCount, uint32_t firstInstance, uint32_t vertexCount, uint32_t firstVertex)
+                {
+                    recordDraw(instanceCount, vertexCount);
+                }
+
+                void drawIndexedPrimitive(uint32_t indexCount, uint32_t firstIndex, uint32_t firstVertex)
+                {
+                    recordDraw(1, indexCount);
+                }
+
+                void drawInstancedIndexedPrimitive(uint32_t instanceCount, uint32_t firstInstance, uint32_t indexCount, uint32_t firstIndex, uint32_t firstVertex)
+                {
+                    recordDraw(instanceCount, indexCount);
+                }
+
+                void dispatch(uint32_t threadGroupCountX, uint32_t threadGroupCountY, uint32_t threadGroupCountZ)
+                {
+                    ++counters.dispatchCount;
+                }
+
+                Video::ObjectPtr finishCommandList(void)
+                {
+                    auto commandList = std::make_unique<CommandList>(counters);
+                    counters = Counters();
+                    primitiveType = Video::PrimitiveType::TriangleList;
+                    return commandList;
+                }
+            };
+
+        public:
+            Window *window = nullptr;
+
+            std::unique_ptr<Context> defaultContext;
+            Video::TargetPtr backBuffer;
+            Video::DisplayMode displayMode;
+
+            Counters frameCounters;
+            Counters totalCounters;
+
+        public:
+            Device(Gek::Context *context, Window *window, Video::Device::Description deviceDescription)
+                : ContextRegistration(context)
+                , window(window)
+                , defaultContext(std::make_unique<Context>())
+            {
+                displayMode.width = 1920;
+                displayMode.height = 1080;
+                displayMode.format = deviceDescription.displayFormat;
+                displayMode.aspectRatio = Video::DisplayMode::AspectRatio::_16x9;
+                displayMode.refreshRate.numerator = 60;
+                displayMode.refreshRate.denominator = 1;
+            }
+
+            // Video::Recording::Device
+            Counters const &getFrameCounters(void) const
+            {
+                return frameCounters;
+            }
+
+            Counters const &getTotalCounters(void) const
+            {
+                return totalCounters;
+            }
+
+            void resetCounters(void)
+            {
+                frameCounters = Counters();
+                totalCounters = Counters();
+                defaultContext->counters = Counters();
+            }
+
+            // Video::Device
+            Video::DisplayModeList getDisplayModeList(Video::Format format) const
+            {
+                Video::DisplayModeList displayModeList;
+                displayModeList.push_back(displayMode);
+                displayModeList.back().format = format;
+                return displayModeList;
+            }
+
+            void setFullScreenState(bool fullScreen)
+            {
+            }
+
+            void setDisplayMode(const Video::DisplayMode &displayMode)
+            {
+                this->displayMode = displayMode;
+                backBuffer = nullptr;
+            }
+
+            void handleResize(void)
+            {
+                backBuffer = nullptr;
+            }
+
+            char const * const getSemanticMoniker(Video::InputElement::Semantic semantic)
+            {
+                return SemanticNameList[static_cast<uint8_t>(semantic)];
+            }
+
+            Video::Target * const getBackBuffer(void)
+            {
+                if (!backBuffer)
+                {
+                    Video::Texture::Description description;
+                    description.width = displayMode.width;
+                    description.height = displayMode.height;
+                    description.format = displayMode.format;
+                    description.flags = (Video::Texture::Flags::RenderTarget | Video::Texture::Flags::Resource);
+                    backBuffer = std::make_unique<Texture>(description);
+                }
+
+                return backBuffer.get();
+            }
+
+            Video::Device::Context * const getDefaultContext(void)
+            {
+                return defaultContext.get();
+            }
+
+            Video::Device::ContextPtr createDeferredContext(void)
+            {
+                return std::make_unique<Context>();
+            }
+
+            Video::QueryPtr createQuery(Video::Query::Type type)
+            {
+                return std::make_unique<Query>();
+            }
+
+            Video::RenderStatePtr createRenderState(Video::RenderState::Description const &description)
+            {
+                return std::make_unique<RenderState>(description);
+            }
+
+            Video::DepthStatePtr createDepthState(Video::DepthState::Description const &description)
+            {
+                return std::make_unique<DepthState>(description);
+            }
+
+            Video::BlendStatePtr createBlendState(Video::BlendState::Description const &description)
+            {
+                return std::make_unique<BlendState>(description);
+            }
+
+            Video::SamplerStatePtr createSamplerState(Video::SamplerState::Description const &description)
+            {
+                return std::make_unique<SamplerState>(description);
+            }
+
+            Video::BufferPtr createBuffer(const Video::Buffer::Description &description, const void *data)
+            {
+                assert(description.count > 0);
+
+                return std::make_unique<Buffer>(description);
+            }
+
+            bool mapBuffer(Video::Buffer *buffer, void *&data, Video::Map mapping)
+            {
+                assert(buffer);
+
+                auto nullBuffer = dynamic_cast<Buffer *>(buffer);
+                if (!nullBuffer || nullBuffer->data.empty())
+                {
+                    return false;
+                }
+
+                data = nullBuffer->data.data();
+                return true;
+            }
+
+            void unmapBuffer(Video::Buffer *buffer)
+            {
+                assert(buffer);
+            }
+
+            void updateResource(Video::Object *object, const void *data)
+            {
+                assert(object);
+                assert(data);
+            }
+
+            void copyResource(Video::Object *destination, Video::Object *source)
+            {
+                assert(destination);
+                assert(source);
+            }
+
+            Video::TexturePtr createTexture(const Video::Texture::Description &description, const void *data)
+            {
+                return std::make_unique<Texture>(description);
+            }
+
+            Video::TexturePtr loadTexture(FileSystem::Path const &filePath, uint32_t flags)
+            {
+                return std::make_unique<Texture>(loadTextureDescription(filePath));
+            }
+
+            Video::TexturePtr loadTexture(void const *buffer, size_t size, uint32_t flags)
+            {
+                return std::make_unique<Texture>(loadTextureDescription(FileSystem::Path()));
+            }
+
+            Video::Texture::Description loadTextureDescription(FileSystem::Path const &filePath)
+            {
+                // Texture files aren't read, every texture is a single texel
+                Video::Texture::Description description;
+                description.format = Video::Format::R8G8B8A8_UNORM;
+                description.flags = Video::Texture::Flags::Resource;
+                return description;
+            }
+
+            Video::ObjectPtr createInputLayout(const std::vector<Video::InputElement> &elementList, const void *compiledData, uint32_t compiledSize)
+            {
+                return std::make_unique<Object>();
+            }
+
+            std::vector<uint8_t> compileProgram(Video::PipelineType pipelineType, std::string const &name, std::string const &uncompiledProgram, std::string const &entryFunction)
+            {
+                // Nothing is compiled, an empty program is also never written to the program cache
+                return std::vector<uint8_t>();
+            }
+
+            Video::ObjectPtr createProgram(Video::PipelineType pipelineType, const void *compiledData, uint32_t compiledSize)
+            {
+                return std::make_unique<Object>();
+            }
+
+            void executeCommandList(Video::Object *commandList)
+            {
+                assert(commandList);
+
+                auto nullCommandList = dynamic_cast<CommandList *>(commandList);
+                if (nullCommandList)
+                {
+                    AddCounters(defaultContext->counters, nullCommandList->counters);
+                    ++defaultContext->counters.commandListCount;
+                }
+            }
+
+            void present(bool waitForVerticalSync)
+            {
+                frameCounters = defaultContext->counters;
+                AddCounters(totalCounters, frameCounters);
+                defaultContext->counters = Counters();
+            }
+        };
+
+        GEK_REGISTER_CONTEXT_USER(Device);
+    }; // namespace Null
+}; // namespace Gek
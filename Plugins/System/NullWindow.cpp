@@ -0,0 +1,64 @@
+#include "GEK/System/Window.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+
+namespace Gek
+{
+    namespace Null
+    {
+        // Window that is never shown and never sends any events, used to run the engine headless
+        GEK_CONTEXT_USER(Window, Gek::Window::Description)
+            , public Gek::Window
+        {
+        private:
+            Math::Int4 clientRectangle;
+            Math::Int2 cursorPosition = Math::Int2::Zero;
+
+        public:
+            Window(Context *context, Window::Description description)
+                : ContextRegistration(context)
+                , clientRectangle(0, 0, int32_t(description.initialWidth), int32_t(description.initialHeight))
+            {
+            }
+
+            // Window
+            void readEvents(void)
+            {
+            }
+
+            void *getBaseWindow(void) const
+            {
+                return nullptr;
+            }
+
+            Math::Int4 getClientRectangle(bool moveToScreen = false) const
+            {
+                return clientRectangle;
+            }
+
+            Math::Int4 getScreenRectangle(void) const
+            {
+                return clientRectangle;
+            }
+
+            Math::Int2 getCursorPosition(void) const
+            {
+                return cursorPosition;
+            }
+
+            void setCursorPosition(Math::Int2 const &position)
+            {
+                cursorPosition = position;
+            }
+
+            void setVisibility(bool isVisible)
+            {
+            }
+
+            void move(Math::Int2 const &position)
+            {
+            }
+        };
+
+        GEK_REGISTER_CONTEXT_USER(Window);
+    }; // namespace Null
+}; // namespace Gek
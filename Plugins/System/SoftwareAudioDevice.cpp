@@ -0,0 +1,1309 @@
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/Memory.hpp"
+#include "GEK/Utility/Allocator.hpp"
+#include "GEK/Utility/ThreadPool.hpp"
+#include "GEK/System/AudioDevice.hpp"
+#include <xmmintrin.h>
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <cstdio>
+#include <cmath>
+
+namespace Gek
+{
+    namespace Software
+    {
+        static const uint32_t SampleRate = 48000;
+        static const uint32_t ChannelCount = 2;
+        static const uint32_t BlockFrameCount = 512;
+        static const uint32_t DefaultVoiceBudget = 64;
+
+        // Frames kept decoded ahead of each stream, a power of two, and the most decoded at once
+        static const uint32_t StreamFrameCount = 32768;
+        static const uint32_t DecodeFrameCount = 4096;
+
+        using SampleList = std::vector<float, AlignedAllocator<float, 16, Memory::Tag::Audio>>;
+
+        template <typename TYPE>
+        using VoiceList = std::vector<TYPE, TaggedAllocator<TYPE, Memory::Tag::Audio>>;
+
+        namespace Wave
+        {
+            static const uint16_t PCM = 1;
+            static const uint16_t Float = 3;
+            static const uint16_t ImaAdpcm = 0x11;
+            static const uint16_t Extensible = 0xFFFE;
+
+            struct Format
+            {
+                uint16_t type = 0;
+                uint16_t channelCount = 0;
+                uint32_t sampleRate = 0;
+                uint16_t bitsPerSample = 0;
+                uint16_t blockSize = 0;
+
+                // From the format extension and fact chunk, which compressed formats need
+                uint16_t samplesPerBlock = 0;
+                uint32_t frameCount = 0;
+            };
+
+            template <typename TYPE>
+            TYPE Read(uint8_t const *data)
+            {
+                TYPE value;
+                std::memcpy(&value, data, sizeof(TYPE));
+                return value;
+            }
+
+            // Finds the format and sample data of a RIFF wave file, samples are left in place
+            static bool Parse(uint8_t const *file, size_t fileSize, Format &format, uint8_t const *&sampleData, uint32_t &sampleSize)
+            {
+                if (!file || fileSize < 12 || std::memcmp(file, "RIFF", 4) != 0 || std::memcmp(file + 8, "WAVE", 4) != 0)
+                {
+                    return false;
+                }
+
+                bool formatFound = false;
+                sampleData = nullptr;
+                for (size_t offset = 12; (offset + 8) <= fileSize;)
+                {
+                    auto chunk = (file + offset);
+                    auto chunkSize = Read<uint32_t>(chunk + 4);
+                    auto chunkData = (chunk + 8);
+                    chunkSize = uint32_t(std::min(size_t(chunkSize), (fileSize - offset - 8)));
+                    if (std::memcmp(chunk, "fmt ", 4) == 0 && chunkSize >= 16)
+                    {
+                        format.type = Read<uint16_t>(chunkData);
+                        format.channelCount = Read<uint16_t>(chunkData + 2);
+                        format.sampleRate = Read<uint32_t>(chunkData + 4);
+                        format.blockSize = Read<uint16_t>(chunkData + 12);
+                        format.bitsPerSample = Read<uint16_t>(chunkData + 14);
+                        if (format.type == Extensible && chunkSize >= 26)
+                        {
+                            // First two bytes of the sub format GUID are the actual format type
+                            format.type = Read<uint16_t>(chunkData + 24);
+                        }
+                        else if (format.type == ImaAdpcm && chunkSize >= 20)
+                        {
+                            format.samplesPerBlock = Read<uint16_t>(chunkData + 18);
+                        }
+
+                        formatFound = true;
+                    }
+                    else if (std::memcmp(chunk, "fact", 4) == 0 && chunkSize >= 4)
+                    {
+                        format.frameCount = Read<uint32_t>(chunkData);
+                    }
+                    else if (std::memcmp(chunk, "data", 4) == 0)
+                    {
+                        sampleData = chunkData;
+                        sampleSize = chunkSize;
+                    }
+
+                    // Chunks are padded to an even size
+                    offset += (8 + chunkSize + (chunkSize & 1));
+                }
+
+                return (formatFound && sampleData);
+            }
+
+            static float ReadSample(Format const &format, uint8_t const *data)
+            {
+                switch (format.bitsPerSample)
+                {
+                case 8:
+                    return ((float(data[0]) - 128.0f) / 128.0f);
+
+                case 16:
+                    return (float(Read<int16_t>(data)) / 32768.0f);
+
+                case 24:
+                    return (float(int32_t((uint32_t(data[0]) << 8) | (uint32_t(data[1]) << 16) | (uint32_t(data[2]) << 24)) >> 8) / 8388608.0f);
+
+                case 32:
+                    return (format.type == Float ? Read<float>(data) : (float(Read<int32_t>(data)) / 2147483648.0f));
+                };
+
+                return 0.0f;
+            }
+        }; // namespace Wave
+
+        // Mapped where possible, so streams only page in the part they're decoding, packed files are loaded whole
+        struct SourceFile
+        {
+            FileSystem::MappedFile mappedFile;
+            std::vector<uint8_t> packedFile;
+
+            uint8_t const *getData(void) const
+            {
+                return (mappedFile ? mappedFile.getData() : packedFile.data());
+            }
+
+            size_t getSize(void) const
+            {
+                return (mappedFile ? mappedFile.getSize() : packedFile.size());
+            }
+        };
+
+        // Reads frames of a wave file as interleaved floats, a piece at a time
+        class Decoder
+        {
+        protected:
+            SourceFile sourceFile;
+            Wave::Format format;
+            uint8_t const *sampleData;
+            uint32_t sampleSize;
+            uint32_t frameCount = 0;
+            uint32_t position = 0;
+
+        public:
+            Decoder(SourceFile &&sourceFile, Wave::Format const &format, uint8_t const *sampleData, uint32_t sampleSize)
+                : sourceFile(std::move(sourceFile))
+                , format(format)
+                , sampleData(sampleData)
+                , sampleSize(sampleSize)
+            {
+            }
+
+            virtual ~Decoder(void) = default;
+
+            uint32_t getSampleRate(void) const
+            {
+                return format.sampleRate;
+            }
+
+            uint32_t getChannelCount(void) const
+            {
+                return format.channelCount;
+            }
+
+            uint32_t getFrameCount(void) const
+            {
+                return frameCount;
+            }
+
+            uint32_t getPosition(void) const
+            {
+                return position;
+            }
+
+            void seek(uint32_t frame)
+            {
+                position = std::min(frame, frameCount);
+            }
+
+            // Returns the number of frames read, which is less than asked for at the end of the file
+            virtual uint32_t read(float *sampleList, uint32_t frameCount) = 0;
+        };
+
+        class PcmDecoder
+            : public Decoder
+        {
+        private:
+            uint32_t bytesPerSample;
+
+        public:
+            PcmDecoder(SourceFile &&sourceFile, Wave::Format const &format, uint8_t const *sampleData, uint32_t sampleSize)
+                : Decoder(std::move(sourceFile), format, sampleData, sampleSize)
+                , bytesPerSample(format.bitsPerSample / 8)
+            {
+                frameCount = (sampleSize / format.blockSize);
+            }
+
+            // Decoder
+            uint32_t read(float *sampleList, uint32_t frameCount)
+            {
+                frameCount = std::min(frameCount, (this->frameCount - position));
+                auto sampleCount = (frameCount * format.channelCount);
+                auto source = (sampleData + position * format.blockSize);
+                for (uint32_t sample = 0; sample < sampleCount; ++sample)
+                {
+                    sampleList[sample] = Wave::ReadSample(format, source + sample * bytesPerSample);
+                }
+
+                position += frameCount;
+                return frameCount;
+            }
+        };
+
+        // IMA ADPCM, four bits per sample in blocks that each start from a stored sample, so any block can be decoded on its own
+        class AdpcmDecoder
+            : public Decoder
+        {
+        private:
+            static int32_t const StepList[89];
+            static int32_t const IndexList[16];
+
+            uint32_t blockCount;
+            uint32_t decodedBlock = 0xFFFFFFFF;
+            SampleList blockSampleList;
+
+        public:
+            AdpcmDecoder(SourceFile &&sourceFile, Wave::Format const &format, uint8_t const *sampleData, uint32_t sampleSize)
+                : Decoder(std::move(sourceFile), format, sampleData, sampleSize)
+                , blockCount((sampleSize + format.blockSize - 1) / format.blockSize)
+                , blockSampleList(format.samplesPerBlock * format.channelCount)
+            {
+                frameCount = (blockCount * format.samplesPerBlock);
+                if (format.frameCount > 0)
+                {
+                    frameCount = std::min(frameCount, format.frameCount);
+                }
+            }
+
+            void decodeBlock(uint32_t block)
+            {
+                auto channelCount = format.channelCount;
+                auto headerSize = (4U * channelCount);
+                auto blockOffset = (block * format.blockSize);
+                auto blockSize = std::min(uint32_t(format.blockSize), (sampleSize - blockOffset));
+                auto data = (sampleData + blockOffset);
+                std::fill(std::begin(blockSampleList), std::end(blockSampleList), 0.0f);
+                decodedBlock = block;
+                if (blockSize < headerSize)
+                {
+                    return;
+                }
+
+                int32_t predictorList[2];
+                int32_t indexList[2];
+                for (uint32_t channel = 0; channel < channelCount; ++channel)
+                {
+                    predictorList[channel] = Wave::Read<int16_t>(data + channel * 4);
+                    indexList[channel] = std::min(88, int32_t(data[channel * 4 + 2]));
+                    blockSampleList[channel] = (float(predictorList[channel]) / 32768.0f);
+                }
+
+                // Each channel has four bytes, eight samples, at a time, lowest nibble first
+                uint32_t sample = 1;
+                for (uint32_t offset = headerSize; (offset + headerSize) <= blockSize && (sample + 8) <= format.samplesPerBlock; offset += headerSize, sample += 8)
+                {
+                    for (uint32_t channel = 0; channel < channelCount; ++channel)
+                    {
+                        auto &predictor = predictorList[channel];
+                        auto &index = indexList[channel];
+                        for (uint32_t nibble = 0; nibble < 8; ++nibble)
+                        {
+                            auto code = ((data[offset + channel * 4 + nibble / 2] >> ((nibble & 1) * 4)) & 0xF);
+                            auto step = StepList[index];
+                            auto difference = (step >> 3);
+                            difference += ((code & 1) ? (step >> 2) : 0);
+                            difference += ((code & 2) ? (step >> 1) : 0);
+                            difference += ((code & 4) ? step : 0);
+                            predictor = std::min(32767, std::max(-32768, ((code & 8) ? (predictor - difference) : (predictor + difference))));
+                            index = std::min(88, std::max(0, (index + IndexList[code])));
+                            blockSampleList[(sample + nibble) * channelCount + channel] = (float(predictor) / 32768.0f);
+                        }
+                    }
+                }
+            }
+
+            // Decoder
+            uint32_t read(float *sampleList, uint32_t frameCount)
+            {
+                frameCount = std::min(frameCount, (this->frameCount - position));
+                auto channelCount = format.channelCount;
+                for (uint32_t frame = 0; frame < frameCount;)
+                {
+                    auto block = (position / format.samplesPerBlock);
+                    auto blockFrame = (position % format.samplesPerBlock);
+                    if (block != decodedBlock)
+                    {
+                        decodeBlock(block);
+                    }
+
+                    auto count = std::min((frameCount - frame), (format.samplesPerBlock - blockFrame));
+                    std::copy_n((blockSampleList.data() + blockFrame * channelCount), (count * channelCount), (sampleList + frame * channelCount));
+                    position += count;
+                    frame += count;
+                }
+
+                return frameCount;
+            }
+        };
+
+        int32_t const AdpcmDecoder::StepList[89] =
+        {
+            7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37, 41, 45,
+            50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173, 190, 209, 230, 253, 279, 307,
+            337, 371, 408, 449, 494, 544, 598, 658, 724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+            2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484, 7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899,
+            15289, 16818, 18500, 20350, 22385, 24623, 27086, 29794, 32767,
+        };
+
+        int32_t const AdpcmDecoder::IndexList[16] =
+        {
+            -1, -1, -1, -1, 2, 4, 6, 8,
+            -1, -1, -1, -1, 2, 4, 6, 8,
+        };
+
+        static std::unique_ptr<Decoder> OpenDecoder(FileSystem::Path const &filePath)
+        {
+            SourceFile sourceFile;
+            if (FileSystem::IsPackedFile(filePath))
+            {
+                sourceFile.packedFile = FileSystem::Load(filePath, std::vector<uint8_t>());
+            }
+            else
+            {
+                sourceFile.mappedFile = FileSystem::MappedFile(filePath);
+            }
+
+            Wave::Format format;
+            uint8_t const *sampleData = nullptr;
+            uint32_t sampleSize = 0;
+            if (Wave::Parse(sourceFile.getData(), sourceFile.getSize(), format, sampleData, sampleSize) &&
+                format.channelCount >= 1 && format.channelCount <= 2 && format.sampleRate > 0 && format.blockSize > 0)
+            {
+                switch (format.type)
+                {
+                case Wave::PCM:
+                    if (format.bitsPerSample == 8 || format.bitsPerSample == 16 || format.bitsPerSample == 24 || format.bitsPerSample == 32)
+                    {
+                        return std::make_unique<PcmDecoder>(std::move(sourceFile), format, sampleData, sampleSize);
+                    }
+
+                    break;
+
+                case Wave::Float:
+                    if (format.bitsPerSample == 32)
+                    {
+                        return std::make_unique<PcmDecoder>(std::move(sourceFile), format, sampleData, sampleSize);
+                    }
+
+                    break;
+
+                case Wave::ImaAdpcm:
+                    if (format.bitsPerSample == 4 && format.samplesPerBlock > 0 && format.blockSize > (4 * format.channelCount))
+                    {
+                        return std::make_unique<AdpcmDecoder>(std::move(sourceFile), format, sampleData, sampleSize);
+                    }
+
+                    break;
+                };
+            }
+
+            LockedWrite{ std::cerr } << String::Format("Unsupported audio file: %v", filePath.u8string());
+            return nullptr;
+        }
+
+        // Accumulates frames of a mono or stereo source in to interleaved stereo output
+        static void MixFrames(float const *source, uint32_t sourceChannelCount, uint32_t frameCount, float gainLeft, float gainRight, float *output)
+        {
+            __m128 gain = _mm_setr_ps(gainLeft, gainRight, gainLeft, gainRight);
+            uint32_t frame = 0;
+            if (sourceChannelCount == 1)
+            {
+                for (; (frame + 4) <= frameCount; frame += 4)
+                {
+                    __m128 samples = _mm_loadu_ps(source + frame);
+                    float *target = (output + frame * 2);
+                    _mm_storeu_ps(target, _mm_add_ps(_mm_loadu_ps(target), _mm_mul_ps(_mm_unpacklo_ps(samples, samples), gain)));
+                    _mm_storeu_ps(target + 4, _mm_add_ps(_mm_loadu_ps(target + 4), _mm_mul_ps(_mm_unpackhi_ps(samples, samples), gain)));
+                }
+
+                for (; frame < frameCount; ++frame)
+                {
+                    output[frame * 2 + 0] += (source[frame] * gainLeft);
+                    output[frame * 2 + 1] += (source[frame] * gainRight);
+                }
+            }
+            else
+            {
+                for (; (frame + 2) <= frameCount; frame += 2)
+                {
+                    float *target = (output + frame * 2);
+                    _mm_storeu_ps(target, _mm_add_ps(_mm_loadu_ps(target), _mm_mul_ps(_mm_loadu_ps(source + frame * 2), gain)));
+                }
+
+                for (; frame < frameCount; ++frame)
+                {
+                    output[frame * 2 + 0] += (source[frame * 2 + 0] * gainLeft);
+                    output[frame * 2 + 1] += (source[frame * 2 + 1] * gainRight);
+                }
+            }
+        }
+
+        // Applies the master volume and clamps to the output range
+        static void FinishFrames(float volume, uint32_t sampleCount, float *output)
+        {
+            __m128 gain = _mm_set1_ps(volume);
+            __m128 minimum = _mm_set1_ps(-1.0f);
+            __m128 maximum = _mm_set1_ps(1.0f);
+            uint32_t sample = 0;
+            for (; (sample + 4) <= sampleCount; sample += 4)
+            {
+                _mm_storeu_ps(output + sample, _mm_min_ps(maximum, _mm_max_ps(minimum, _mm_mul_ps(_mm_loadu_ps(output + sample), gain))));
+            }
+
+            for (; sample < sampleCount; ++sample)
+            {
+                output[sample] = std::min(1.0f, std::max(-1.0f, (output[sample] * volume)));
+            }
+        }
+
+        // Where mixed blocks of interleaved stereo frames are sent
+        class Output
+        {
+        public:
+            virtual ~Output(void) = default;
+
+            virtual void write(float const *sampleList, uint32_t frameCount) = 0;
+        };
+
+        class NullOutput
+            : public Output
+        {
+        public:
+            void write(float const *sampleList, uint32_t frameCount)
+            {
+            }
+        };
+
+        // Writes float wave files, the sizes in the header are filled in when the output is closed
+        class WaveOutput
+            : public Output
+        {
+        private:
+            FILE *file = nullptr;
+            uint32_t sampleSize = 0;
+
+        public:
+            WaveOutput(FileSystem::Path const &filePath)
+            {
+                FileSystem::MakeDirectoryChain(filePath.getParentPath());
+                file = fopen(filePath.u8string().c_str(), "wb");
+                if (file)
+                {
+                    writeHeader();
+                }
+                else
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unable to open audio output file: %v", filePath.u8string());
+                }
+            }
+
+            ~WaveOutput(void)
+            {
+                if (file)
+                {
+                    fseek(file, 0, SEEK_SET);
+                    writeHeader();
+                    fclose(file);
+                }
+            }
+
+            bool isOpen(void) const
+            {
+                return (file != nullptr);
+            }
+
+            void writeHeader(void)
+            {
+                uint8_t header[44];
+                auto write = [&header](size_t offset, auto value) -> void
+                {
+                    std::memcpy(header + offset, &value, sizeof(value));
+                };
+
+                std::memcpy(header + 0, "RIFF", 4);
+                write(4, uint32_t(36 + sampleSize));
+                std::memcpy(header + 8, "WAVE", 4);
+                std::memcpy(header + 12, "fmt ", 4);
+                write(16, uint32_t(16));
+                write(20, uint16_t(Wave::Float));
+                write(22, uint16_t(ChannelCount));
+                write(24, uint32_t(SampleRate));
+                write(28, uint32_t(SampleRate * ChannelCount * sizeof(float)));
+                write(32, uint16_t(ChannelCount * sizeof(float)));
+                write(34, uint16_t(32));
+                std::memcpy(header + 36, "data", 4);
+                write(40, uint32_t(sampleSize));
+                fwrite(header, sizeof(header), 1, file);
+            }
+
+            // Output
+            void write(float const *sampleList, uint32_t frameCount)
+            {
+                if (file)
+                {
+                    auto size = uint32_t(frameCount * ChannelCount * sizeof(float));
+                    fwrite(sampleList, size, 1, file);
+                    sampleSize += size;
+                }
+            }
+        };
+
+        class Buffer
+            : public Audio::Buffer
+        {
+        public:
+            uint32_t sampleRate = 0;
+            uint32_t channelCount = 0;
+            uint32_t frameCount = 0;
+            SampleList sampleList;
+
+        public:
+            // Audio::Buffer
+            uint32_t getSampleRate(void) const
+            {
+                return sampleRate;
+            }
+
+            uint32_t getChannelCount(void) const
+            {
+                return channelCount;
+            }
+
+            uint32_t getFrameCount(void) const
+            {
+                return frameCount;
+            }
+        };
+
+        // Ring of decoded frames, filled on the decode thread and read by the mixer without locking
+        //  - the indices only ever increase, and are wrapped to the ring when used
+        //  - seeks are requested by the game thread and carried out by the decode thread, which publishes the index
+        //    that frames decoded after the seek start at, the mixer skips the stale frames before it
+        struct StreamState
+        {
+            std::unique_ptr<Decoder> decoder;
+            SampleList ringBuffer;
+            uint32_t channelCount;
+
+            std::atomic<uint64_t> readIndex = 0;
+            std::atomic<uint64_t> writeIndex = 0;
+
+            // Write index where a stream that isn't looping finished decoding
+            std::atomic<uint64_t> endIndex = UINT64_MAX;
+
+            std::atomic<bool> looping = false;
+            std::atomic<uint32_t> loopStartFrame = 0;
+            std::atomic<uint32_t> loopEndFrame = 0;
+
+            std::atomic<uint32_t> seekFrame = 0;
+            std::atomic<uint32_t> seekRequestCount = 0;
+            std::atomic<uint32_t> seekCompleteCount = 0;
+            std::atomic<uint64_t> seekIndex = 0;
+
+            std::atomic<bool> refillQueued = false;
+
+            // Only used by the decode thread
+            uint32_t seekHandledCount = 0;
+
+            StreamState(std::unique_ptr<Decoder> &&decoder)
+                : decoder(std::move(decoder))
+                , ringBuffer(StreamFrameCount * this->decoder->getChannelCount())
+                , channelCount(this->decoder->getChannelCount())
+            {
+            }
+
+            // Decodes until the ring is full, or the end of a stream that isn't looping
+            void refill(void)
+            {
+                GEK_PROFILE_ZONE("Audio Decode");
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+
+                auto writeIndex = this->writeIndex.load(std::memory_order_relaxed);
+                auto seekRequestCount = this->seekRequestCount.load(std::memory_order_acquire);
+                if (seekRequestCount != seekHandledCount)
+                {
+                    seekHandledCount = seekRequestCount;
+                    decoder->seek(seekFrame.load(std::memory_order_relaxed));
+                    endIndex.store(UINT64_MAX, std::memory_order_relaxed);
+                    seekIndex.store(writeIndex, std::memory_order_relaxed);
+                    seekCompleteCount.store(seekRequestCount, std::memory_order_release);
+                }
+
+                while (endIndex.load(std::memory_order_relaxed) == UINT64_MAX)
+                {
+                    auto freeFrameCount = (StreamFrameCount - uint32_t(writeIndex - readIndex.load(std::memory_order_acquire)));
+                    auto ringFrame = uint32_t(writeIndex & (StreamFrameCount - 1));
+                    auto frameCount = std::min({ freeFrameCount, (StreamFrameCount - ringFrame), DecodeFrameCount });
+                    if (frameCount == 0)
+                    {
+                        break;
+                    }
+
+                    auto position = decoder->getPosition();
+                    auto loopStartFrame = this->loopStartFrame.load(std::memory_order_relaxed);
+                    auto loopEndFrame = this->loopEndFrame.load(std::memory_order_relaxed);
+                    bool loopRange = (loopEndFrame > loopStartFrame && loopEndFrame <= decoder->getFrameCount());
+                    bool looping = this->looping.load(std::memory_order_relaxed);
+                    auto endFrame = ((looping && loopRange && position <= loopEndFrame) ? loopEndFrame : decoder->getFrameCount());
+                    frameCount = std::min(frameCount, (endFrame - std::min(endFrame, position)));
+                    if (frameCount == 0)
+                    {
+                        if (looping && decoder->getFrameCount() > 0)
+                        {
+                            decoder->seek(loopRange ? loopStartFrame : 0);
+                            continue;
+                        }
+
+                        endIndex.store(writeIndex, std::memory_order_release);
+                        break;
+                    }
+
+                    writeIndex += decoder->read((ringBuffer.data() + ringFrame * channelCount), frameCount);
+                    this->writeIndex.store(writeIndex, std::memory_order_release);
+                }
+
+                refillQueued.store(false, std::memory_order_release);
+            }
+        };
+
+        // Software mixer, to a null or wave file output
+        //  - sounds are handles to slots in a pool of voices, the voice state is kept in flat lists
+        //  - gains are computed for every voice at once each update, from the listener and the voice positions
+        //  - the loudest voices, up to the budget, are mixed, the rest only advance their position
+        //  - mixing happens on the thread that calls update, and buffers are mixed at their own rate
+        //  - streams are decoded on a separate thread, the mixer only asks for a refill once a ring is half empty
+        GEK_CONTEXT_USER(Device, std::string)
+            , public Audio::Device
+        {
+            enum Flags : uint8_t
+            {
+                Used = 1 << 0,
+                Playing = 1 << 1,
+                Looping = 1 << 2,
+                Positional = 1 << 3,
+                Virtual = 1 << 4,
+            };
+
+            class Stream
+                : public Audio::Stream
+            {
+            public:
+                Device *device;
+                std::shared_ptr<StreamState> state;
+
+                // Seeks the mixer has caught up with
+                uint32_t seekCompleteCount = 0;
+
+            public:
+                Stream(Device *device, std::unique_ptr<Decoder> &&decoder)
+                    : device(device)
+                    , state(std::make_shared<StreamState>(std::move(decoder)))
+                {
+                }
+
+                // Skips frames decoded before the last seek, returns false until the decode thread has caught up
+                bool synchronize(void)
+                {
+                    auto seekCompleteCount = state->seekCompleteCount.load(std::memory_order_acquire);
+                    if (seekCompleteCount != this->seekCompleteCount)
+                    {
+                        this->seekCompleteCount = seekCompleteCount;
+                        state->readIndex.store(state->seekIndex.load(std::memory_order_relaxed), std::memory_order_release);
+                    }
+
+                    return (state->seekRequestCount.load(std::memory_order_relaxed) == seekCompleteCount);
+                }
+
+                // Audio::Stream
+                uint32_t getSampleRate(void) const
+                {
+                    return state->decoder->getSampleRate();
+                }
+
+                uint32_t getChannelCount(void) const
+                {
+                    return state->channelCount;
+                }
+
+                uint32_t getFrameCount(void) const
+                {
+                    return state->decoder->getFrameCount();
+                }
+
+                void setLoopPoints(uint32_t startFrame, uint32_t endFrame)
+                {
+                    state->loopStartFrame.store(startFrame, std::memory_order_relaxed);
+                    state->loopEndFrame.store(endFrame, std::memory_order_relaxed);
+                }
+
+                void seek(uint32_t frame)
+                {
+                    state->seekFrame.store(frame, std::memory_order_relaxed);
+                    state->seekRequestCount.fetch_add(1, std::memory_order_release);
+                    device->requestRefill(this);
+                }
+            };
+
+            class Sound
+                : public Audio::Sound
+            {
+            private:
+                Device *device;
+                uint32_t voice;
+
+            public:
+                Sound(Device *device, uint32_t voice)
+                    : device(device)
+                    , voice(voice)
+                {
+                }
+
+                ~Sound(void)
+                {
+                    device->releaseVoice(voice);
+                }
+
+                // Audio::Sound
+                void setBuffer(Audio::Buffer *buffer)
+                {
+                    device->bufferList[voice] = dynamic_cast<Buffer *>(buffer);
+                    device->streamList[voice] = nullptr;
+                    device->cursorList[voice] = 0.0;
+                }
+
+                void setStream(Audio::Stream *stream)
+                {
+                    device->bufferList[voice] = nullptr;
+                    device->streamList[voice] = dynamic_cast<Stream *>(stream);
+                    device->cursorList[voice] = 0.0;
+                }
+
+                void setVolume(float volume)
+                {
+                    device->volumeList[voice] = volume;
+                }
+
+                void setPriority(float priority)
+                {
+                    device->priorityList[voice] = priority;
+                }
+
+                void setDistance(float minimum, float maximum)
+                {
+                    device->minimumDistanceList[voice] = minimum;
+                    device->maximumDistanceList[voice] = std::max(maximum, minimum);
+                }
+
+                void setPosition(Math::Float3 const &position)
+                {
+                    device->positionXList[voice] = position.x;
+                    device->positionYList[voice] = position.y;
+                    device->positionZList[voice] = position.z;
+                }
+
+                void play(bool loop)
+                {
+                    device->playVoice(voice, loop, false);
+                }
+
+                void play(Math::Float3 const &origin, bool loop)
+                {
+                    setPosition(origin);
+                    device->playVoice(voice, loop, true);
+                }
+
+                void stop(void)
+                {
+                    device->stopVoice(voice);
+                }
+
+                bool isPlaying(void) const
+                {
+                    return ((device->flagsList[voice] & Playing) != 0);
+                }
+
+                bool isVirtual(void) const
+                {
+                    return ((device->flagsList[voice] & Virtual) != 0);
+                }
+            };
+
+        private:
+            std::unique_ptr<Output> output;
+            float volume = 1.0f;
+            uint32_t voiceBudget = DefaultVoiceBudget;
+            Math::Float3 listenerPosition = Math::Float3::Zero;
+            Math::Float3 listenerRight = Math::Float3(1.0f, 0.0f, 0.0f);
+            double pendingFrameCount = 0.0;
+
+            VoiceList<Buffer *> bufferList;
+            VoiceList<Stream *> streamList;
+            VoiceList<double> cursorList;
+            VoiceList<float> volumeList;
+            VoiceList<float> priorityList;
+            VoiceList<float> minimumDistanceList;
+            VoiceList<float> maximumDistanceList;
+            VoiceList<float> positionXList, positionYList, positionZList;
+            VoiceList<float> gainLeftList, gainRightList;
+            VoiceList<float> audibilityList;
+            VoiceList<uint8_t> flagsList;
+            VoiceList<uint32_t> freeVoiceList;
+            VoiceList<uint32_t> playingVoiceList;
+            uint32_t virtualVoiceCount = 0;
+
+            SampleList mixBuffer;
+            ThreadPool decodePool;
+
+        public:
+            // Writes to a wave file when given a path, otherwise the mix is discarded
+            Device(Context *context, std::string outputFileName)
+                : ContextRegistration(context)
+                , mixBuffer(BlockFrameCount * ChannelCount)
+            {
+                if (!outputFileName.empty())
+                {
+                    auto waveOutput = std::make_unique<WaveOutput>(FileSystem::Path(outputFileName));
+                    if (waveOutput->isOpen())
+                    {
+                        output = std::move(waveOutput);
+                    }
+                }
+
+                if (!output)
+                {
+                    output = std::make_unique<NullOutput>();
+                }
+            }
+
+            uint32_t acquireVoice(void)
+            {
+                uint32_t voice;
+                if (freeVoiceList.empty())
+                {
+                    voice = uint32_t(flagsList.size());
+                    auto voiceCount = (voice + 1);
+                    bufferList.resize(voiceCount);
+                    streamList.resize(voiceCount);
+                    cursorList.resize(voiceCount);
+                    volumeList.resize(voiceCount);
+                    priorityList.resize(voiceCount);
+                    minimumDistanceList.resize(voiceCount);
+                    maximumDistanceList.resize(voiceCount);
+                    positionXList.resize(voiceCount);
+                    positionYList.resize(voiceCount);
+                    positionZList.resize(voiceCount);
+                    gainLeftList.resize(voiceCount);
+                    gainRightList.resize(voiceCount);
+                    audibilityList.resize(voiceCount);
+                    flagsList.resize(voiceCount);
+                }
+                else
+                {
+                    voice = freeVoiceList.back();
+                    freeVoiceList.pop_back();
+                }
+
+                bufferList[voice] = nullptr;
+                streamList[voice] = nullptr;
+                cursorList[voice] = 0.0;
+                volumeList[voice] = 1.0f;
+                priorityList[voice] = 1.0f;
+                minimumDistanceList[voice] = 1.0f;
+                maximumDistanceList[voice] = 100.0f;
+                positionXList[voice] = positionYList[voice] = positionZList[voice] = 0.0f;
+                gainLeftList[voice] = gainRightList[voice] = audibilityList[voice] = 0.0f;
+                flagsList[voice] = Used;
+                return voice;
+            }
+
+            void releaseVoice(uint32_t voice)
+            {
+                bufferList[voice] = nullptr;
+                streamList[voice] = nullptr;
+                flagsList[voice] = 0;
+                freeVoiceList.push_back(voice);
+            }
+
+            void playVoice(uint32_t voice, bool loop, bool positional)
+            {
+                auto &flags = flagsList[voice];
+                if (!(flags & Playing))
+                {
+                    cursorList[voice] = 0.0;
+                }
+
+                flags = uint8_t((flags & ~(Looping | Positional)) | Playing | (loop ? Looping : 0) | (positional ? Positional : 0));
+                if (streamList[voice])
+                {
+                    streamList[voice]->state->looping.store(loop, std::memory_order_relaxed);
+                    requestRefill(streamList[voice]);
+                }
+            }
+
+            void stopVoice(uint32_t voice)
+            {
+                flagsList[voice] &= ~(Playing | Virtual);
+                cursorList[voice] = 0.0;
+                if (streamList[voice])
+                {
+                    streamList[voice]->seek(0);
+                }
+            }
+
+            void requestRefill(Stream *stream)
+            {
+                if (!stream->state->refillQueued.exchange(true, std::memory_order_acq_rel))
+                {
+                    decodePool.enqueueAndDetach([state = stream->state](void) -> void
+                    {
+                        state->refill();
+                    });
+                }
+            }
+
+            // Linear rolloff between the minimum and maximum distance, with constant power panning across the listener's right axis
+            void updateGains(void)
+            {
+                auto voiceCount = flagsList.size();
+                for (size_t voice = 0; voice < voiceCount; ++voice)
+                {
+                    float deltaX = (positionXList[voice] - listenerPosition.x);
+                    float deltaY = (positionYList[voice] - listenerPosition.y);
+                    float deltaZ = (positionZList[voice] - listenerPosition.z);
+                    float distance = std::sqrt(deltaX * deltaX + deltaY * deltaY + deltaZ * deltaZ);
+                    float range = std::max((maximumDistanceList[voice] - minimumDistanceList[voice]), 1.0e-3f);
+                    float attenuation = std::min(1.0f, std::max(0.0f, ((maximumDistanceList[voice] - distance) / range)));
+                    float pan = std::min(1.0f, std::max(-1.0f, ((deltaX * listenerRight.x + deltaY * listenerRight.y + deltaZ * listenerRight.z) / std::max(distance, 1.0e-3f))));
+                    bool positional = ((flagsList[voice] & Positional) != 0);
+                    attenuation = (positional ? attenuation : 1.0f);
+                    pan = (positional ? pan : 0.0f);
+
+                    float gain = (volumeList[voice] * attenuation);
+                    gainLeftList[voice] = (gain * std::sqrt(0.5f * (1.0f - pan)));
+                    gainRightList[voice] = (gain * std::sqrt(0.5f * (1.0f + pan)));
+                    audibilityList[voice] = (std::max(gainLeftList[voice], gainRightList[voice]) * priorityList[voice]);
+                }
+            }
+
+            // Silent voices, and the quietest voices past the budget, are virtualized
+            void selectVoices(void)
+            {
+                playingVoiceList.clear();
+                auto voiceCount = uint32_t(flagsList.size());
+                for (uint32_t voice = 0; voice < voiceCount; ++voice)
+                {
+                    if (flagsList[voice] & Playing)
+                    {
+                        playingVoiceList.push_back(voice);
+                    }
+                }
+
+                auto audibleEnd = std::partition(std::begin(playingVoiceList), std::end(playingVoiceList), [this](uint32_t voice) -> bool
+                {
+                    return (audibilityList[voice] > 0.0f);
+                });
+
+                auto audibleCount = uint32_t(std::distance(std::begin(playingVoiceList), audibleEnd));
+                if (audibleCount > voiceBudget)
+                {
+                    std::nth_element(std::begin(playingVoiceList), (std::begin(playingVoiceList) + voiceBudget), audibleEnd, [this](uint32_t leftVoice, uint32_t rightVoice) -> bool
+                    {
+                        return (audibilityList[leftVoice] > audibilityList[rightVoice]);
+                    });
+
+                    audibleCount = voiceBudget;
+                }
+
+                virtualVoiceCount = (uint32_t(playingVoiceList.size()) - audibleCount);
+
+                for (uint32_t index = 0; index < playingVoiceList.size(); ++index)
+                {
+                    auto &flags = flagsList[playingVoiceList[index]];
+                    flags = uint8_t(index < audibleCount ? (flags & ~Virtual) : (flags | Virtual));
+                }
+            }
+
+            // Plays silence while a seek is pending or the decode thread has fallen behind
+            bool mixStream(uint32_t voice, uint32_t frameCount)
+            {
+                auto stream = streamList[voice];
+                if (!stream->synchronize())
+                {
+                    // A refill already running when the seek was requested may have missed it
+                    requestRefill(stream);
+                    return true;
+                }
+
+                auto &state = *stream->state;
+                auto channelCount = state.channelCount;
+                auto ringBuffer = state.ringBuffer.data();
+                auto readIndex = state.readIndex.load(std::memory_order_relaxed);
+                auto writeIndex = state.writeIndex.load(std::memory_order_acquire);
+                double step = (double(stream->getSampleRate()) / double(SampleRate));
+                double &cursor = cursorList[voice];
+                if (flagsList[voice] & Virtual)
+                {
+                    cursor += (step * frameCount);
+                    auto frameStep = uint64_t(cursor);
+                    cursor -= double(frameStep);
+                    readIndex = std::min((readIndex + frameStep), writeIndex);
+                }
+                else
+                {
+                    float gainLeft = gainLeftList[voice];
+                    float gainRight = gainRightList[voice];
+                    float *target = mixBuffer.data();
+                    if (stream->getSampleRate() == SampleRate)
+                    {
+                        while (frameCount > 0 && readIndex < writeIndex)
+                        {
+                            auto ringFrame = uint32_t(readIndex & (StreamFrameCount - 1));
+                            auto count = uint32_t(std::min({ uint64_t(frameCount), (writeIndex - readIndex), uint64_t(StreamFrameCount - ringFrame) }));
+                            MixFrames((ringBuffer + ringFrame * channelCount), channelCount, count, gainLeft, gainRight, target);
+                            target += (count * ChannelCount);
+                            frameCount -= count;
+                            readIndex += count;
+                        }
+                    }
+                    else
+                    {
+                        for (uint32_t frame = 0; frame < frameCount && readIndex < writeIndex; ++frame)
+                        {
+                            auto current = (ringBuffer + uint32_t(readIndex & (StreamFrameCount - 1)) * channelCount);
+                            auto next = (ringBuffer + uint32_t(std::min((readIndex + 1), (writeIndex - 1)) & (StreamFrameCount - 1)) * channelCount);
+                            float fraction = float(cursor);
+                            target[frame * 2 + 0] += ((current[0] + (next[0] - current[0]) * fraction) * gainLeft);
+                            target[frame * 2 + 1] += ((current[channelCount - 1] + (next[channelCount - 1] - current[channelCount - 1]) * fraction) * gainRight);
+
+                            cursor += step;
+                            auto frameStep = uint64_t(cursor);
+                            cursor -= double(frameStep);
+                            readIndex = std::min((readIndex + frameStep), writeIndex);
+                        }
+                    }
+                }
+
+                state.readIndex.store(readIndex, std::memory_order_release);
+                auto endIndex = state.endIndex.load(std::memory_order_acquire);
+                if (readIndex >= endIndex)
+                {
+                    return false;
+                }
+
+                if (endIndex == UINT64_MAX && (writeIndex - readIndex) < (StreamFrameCount / 2))
+                {
+                    requestRefill(stream);
+                }
+
+                return true;
+            }
+
+            // Returns false once a voice that isn't looping reaches the end of its buffer or stream
+            bool mixVoice(uint32_t voice, uint32_t frameCount)
+            {
+                if (streamList[voice])
+                {
+                    return mixStream(voice, frameCount);
+                }
+
+                auto buffer = bufferList[voice];
+                if (!buffer || buffer->frameCount == 0)
+                {
+                    return false;
+                }
+
+                auto flags = flagsList[voice];
+                bool loop = ((flags & Looping) != 0);
+                double step = (double(buffer->sampleRate) / double(SampleRate));
+                double bufferFrameCount = double(buffer->frameCount);
+                double &cursor = cursorList[voice];
+                if (flags & Virtual)
+                {
+                    cursor += (step * frameCount);
+                    if (cursor >= bufferFrameCount)
+                    {
+                        if (!loop)
+                        {
+                            return false;
+                        }
+
+                        cursor = std::fmod(cursor, bufferFrameCount);
+                    }
+
+                    return true;
+                }
+
+                float gainLeft = gainLeftList[voice];
+                float gainRight = gainRightList[voice];
+                float *target = mixBuffer.data();
+                if (buffer->sampleRate == SampleRate)
+                {
+                    auto position = uint32_t(cursor);
+                    while (frameCount > 0)
+                    {
+                        auto count = std::min(frameCount, (buffer->frameCount - position));
+                        MixFrames((buffer->sampleList.data() + position * buffer->channelCount), buffer->channelCount, count, gainLeft, gainRight, target);
+                        target += (count * ChannelCount);
+                        frameCount -= count;
+                        position += count;
+                        if (position >= buffer->frameCount)
+                        {
+                            if (!loop)
+                            {
+                                return false;
+                            }
+
+                            position = 0;
+                        }
+                    }
+
+                    cursor = double(position);
+                    return true;
+                }
+
+                // Linearly interpolated, for buffers at other rates
+                auto channelCount = buffer->channelCount;
+                auto sampleList = buffer->sampleList.data();
+                for (uint32_t frame = 0; frame < frameCount; ++frame)
+                {
+                    auto position = uint32_t(cursor);
+                    auto nextPosition = (position + 1);
+                    if (nextPosition >= buffer->frameCount)
+                    {
+                        nextPosition = (loop ? 0 : position);
+                    }
+
+                    float fraction = float(cursor - double(position));
+                    float left = sampleList[position * channelCount];
+                    float nextLeft = sampleList[nextPosition * channelCount];
+                    float right = sampleList[position * channelCount + channelCount - 1];
+                    float nextRight = sampleList[nextPosition * channelCount + channelCount - 1];
+                    target[frame * 2 + 0] += ((left + (nextLeft - left) * fraction) * gainLeft);
+                    target[frame * 2 + 1] += ((right + (nextRight - right) * fraction) * gainRight);
+
+                    cursor += step;
+                    if (cursor >= bufferFrameCount)
+                    {
+                        if (!loop)
+                        {
+                            return false;
+                        }
+
+                        cursor -= bufferFrameCount;
+                    }
+                }
+
+                return true;
+            }
+
+            void mixBlock(uint32_t frameCount)
+            {
+                std::fill(std::begin(mixBuffer), (std::begin(mixBuffer) + frameCount * ChannelCount), 0.0f);
+                for (auto voice : playingVoiceList)
+                {
+                    if ((flagsList[voice] & Playing) && !mixVoice(voice, frameCount))
+                    {
+                        stopVoice(voice);
+                    }
+                }
+
+                FinishFrames(volume, (frameCount * ChannelCount), mixBuffer.data());
+                output->write(mixBuffer.data(), frameCount);
+            }
+
+            // Audio::Device
+            void setVolume(float volume)
+            {
+                this->volume = volume;
+            }
+
+            float getVolume(void)
+            {
+                return volume;
+            }
+
+            void setListener(Math::Float4x4 const &matrix)
+            {
+                listenerPosition = matrix.translation.xyz;
+                listenerRight = matrix.rx.xyz;
+            }
+
+            void setVoiceBudget(uint32_t voiceCount)
+            {
+                voiceBudget = voiceCount;
+            }
+
+            Audio::BufferPtr loadBuffer(FileSystem::Path const &filePath)
+            {
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+                auto decoder = OpenDecoder(filePath);
+                if (!decoder)
+                {
+                    return nullptr;
+                }
+
+                auto buffer = std::make_unique<Buffer>();
+                buffer->sampleRate = decoder->getSampleRate();
+                buffer->channelCount = decoder->getChannelCount();
+                buffer->frameCount = decoder->getFrameCount();
+                buffer->sampleList.resize(buffer->frameCount * buffer->channelCount);
+                decoder->read(buffer->sampleList.data(), buffer->frameCount);
+                return buffer;
+            }
+
+            Audio::BufferPtr createBuffer(uint32_t sampleRate, uint32_t channelCount, uint32_t frameCount, float const *sampleList)
+            {
+                if (sampleRate == 0 || channelCount < 1 || channelCount > 2 || !sampleList)
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unable to create audio buffer with %v channels at %v hertz", channelCount, sampleRate);
+                    return nullptr;
+                }
+
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+                auto buffer = std::make_unique<Buffer>();
+                buffer->sampleRate = sampleRate;
+                buffer->channelCount = channelCount;
+                buffer->frameCount = frameCount;
+                buffer->sampleList.assign(sampleList, (sampleList + frameCount * channelCount));
+                return buffer;
+            }
+
+            Audio::StreamPtr openStream(FileSystem::Path const &filePath)
+            {
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+                auto decoder = OpenDecoder(filePath);
+                if (!decoder)
+                {
+                    return nullptr;
+                }
+
+                auto stream = std::make_unique<Stream>(this, std::move(decoder));
+                requestRefill(stream.get());
+                return stream;
+            }
+
+            Audio::SoundPtr createSound(void)
+            {
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+                return std::make_unique<Sound>(this, acquireVoice());
+            }
+
+            void update(float frameTime)
+            {
+                GEK_PROFILE_ZONE("Audio Mix");
+                Memory::Scope memoryScope(Memory::Tag::Audio);
+
+                pendingFrameCount += (double(frameTime) * SampleRate);
+                auto frameCount = uint32_t(pendingFrameCount);
+                pendingFrameCount -= frameCount;
+                if (frameCount == 0)
+                {
+                    return;
+                }
+
+                updateGains();
+                selectVoices();
+                GEK_PROFILE_COUNTER("Audio Voices", playingVoiceList.size());
+                GEK_PROFILE_COUNTER("Audio Virtual Voices", virtualVoiceCount);
+                while (frameCount > 0)
+                {
+                    auto blockFrameCount = std::min(frameCount, BlockFrameCount);
+                    mixBlock(blockFrameCount);
+                    frameCount -= blockFrameCount;
+                }
+            }
+        };
+
+        GEK_REGISTER_CONTEXT_USER(Device);
+    }; // namespace Software
+}; // namespace Gek
@@ -63,9 +63,23 @@ namespace Gek
         GEK_DECLARE_CONTEXT_USER(Device);
     };
 
+    namespace Software
+    {
+        GEK_DECLARE_CONTEXT_USER(Device);
+    };
+
+    namespace Null
+    {
+        GEK_DECLARE_CONTEXT_USER(Window);
+        GEK_DECLARE_CONTEXT_USER(Device);
+    };
+
     GEK_CONTEXT_BEGIN(System);
         GEK_CONTEXT_ADD_CLASS(Default::System::Window, Win32::Window);
 		GEK_CONTEXT_ADD_CLASS(Default::Device::Audio, DirectSound8::Device);
         GEK_CONTEXT_ADD_CLASS(Default::Device::Video, Direct3D11::Device);
+        GEK_CONTEXT_ADD_CLASS(Null::System::Window, Null::Window);
+        GEK_CONTEXT_ADD_CLASS(Null::Device::Video, Null::Device);
+        GEK_CONTEXT_ADD_CLASS(Software::Device::Audio, Software::Device);
     GEK_CONTEXT_END();
 }; // namespace Gek
\ No newline at end of file
@@ -0,0 +1,227 @@
+#include "Benchmark.hpp"
+#include "GEK/Math/Common.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Context.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/System/AudioDevice.hpp"
+#include <random>
+#include <chrono>
+#include <thread>
+#include <cstring>
+#include <cmath>
+
+using namespace Gek;
+
+// A minute of 16 bit stereo tone, written once per run to the system's temporary directory
+static FileSystem::Path const &GetTrackPath(void)
+{
+    static FileSystem::Path filePath;
+    if (filePath.empty())
+    {
+        static const uint32_t SampleRate = 48000;
+        static const uint32_t FrameCount = (SampleRate * 60);
+        std::vector<uint8_t> file(44 + FrameCount * 4);
+        auto write = [&file](size_t offset, auto value) -> void
+        {
+            std::memcpy(file.data() + offset, &value, sizeof(value));
+        };
+
+        std::memcpy(file.data() + 0, "RIFF", 4);
+        write(4, uint32_t(file.size() - 8));
+        std::memcpy(file.data() + 8, "WAVEfmt ", 8);
+        write(16, uint32_t(16));
+        write(20, uint16_t(1));
+        write(22, uint16_t(2));
+        write(24, SampleRate);
+        write(28, uint32_t(SampleRate * 4));
+        write(32, uint16_t(4));
+        write(34, uint16_t(16));
+        std::memcpy(file.data() + 36, "data", 4);
+        write(40, uint32_t(FrameCount * 4));
+        for (uint32_t frame = 0; frame < FrameCount; ++frame)
+        {
+            auto sample = int16_t(16000.0f * std::sin(Math::Tau * 110.0f * float(frame) / float(SampleRate)));
+            write((44 + frame * 4), sample);
+            write((46 + frame * 4), sample);
+        }
+
+        filePath = FileSystem::GetFileName(FileSystem::Path(std::experimental::filesystem::temp_directory_path()), "gek_benchmarks", "track.wav");
+        FileSystem::Save(filePath, file);
+    }
+
+    return filePath;
+}
+
+// Software mixer with its null output, so only the mixing is measured
+struct AudioMixer
+{
+    ContextPtr context;
+    Audio::DevicePtr device;
+
+    static AudioMixer *Get(Benchmark::State &state)
+    {
+        static std::unique_ptr<AudioMixer> mixer;
+        static bool created = false;
+        if (!created)
+        {
+            created = true;
+            mixer = std::make_unique<AudioMixer>();
+            if (!mixer->create())
+            {
+                mixer.reset();
+            }
+        }
+
+        if (!mixer)
+        {
+            state.skipWithError("Unable to create software audio device, plugins need to be built next to the benchmarks");
+        }
+
+        return mixer.get();
+    }
+
+    bool create(void)
+    {
+        auto pluginPath(FileSystem::GetModuleFilePath().getParentPath());
+
+        std::vector<FileSystem::Path> searchPathList;
+        searchPathList.push_back(pluginPath);
+
+        context = Context::Create(pluginPath.getParentPath(), searchPathList);
+        if (!context)
+        {
+            return false;
+        }
+
+        device = context->createClass<Audio::Device>("Software::Device::Audio", std::string());
+        return (device != nullptr);
+    }
+
+    // Two seconds of a tone, so looping voices wrap a few times a second of mixing
+    Audio::BufferPtr createTone(uint32_t sampleRate, uint32_t channelCount, float frequency)
+    {
+        auto frameCount = (sampleRate * 2);
+        std::vector<float> sampleList(frameCount * channelCount);
+        for (uint32_t frame = 0; frame < frameCount; ++frame)
+        {
+            float sample = std::sin(Math::Tau * frequency * float(frame) / float(sampleRate));
+            for (uint32_t channel = 0; channel < channelCount; ++channel)
+            {
+                sampleList[frame * channelCount + channel] = sample;
+            }
+        }
+
+        return device->createBuffer(sampleRate, channelCount, frameCount, sampleList.data());
+    }
+};
+
+// 256 looping voices, half mono and half stereo, spread around the listener and all within range,
+// mixed with the budget given as the argument so the rest are virtualized
+static void Audio_Mix(Benchmark::State &state, uint32_t sampleRate)
+{
+    auto mixer = AudioMixer::Get(state);
+    if (!mixer)
+    {
+        return;
+    }
+
+    static const uint32_t VoiceCount = 256;
+    static const float FrameTime = (1.0f / 60.0f);
+
+    auto monoBuffer = mixer->createTone(sampleRate, 1, 440.0f);
+    auto stereoBuffer = mixer->createTone(sampleRate, 2, 220.0f);
+
+    std::mt19937 mersineTwister(7151980);
+    std::uniform_real_distribution<float> positionDistribution(-50.0f, 50.0f);
+    std::uniform_real_distribution<float> volumeDistribution(0.1f, 1.0f);
+    std::vector<Audio::SoundPtr> soundList;
+    for (uint32_t voice = 0; voice < VoiceCount; ++voice)
+    {
+        auto sound = mixer->device->createSound();
+        sound->setBuffer((voice & 1) ? stereoBuffer.get() : monoBuffer.get());
+        sound->setVolume(volumeDistribution(mersineTwister));
+        sound->setDistance(1.0f, 200.0f);
+        sound->play(Math::Float3(positionDistribution(mersineTwister), positionDistribution(mersineTwister), positionDistribution(mersineTwister)), true);
+        soundList.push_back(std::move(sound));
+    }
+
+    mixer->device->setListener(Math::Float4x4::Identity);
+    mixer->device->setVoiceBudget(uint32_t(state.getArgument()));
+    for (auto _ : state)
+    {
+        mixer->device->update(FrameTime);
+    }
+
+    uint32_t virtualVoiceCount = 0;
+    for (auto const &sound : soundList)
+    {
+        virtualVoiceCount += (sound->isVirtual() ? 1 : 0);
+    }
+
+    state.counters["voices"] = double(VoiceCount);
+    state.counters["virtual_voices"] = double(virtualVoiceCount);
+    state.setItemsProcessed(state.getIterationCount() * uint64_t(FrameTime * 48000.0f));
+}
+
+static void Audio_Mix_256Voices(Benchmark::State &state)
+{
+    Audio_Mix(state, 48000);
+}
+
+// Buffers at a different rate than the device take the interpolated path
+static void Audio_Mix_256Voices_Resampled(Benchmark::State &state)
+{
+    Audio_Mix(state, 44100);
+}
+
+GEK_BENCHMARK(Audio_Mix_256Voices)->arguments({ 64, 256 });
+GEK_BENCHMARK(Audio_Mix_256Voices_Resampled)->arguments({ 64, 256 });
+
+// Long tracks streamed from disk, updated at sixty frames a second so the decode thread runs in real time,
+// only the mixer's time on the calling thread is measured
+static void Audio_Mix_Streams(Benchmark::State &state)
+{
+    auto mixer = AudioMixer::Get(state);
+    if (!mixer)
+    {
+        return;
+    }
+
+    static const float FrameTime = (1.0f / 60.0f);
+
+    std::vector<Audio::StreamPtr> streamList;
+    std::vector<Audio::SoundPtr> soundList;
+    for (int64_t track = 0; track < state.getArgument(); ++track)
+    {
+        auto stream = mixer->device->openStream(GetTrackPath());
+        if (!stream)
+        {
+            state.skipWithError("Unable to open streaming track");
+            return;
+        }
+
+        stream->seek(uint32_t(track * 48000));
+
+        auto sound = mixer->device->createSound();
+        sound->setStream(stream.get());
+        sound->play(true);
+        streamList.push_back(std::move(stream));
+        soundList.push_back(std::move(sound));
+    }
+
+    mixer->device->setVoiceBudget(uint32_t(state.getArgument()));
+    auto nextFrame = std::chrono::steady_clock::now();
+    for (auto _ : state)
+    {
+        mixer->device->update(FrameTime);
+
+        state.pauseTiming();
+        nextFrame += std::chrono::microseconds(16667);
+        std::this_thread::sleep_until(nextFrame);
+        state.resumeTiming();
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * uint64_t(FrameTime * 48000.0f));
+}
+
+GEK_BENCHMARK(Audio_Mix_Streams)->arguments({ 16 });
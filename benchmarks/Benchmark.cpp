@@ -0,0 +1,358 @@
+#include "Benchmark.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONView.hpp"
+#include <algorithm>
+#include <iomanip>
+#include <memory>
+#include <thread>
+#include <regex>
+
+namespace Gek
+{
+    namespace Benchmark
+    {
+        static const uint64_t MaximumIterationCount = 1000000000;
+
+        State::State(uint64_t iterationCount, int64_t argument)
+            : iterationCount(iterationCount)
+            , argument(argument)
+        {
+        }
+
+        void State::pauseTiming(void)
+        {
+            if (running)
+            {
+                realTime += std::chrono::duration<double>(Clock::now() - startTime).count();
+                cpuTime += (double(std::clock() - startClock) / double(CLOCKS_PER_SEC));
+                running = false;
+            }
+        }
+
+        void State::resumeTiming(void)
+        {
+            if (!running)
+            {
+                running = true;
+                startClock = std::clock();
+                startTime = Clock::now();
+            }
+        }
+
+        void UseCharPointer(char const volatile *value)
+        {
+        }
+
+        static std::vector<std::unique_ptr<Definition>> &GetDefinitionList(void)
+        {
+            static std::vector<std::unique_ptr<Definition>> definitionList;
+            return definitionList;
+        }
+
+        Definition *Register(std::string const &name, Function function)
+        {
+            auto &definitionList = GetDefinitionList();
+            definitionList.push_back(std::make_unique<Definition>());
+            auto definition = definitionList.back().get();
+            definition->name = name;
+            definition->function = function;
+            return definition;
+        }
+
+        struct Result
+        {
+            std::string name;
+            uint64_t iterationCount = 0;
+
+            // Nanoseconds per iteration
+            double realTime = 0.0;
+            double cpuTime = 0.0;
+
+            double itemsPerSecond = 0.0;
+            std::map<std::string, double> counters;
+            std::string errorMessage;
+            bool failed = false;
+        };
+
+        static Result Run(Definition const &definition, std::string const &name, int64_t argument, double minimumTime)
+        {
+            Result result;
+            result.name = name;
+
+            // Start with a single iteration and grow the count until a run takes at least the minimum time
+            uint64_t iterationCount = (definition.fixedIterationCount > 0 ? definition.fixedIterationCount : 1);
+            while (true)
+            {
+                State state(iterationCount, argument);
+                definition.function(state);
+                if (!state.getErrorMessage().empty())
+                {
+                    result.errorMessage = state.getErrorMessage();
+                    result.failed = state.hasFailed();
+                    return result;
+                }
+
+                double measuredTime = (definition.manualTime ? state.getManualTime() : state.getRealTime());
+                if (definition.fixedIterationCount > 0 || measuredTime >= minimumTime || iterationCount >= MaximumIterationCount)
+                {
+                    result.iterationCount = iterationCount;
+                    result.realTime = (measuredTime * 1.0e9 / double(iterationCount));
+                    result.cpuTime = (state.getCPUTime() * 1.0e9 / double(iterationCount));
+                    result.itemsPerSecond = (measuredTime > 0.0 ? (double(state.getItemsProcessed()) / measuredTime) : 0.0);
+                    result.counters = state.counters;
+                    return result;
+                }
+
+                double multiplier = (measuredTime > 0.0 ? std::min(((minimumTime * 1.4) / measuredTime), 10.0) : 10.0);
+                iterationCount = std::min(std::max((iterationCount + 1), uint64_t(double(iterationCount) * multiplier)), MaximumIterationCount);
+            };
+        }
+
+        static JSON::Object GetResultObject(Result const &result)
+        {
+            JSON::Object object;
+            object["name"] = result.name;
+            object["run_name"] = result.name;
+            object["run_type"] = "iteration";
+            if (result.errorMessage.empty())
+            {
+                object["iterations"] = result.iterationCount;
+                object["real_time"] = result.realTime;
+                object["cpu_time"] = result.cpuTime;
+                object["time_unit"] = "ns";
+                if (result.itemsPerSecond > 0.0)
+                {
+                    object["items_per_second"] = result.itemsPerSecond;
+                }
+
+                for (auto const &counter : result.counters)
+                {
+                    object[counter.first] = counter.second;
+                }
+            }
+            else
+            {
+                object["error_occurred"] = true;
+                object["error_message"] = result.errorMessage;
+            }
+
+            return object;
+        }
+
+        static std::map<std::string, double> LoadBaseline(FileSystem::Path const &filePath)
+        {
+            std::map<std::string, double> baselineMap;
+            auto document = JSON::Document::Load(filePath);
+            for (auto benchmarkNode : document.getRoot().get("benchmarks").getArray())
+            {
+                if (!benchmarkNode.has("error_occurred"))
+                {
+                    baselineMap[std::string(benchmarkNode.get("name").getString())] = benchmarkNode.get("real_time").getNumber(0.0);
+                }
+            }
+
+            return baselineMap;
+        }
+
+        int Main(int argumentCount, char const * const argumentList[])
+        {
+            std::string filter;
+            FileSystem::Path outputPath;
+            FileSystem::Path baselinePath;
+            double minimumTime = 0.5;
+            double threshold = 0.1;
+            bool updateBaseline = false;
+            for (int argumentIndex = 1; argumentIndex < argumentCount; ++argumentIndex)
+            {
+                std::string argument(argumentList[argumentIndex]);
+                auto separator = argument.find('=');
+                std::string name(argument.substr(0, separator));
+                std::string value(separator == std::string::npos ? std::string() : argument.substr(separator + 1));
+                if (name == "--benchmark_filter")
+                {
+                    filter = value;
+                }
+                else if (name == "--benchmark_out")
+                {
+                    outputPath = value;
+                }
+                else if (name == "--benchmark_min_time")
+                {
+                    minimumTime = String::Convert(value, minimumTime);
+                }
+                else if (name == "--baseline")
+                {
+                    baselinePath = value;
+                }
+                else if (name == "--threshold")
+                {
+                    threshold = String::Convert(value, threshold);
+                }
+                else if (name == "--update_baseline")
+                {
+                    updateBaseline = true;
+                }
+                else
+                {
+                    LockedWrite{ std::cerr } << String::Format("Unknown command line parameter: %v", argument);
+                    LockedWrite{ std::cerr } << "Usage: benchmarks [--benchmark_filter=<regex>] [--benchmark_out=<results.json>] [--benchmark_min_time=<seconds>] [--baseline=<baseline.json>] [--threshold=<fraction>] [--update_baseline]";
+                    return -__LINE__;
+                }
+            }
+
+            if (updateBaseline && baselinePath.empty())
+            {
+                LockedWrite{ std::cerr } << "A baseline needs to be specified to be updated";
+                return -__LINE__;
+            }
+
+            std::regex filterExpression(filter.empty() ? std::string(".*") : filter);
+            std::vector<Result> resultList;
+            for (auto const &definition : GetDefinitionList())
+            {
+                std::vector<std::pair<std::string, int64_t>> runList;
+                if (definition->argumentList.empty())
+                {
+                    runList.push_back(std::make_pair(definition->name, 0));
+                }
+                else
+                {
+                    for (auto argument : definition->argumentList)
+                    {
+                        runList.push_back(std::make_pair(String::Format("%v/%v", definition->name, argument), argument));
+                    }
+                }
+
+                for (auto const &run : runList)
+                {
+                    if (!std::regex_search(run.first, filterExpression))
+                    {
+                        continue;
+                    }
+
+                    auto result = Run(*definition, run.first, run.second, minimumTime);
+                    if (result.errorMessage.empty())
+                    {
+                        std::ostringstream counterStream;
+                        for (auto const &counter : result.counters)
+                        {
+                            counterStream << " " << counter.first << "=" << counter.second;
+                        }
+
+                        LockedWrite{ std::cout } << String::Format("%v: %vns real, %vns cpu, %v iterations%v", result.name, result.realTime, result.cpuTime, result.iterationCount, counterStream.str());
+                    }
+                    else
+                    {
+                        LockedWrite{ (result.failed ? std::cerr : std::cout) } << String::Format("%v: %v, %v", result.name, (result.failed ? "failed" : "skipped"), result.errorMessage);
+                    }
+
+                    resultList.push_back(result);
+                }
+            }
+
+            JSON::Object context;
+            context["executable"] = (argumentCount > 0 ? argumentList[0] : "");
+            context["num_cpus"] = std::thread::hardware_concurrency();
+#ifdef NDEBUG
+            context["library_build_type"] = "release";
+#else
+            context["library_build_type"] = "debug";
+#endif
+
+            JSON::Object benchmarks = JSON::EmptyArray;
+            for (auto const &result : resultList)
+            {
+                benchmarks.add(GetResultObject(result));
+            }
+
+            JSON::Object results;
+            results["context"] = context;
+            results["benchmarks"] = benchmarks;
+            if (!outputPath.empty())
+            {
+                JSON::Reference(results).save(outputPath);
+                LockedWrite{ std::cout } << String::Format("Results saved to %v", outputPath.u8string());
+            }
+
+            auto failedCount = std::count_if(std::begin(resultList), std::end(resultList), [](Result const &result) -> bool
+            {
+                return result.failed;
+            });
+
+            if (failedCount > 0)
+            {
+                LockedWrite{ std::cerr } << String::Format("%v benchmarks failed", failedCount);
+                return 1;
+            }
+
+            if (baselinePath.empty())
+            {
+                return 0;
+            }
+
+            if (updateBaseline)
+            {
+                JSON::Reference(results).save(baselinePath);
+                LockedWrite{ std::cout } << String::Format("Baseline updated: %v", baselinePath.u8string());
+                return 0;
+            }
+
+            // Once a baseline has been recorded every benchmark that ran needs an entry in it, new benchmarks fail
+            // the run until the baseline is updated, an empty baseline only warns so a fresh checkout still passes
+            auto baselineMap = LoadBaseline(baselinePath);
+            if (baselineMap.empty())
+            {
+                LockedWrite{ std::cerr } << String::Format("No baseline recorded yet in %v, run update_benchmark_baseline to record one", baselinePath.u8string());
+                return 0;
+            }
+
+            uint32_t regressionCount = 0;
+            uint32_t missingCount = 0;
+            for (auto const &result : resultList)
+            {
+                if (!result.errorMessage.empty())
+                {
+                    continue;
+                }
+
+                auto baselineSearch = baselineMap.find(result.name);
+                if (baselineSearch == std::end(baselineMap) || baselineSearch->second <= 0.0)
+                {
+                    ++missingCount;
+                    LockedWrite{ std::cerr } << String::Format("%v: not in baseline", result.name);
+                    continue;
+                }
+
+                double change = ((result.realTime - baselineSearch->second) / baselineSearch->second);
+                if (change > threshold)
+                {
+                    ++regressionCount;
+                    LockedWrite{ std::cerr } << String::Format("%v: regressed by %v percent (%vns, baseline %vns)", result.name, (change * 100.0), result.realTime, baselineSearch->second);
+                }
+                else if (change < -threshold)
+                {
+                    LockedWrite{ std::cout } << String::Format("%v: improved by %v percent (%vns, baseline %vns)", result.name, (-change * 100.0), result.realTime, baselineSearch->second);
+                }
+            }
+
+            if (missingCount > 0)
+            {
+                LockedWrite{ std::cerr } << String::Format("%v benchmarks missing from the baseline, run update_benchmark_baseline to record them", missingCount);
+            }
+
+            if (regressionCount > 0)
+            {
+                LockedWrite{ std::cerr } << String::Format("%v benchmarks regressed by more than %v percent", regressionCount, (threshold * 100.0));
+            }
+
+            return ((missingCount > 0 || regressionCount > 0) ? 1 : 0);
+        }
+    }; // namespace Benchmark
+}; // namespace Gek
+
+int main(int argumentCount, char const * const argumentList[])
+{
+    return Gek::Benchmark::Main(argumentCount, argumentList);
+}
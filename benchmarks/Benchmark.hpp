@@ -0,0 +1,234 @@
+/// @file
+/// @author Todd Zupan <toddzupan@gmail.com>
+/// @version $Revision$
+/// @section LICENSE
+/// https://en.wikipedia.org/wiki/MIT_License
+/// @section DESCRIPTION
+/// Last Changed: $Date$
+#pragma once
+
+#include <functional>
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <chrono>
+#include <ctime>
+#include <map>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+namespace Gek
+{
+    // Small benchmark harness that follows Google Benchmark's conventions, so results can be read by the same tools
+    //  - benchmarks loop over their state, for (auto _ : state) { ... }, and are run until they've taken the minimum time
+    //  - macro benchmarks that time a profiler zone instead of the whole loop report it with setIterationTime
+    //  - results are written in Google Benchmark's JSON format, and compared against a baseline in the same format
+    namespace Benchmark
+    {
+        class State
+        {
+        public:
+            struct Value
+            {
+            };
+
+            class Iterator
+            {
+            private:
+                State *state;
+                uint64_t remaining;
+
+            public:
+                Iterator(State *state, uint64_t remaining)
+                    : state(state)
+                    , remaining(remaining)
+                {
+                }
+
+                Value operator * (void) const
+                {
+                    return Value();
+                }
+
+                Iterator &operator ++ (void)
+                {
+                    --remaining;
+                    return (*this);
+                }
+
+                bool operator != (Iterator const &iterator) const
+                {
+                    if (remaining > 0)
+                    {
+                        return true;
+                    }
+
+                    state->pauseTiming();
+                    return false;
+                }
+            };
+
+        private:
+            using Clock = std::chrono::high_resolution_clock;
+
+            uint64_t iterationCount;
+            int64_t argument;
+
+            bool running = false;
+            Clock::time_point startTime;
+            std::clock_t startClock = 0;
+            double realTime = 0.0;
+            double cpuTime = 0.0;
+            double manualTime = 0.0;
+
+            uint64_t itemsProcessed = 0;
+            std::string errorMessage;
+            bool failed = false;
+
+        public:
+            // Extra values reported alongside the timings, as set by the benchmark
+            std::map<std::string, double> counters;
+
+        public:
+            State(uint64_t iterationCount, int64_t argument);
+
+            Iterator begin(void)
+            {
+                resumeTiming();
+                return Iterator(this, iterationCount);
+            }
+
+            Iterator end(void)
+            {
+                return Iterator(this, 0);
+            }
+
+            // Excludes setup done inside the loop from the measured time
+            void pauseTiming(void);
+            void resumeTiming(void);
+
+            // Time taken by one iteration, in seconds, for benchmarks registered with useManualTime
+            void setIterationTime(double seconds)
+            {
+                manualTime += seconds;
+            }
+
+            void setItemsProcessed(uint64_t itemsProcessed)
+            {
+                this->itemsProcessed = itemsProcessed;
+            }
+
+            // Reports why the benchmark wasn't timed, for benchmarks that need data or plugins that aren't available
+            void skipWithError(std::string const &message)
+            {
+                errorMessage = message;
+            }
+
+            // Same as above, but also fails the run, for benchmarks that check their results
+            void failWithError(std::string const &message)
+            {
+                errorMessage = message;
+                failed = true;
+            }
+
+            uint64_t getIterationCount(void) const
+            {
+                return iterationCount;
+            }
+
+            int64_t getArgument(void) const
+            {
+                return argument;
+            }
+
+            double getRealTime(void) const
+            {
+                return realTime;
+            }
+
+            double getCPUTime(void) const
+            {
+                return cpuTime;
+            }
+
+            double getManualTime(void) const
+            {
+                return manualTime;
+            }
+
+            uint64_t getItemsProcessed(void) const
+            {
+                return itemsProcessed;
+            }
+
+            std::string const &getErrorMessage(void) const
+            {
+                return errorMessage;
+            }
+
+            bool hasFailed(void) const
+            {
+                return failed;
+            }
+        };
+
+        using Function = std::function<void(State &state)>;
+
+        struct Definition
+        {
+            std::string name;
+            Function function;
+            std::vector<int64_t> argumentList;
+            uint64_t fixedIterationCount = 0;
+            bool manualTime = false;
+
+            // Runs the benchmark once for each argument, reported as name/argument
+            Definition *arguments(std::vector<int64_t> const &argumentList)
+            {
+                this->argumentList.insert(std::end(this->argumentList), std::begin(argumentList), std::end(argumentList));
+                return this;
+            }
+
+            // Runs exactly this many iterations instead of running until the minimum time has passed,
+            // for macro benchmarks where a single iteration loads a scene or runs a frame
+            Definition *iterations(uint64_t iterationCount)
+            {
+                fixedIterationCount = iterationCount;
+                return this;
+            }
+
+            Definition *useManualTime(void)
+            {
+                manualTime = true;
+                return this;
+            }
+        };
+
+        Definition *Register(std::string const &name, Function function);
+
+        int Main(int argumentCount, char const * const argumentList[]);
+
+        void UseCharPointer(char const volatile *value);
+
+        // Keeps the compiler from removing work whose result is otherwise unused
+        template <typename TYPE>
+        inline void DoNotOptimize(TYPE const &value)
+        {
+#ifdef _MSC_VER
+            UseCharPointer(&reinterpret_cast<char const volatile &>(value));
+            _ReadWriteBarrier();
+#else
+            asm volatile("" : : "r,m"(value) : "memory");
+#endif
+        }
+    }; // namespace Benchmark
+}; // namespace Gek
+
+#define GEK_BENCHMARK_CONCATENATE_INNER(LEFT, RIGHT) LEFT##RIGHT
+#define GEK_BENCHMARK_CONCATENATE(LEFT, RIGHT) GEK_BENCHMARK_CONCATENATE_INNER(LEFT, RIGHT)
+
+// Registers a benchmark function by name, the returned definition can be used to add arguments or options
+#define GEK_BENCHMARK(FUNCTION) \
+    static Gek::Benchmark::Definition * const GEK_BENCHMARK_CONCATENATE(benchmarkDefinition, __LINE__) = Gek::Benchmark::Register(#FUNCTION, FUNCTION)
@@ -0,0 +1,600 @@
+#include "Benchmark.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/Context.hpp"
+#include "GEK/Utility/ContextUser.hpp"
+#include "GEK/Utility/Profiler.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include "GEK/System/Window.hpp"
+#include "GEK/System/VideoDevice.hpp"
+#include "GEK/Engine/Core.hpp"
+#include "GEK/Engine/Population.hpp"
+#include "GEK/Engine/Entity.hpp"
+#include "GEK/Engine/Processor.hpp"
+#include "GEK/Components/Transform.hpp"
+#include "GEK/Newton/Base.hpp"
+#include <future>
+#include <algorithm>
+#include <random>
+#include <map>
+
+using namespace Gek;
+
+// Macro benchmarks run the whole engine headless, with the null window and recording video device,
+// and time the profiler zones of the systems they measure rather than the whole frame
+struct HeadlessEngine
+{
+    using ZoneMap = std::map<std::string, Profiler::ZoneSummary>;
+
+    ContextPtr context;
+    Plugin::CorePtr core;
+    Video::Recording::Device *recordingDevice = nullptr;
+    std::string sceneName;
+
+    static HeadlessEngine *Get(Benchmark::State &state)
+    {
+        static std::unique_ptr<HeadlessEngine> engine;
+        static bool created = false;
+        if (!created)
+        {
+            created = true;
+            engine = std::make_unique<HeadlessEngine>();
+            if (!engine->create())
+            {
+                engine.reset();
+            }
+        }
+
+        if (!engine)
+        {
+            state.skipWithError("Unable to create headless engine, plugins need to be built next to the benchmarks");
+        }
+
+        return engine.get();
+    }
+
+    bool create(void)
+    {
+        auto pluginPath(FileSystem::GetModuleFilePath().getParentPath());
+        auto rootPath(pluginPath.getParentPath());
+
+        std::vector<FileSystem::Path> searchPathList;
+        searchPathList.push_back(pluginPath);
+
+        context = Context::Create(rootPath, searchPathList);
+        if (!context)
+        {
+            return false;
+        }
+
+        // The core takes ownership of the window it's given
+        Window::Description description;
+        description.initialWidth = 1920;
+        description.initialHeight = 1080;
+        auto window = context->createClass<Window>("Null::System::Window", description);
+        if (!window)
+        {
+            return false;
+        }
+
+        core = context->createClass<Plugin::Core>("Engine::Core", window.release());
+        if (!core)
+        {
+            return false;
+        }
+
+        recordingDevice = dynamic_cast<Video::Recording::Device *>(core->getVideoDevice());
+        if (!recordingDevice)
+        {
+            return false;
+        }
+
+        core->setOption("population", "deterministic", true);
+        core->setOption("population", "frameTime", (1.0f / 60.0f));
+        return true;
+    }
+
+    static void MergeZoneSummary(ZoneMap &zoneMap)
+    {
+        for (auto const &summary : Profiler::GetZoneSummary())
+        {
+            auto &zone = zoneMap[summary.name];
+            zone.count += summary.count;
+            zone.totalTime += summary.totalTime;
+            zone.maximumTime = std::max(zone.maximumTime, summary.maximumTime);
+        }
+
+        Profiler::Clear();
+    }
+
+    // Updates until the population has loaded, then until the named zone stops being recorded,
+    // so work that finishes in the background after loading, like models, is included
+    void loadScene(std::string const &name, ZoneMap &zoneMap, char const *backgroundZone = nullptr)
+    {
+        Profiler::SetEnabled(true);
+        Profiler::Clear();
+
+        auto population = core->getPopulation();
+        population->load(name);
+        while (population->isLoading())
+        {
+            core->update();
+            MergeZoneSummary(zoneMap);
+        };
+
+        if (backgroundZone)
+        {
+            uint64_t previousCount = 0;
+            uint32_t idleFrameCount = 0;
+            for (uint32_t frame = 0; frame < 1000 && idleFrameCount < 30; ++frame)
+            {
+                core->update();
+                MergeZoneSummary(zoneMap);
+
+                auto count = zoneMap[backgroundZone].count;
+                idleFrameCount = (count == previousCount ? (idleFrameCount + 1) : 0);
+                previousCount = count;
+            }
+        }
+
+        Profiler::SetEnabled(false);
+        sceneName = name;
+    }
+
+    void useScene(std::string const &name)
+    {
+        if (sceneName != name)
+        {
+            ZoneMap zoneMap;
+            loadScene(name, zoneMap, "Model Load");
+        }
+    }
+
+    static double GetZoneTime(ZoneMap const &zoneMap, std::string const &zoneName)
+    {
+        auto zoneSearch = zoneMap.find(zoneName);
+        return (zoneSearch == std::end(zoneMap) ? 0.0 : (zoneSearch->second.totalTime / 1000.0));
+    }
+
+    // A zone that was never recorded would time as free, which fails the run rather than passing as an improvement
+    static bool CheckZone(Benchmark::State &state, uint64_t zoneCount, std::string const &zoneName)
+    {
+        if (zoneCount == 0)
+        {
+            state.failWithError(String::Format("%v zone wasn't recorded", zoneName));
+            return false;
+        }
+
+        return true;
+    }
+};
+
+static void Population_Load(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    uint64_t zoneCount = 0;
+    uint64_t entityCount = 0;
+    for (auto _ : state)
+    {
+        HeadlessEngine::ZoneMap zoneMap;
+        engine->loadScene("demo", zoneMap, "Model Load");
+        state.setIterationTime(HeadlessEngine::GetZoneTime(zoneMap, "Population Load"));
+        zoneCount += zoneMap["Population Load"].count;
+
+        entityCount = 0;
+        engine->core->getPopulation()->listEntities([&](Plugin::Entity * const entity) -> void
+        {
+            ++entityCount;
+        });
+    }
+
+    if (!HeadlessEngine::CheckZone(state, zoneCount, "Population Load"))
+    {
+        return;
+    }
+
+    state.counters["entities"] = double(entityCount);
+}
+
+GEK_BENCHMARK(Population_Load)->iterations(5)->useManualTime();
+
+static void Population_ListEntities(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    engine->useScene("demo");
+    auto population = engine->core->getPopulation();
+    uint64_t entityCount = 0;
+    for (auto _ : state)
+    {
+        population->listEntities([&](Plugin::Entity * const entity) -> void
+        {
+            ++entityCount;
+        });
+    }
+
+    Benchmark::DoNotOptimize(entityCount);
+    state.setItemsProcessed(entityCount);
+}
+
+GEK_BENCHMARK(Population_ListEntities);
+
+// GEKX models are parsed and uploaded on the model processor's load pool after the population has loaded
+static void ModelProcessor_Load(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    uint64_t modelCount = 0;
+    for (auto _ : state)
+    {
+        HeadlessEngine::ZoneMap zoneMap;
+        engine->loadScene("demo", zoneMap, "Model Load");
+        state.setIterationTime(HeadlessEngine::GetZoneTime(zoneMap, "Model Load"));
+        modelCount = zoneMap["Model Load"].count;
+    }
+
+    if (modelCount == 0)
+    {
+        state.skipWithError("No models were loaded, the demo scene needs data/models");
+        return;
+    }
+
+    state.counters["models"] = double(modelCount);
+}
+
+GEK_BENCHMARK(ModelProcessor_Load)->iterations(3)->useManualTime();
+
+// Runs frames of the demo scene and reports the given zone, along with the video device's counters
+static void RunFrames(Benchmark::State &state, std::string const &zoneName)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    engine->useScene("demo");
+    Profiler::SetEnabled(true);
+    Profiler::Clear();
+    engine->recordingDevice->resetCounters();
+
+    uint64_t zoneCount = 0;
+    uint64_t drawCallCount = 0;
+    uint64_t instanceCount = 0;
+    uint64_t primitiveCount = 0;
+    for (auto _ : state)
+    {
+        engine->core->update();
+
+        HeadlessEngine::ZoneMap zoneMap;
+        HeadlessEngine::MergeZoneSummary(zoneMap);
+        state.setIterationTime(HeadlessEngine::GetZoneTime(zoneMap, zoneName));
+        zoneCount += zoneMap[zoneName].count;
+
+        auto const &counters = engine->recordingDevice->getFrameCounters();
+        drawCallCount += counters.drawCallCount;
+        instanceCount += counters.instanceCount;
+        primitiveCount += counters.primitiveCount;
+    }
+
+    Profiler::SetEnabled(false);
+    if (!HeadlessEngine::CheckZone(state, zoneCount, zoneName))
+    {
+        return;
+    }
+
+    double frameCount = double(state.getIterationCount());
+    state.counters["drawCalls"] = (double(drawCallCount) / frameCount);
+    state.counters["instances"] = (double(instanceCount) / frameCount);
+    state.counters["primitives"] = (double(primitiveCount) / frameCount);
+}
+
+static void Engine_Frame(Benchmark::State &state)
+{
+    RunFrames(state, "Frame");
+}
+
+GEK_BENCHMARK(Engine_Frame)->iterations(300)->useManualTime();
+
+// Time spent adding point and spot lights to the clusters, both light types are clustered at the same time
+static void Renderer_LightClustering(Benchmark::State &state)
+{
+    RunFrames(state, "Light Clustering");
+}
+
+GEK_BENCHMARK(Renderer_LightClustering)->iterations(300)->useManualTime();
+
+static void ModelProcessor_DrawCalls(Benchmark::State &state)
+{
+    RunFrames(state, "Model Draw Calls");
+}
+
+GEK_BENCHMARK(ModelProcessor_DrawCalls)->iterations(300)->useManualTime();
+
+// Rays straight down through the demo scene, submitted as one batch each frame and resolved after the step
+static void Physics_RayQueries(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    engine->useScene("demo");
+
+    Newton::World *world = nullptr;
+    engine->core->listProcessors([&](Plugin::Processor *processor) -> void
+    {
+        if (!world)
+        {
+            world = dynamic_cast<Newton::World *>(processor);
+        }
+    });
+
+    if (!world)
+    {
+        state.skipWithError("Physics processor not loaded");
+        return;
+    }
+
+    std::mt19937 mersineTwister(7151980);
+    std::uniform_real_distribution<float> positionDistribution(-50.0f, 50.0f);
+    Newton::World::QueryList queryList(size_t(state.getArgument()));
+    for (auto &query : queryList)
+    {
+        query.type = Newton::World::Query::Type::Ray;
+        query.start = Math::Float3(positionDistribution(mersineTwister), 100.0f, positionDistribution(mersineTwister));
+        query.end = Math::Float3(query.start.x, -100.0f, query.start.z);
+    }
+
+    Profiler::SetEnabled(true);
+    Profiler::Clear();
+
+    uint64_t zoneCount = 0;
+    uint64_t hitCount = 0;
+    for (auto _ : state)
+    {
+        auto hitFuture = world->castQueries(Newton::World::QueryList(queryList));
+        engine->core->update();
+
+        HeadlessEngine::ZoneMap zoneMap;
+        HeadlessEngine::MergeZoneSummary(zoneMap);
+        state.setIterationTime(HeadlessEngine::GetZoneTime(zoneMap, "Physics Queries"));
+        zoneCount += zoneMap["Physics Queries"].count;
+
+        if (hitFuture.wait_for(std::chrono::seconds(0)) != std::future_status::ready)
+        {
+            Profiler::SetEnabled(false);
+            state.failWithError("Queries weren't resolved by the next update");
+            return;
+        }
+
+        for (auto const &hit : hitFuture.get())
+        {
+            hitCount += (hit.valid ? 1 : 0);
+        }
+    }
+
+    Profiler::SetEnabled(false);
+    if (!HeadlessEngine::CheckZone(state, zoneCount, "Physics Queries"))
+    {
+        return;
+    }
+
+    state.counters["hits"] = (double(hitCount) / double(state.getIterationCount()));
+    state.setItemsProcessed(state.getIterationCount() * queryList.size());
+}
+
+GEK_BENCHMARK(Physics_RayQueries)->arguments({ 10000 })->iterations(300)->useManualTime();
+
+// Eight way tree of 100k named entities, the argument is the percentage of them that move each update,
+// only the moved nodes and their subtrees are rebuilt so the time should follow the change rate
+static void Transform_Hierarchy(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    auto population = engine->core->getPopulation();
+    population->reset();
+    engine->sceneName.clear();
+
+    static constexpr uint32_t nodeCount = 100000;
+    for (uint32_t nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+    {
+        JSON::Object transformObject;
+        transformObject["position"] = JSON::Make(Math::Float3(1.0f, 0.0f, 0.0f));
+        if (nodeIndex > 0)
+        {
+            transformObject["parent"] = String::Format("node_%v", ((nodeIndex - 1) / 8));
+        }
+
+        population->createEntity(
+        {
+            { "Name", JSON::Make(String::Format("node_%v", nodeIndex)) },
+            { "Transform", transformObject },
+        });
+    }
+
+    while (population->isLoading())
+    {
+        engine->core->update();
+    };
+
+    std::vector<Plugin::Entity *> entityList;
+    population->listEntities([&](Plugin::Entity * const entity) -> void
+    {
+        if (entity->hasComponent<Components::Transform>())
+        {
+            entityList.push_back(entity);
+        }
+    });
+
+    if (entityList.size() != nodeCount)
+    {
+        state.skipWithError(String::Format("Only %v of %v nodes were created", entityList.size(), nodeCount));
+        return;
+    }
+
+    // First update builds the whole hierarchy, only later updates are measured
+    engine->core->update();
+
+    std::mt19937 mersineTwister(7151980);
+    std::uniform_int_distribution<size_t> nodeDistribution(0, (entityList.size() - 1));
+    size_t changeCount = ((entityList.size() * size_t(state.getArgument())) / 100);
+
+    Profiler::SetEnabled(true);
+    Profiler::Clear();
+    uint64_t zoneCount = 0;
+    for (auto _ : state)
+    {
+        for (size_t change = 0; change < changeCount; ++change)
+        {
+            auto &transformComponent = entityList[nodeDistribution(mersineTwister)]->getComponent<Components::Transform>();
+            transformComponent.position.y += 0.01f;
+            transformComponent.setDirty();
+        }
+
+        engine->core->update();
+
+        HeadlessEngine::ZoneMap zoneMap;
+        HeadlessEngine::MergeZoneSummary(zoneMap);
+        state.setIterationTime(HeadlessEngine::GetZoneTime(zoneMap, "Transform Update"));
+        zoneCount += zoneMap["Transform Update"].count;
+    }
+
+    Profiler::SetEnabled(false);
+    population->reset();
+    if (!HeadlessEngine::CheckZone(state, zoneCount, "Transform Update"))
+    {
+        return;
+    }
+
+    state.counters["changedNodes"] = double(changeCount);
+    state.setItemsProcessed(state.getIterationCount() * entityList.size());
+}
+
+GEK_BENCHMARK(Transform_Hierarchy)->arguments({ 0, 1, 10 })->iterations(100)->useManualTime();
+
+// Loads the demo scene twice and runs the same number of frames each time, deterministic populations
+// advance by the fixed frame time however long the frames actually took, so both runs must end in the same state
+static void Population_Determinism(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    auto population = engine->core->getPopulation();
+    for (auto _ : state)
+    {
+        uint64_t stateHashList[2] = { 0, 0 };
+        for (auto &stateHash : stateHashList)
+        {
+            HeadlessEngine::ZoneMap zoneMap;
+            engine->loadScene("demo", zoneMap, "Model Load");
+            for (uint32_t frame = 0; frame < 120; ++frame)
+            {
+                engine->core->update();
+            }
+
+            stateHash = population->getStateHash();
+        }
+
+        if (stateHashList[0] != stateHashList[1])
+        {
+            state.failWithError(String::Format("State hash differs between runs: %v, %v", stateHashList[0], stateHashList[1]));
+            return;
+        }
+    }
+}
+
+GEK_BENCHMARK(Population_Determinism)->iterations(1);
+
+// Drives the physics processor directly with jittery frame times, with a long stall every second, so the
+// fixed step has to both carry time over between frames and drop what its step budget can't cover
+//  - two runs of the same frame times must end in the same state
+//  - no update may run more steps than physics.maximumStepCount, however long its frame was
+static void Physics_JitteryFrames(Benchmark::State &state)
+{
+    auto engine = HeadlessEngine::Get(state);
+    if (!engine)
+    {
+        return;
+    }
+
+    auto population = engine->core->getPopulation();
+    uint64_t maximumStepCount = std::max(engine->core->getOption("physics", "maximumStepCount").convert(8U), 1U);
+    uint64_t totalStepCount = 0;
+    uint64_t mostStepCount = 0;
+    for (auto _ : state)
+    {
+        double updateTime = 0.0;
+        uint64_t stateHashList[2] = { 0, 0 };
+        for (auto &stateHash : stateHashList)
+        {
+            HeadlessEngine::ZoneMap zoneMap;
+            engine->loadScene("demo", zoneMap, "Model Load");
+
+            std::mt19937 mersineTwister(7151980);
+            std::uniform_real_distribution<float> frameTimeDistribution(0.001f, 0.05f);
+            Profiler::SetEnabled(true);
+            Profiler::Clear();
+            for (uint32_t frame = 0; frame < 600; ++frame)
+            {
+                float frameTime = ((frame % 60) == 59 ? 0.5f : frameTimeDistribution(mersineTwister));
+                population->onUpdate[50](frameTime);
+
+                HeadlessEngine::ZoneMap frameZoneMap;
+                HeadlessEngine::MergeZoneSummary(frameZoneMap);
+                updateTime += HeadlessEngine::GetZoneTime(frameZoneMap, "Physics Update");
+
+                auto stepCount = frameZoneMap["Physics Step"].count;
+                totalStepCount += stepCount;
+                mostStepCount = std::max(mostStepCount, stepCount);
+                if (stepCount > maximumStepCount)
+                {
+                    Profiler::SetEnabled(false);
+                    state.failWithError(String::Format("Update of %vs ran %v steps, more than the budget of %v", frameTime, stepCount, maximumStepCount));
+                    return;
+                }
+            }
+
+            Profiler::SetEnabled(false);
+            stateHash = population->getStateHash();
+        }
+
+        if (stateHashList[0] != stateHashList[1])
+        {
+            state.failWithError(String::Format("State hash differs between runs: %v, %v", stateHashList[0], stateHashList[1]));
+            return;
+        }
+
+        state.setIterationTime(updateTime / 2.0);
+    }
+
+    if (!HeadlessEngine::CheckZone(state, totalStepCount, "Physics Step"))
+    {
+        return;
+    }
+
+    state.counters["mostSteps"] = double(mostStepCount);
+}
+
+GEK_BENCHMARK(Physics_JitteryFrames)->iterations(1)->useManualTime();
@@ -0,0 +1,467 @@
+#include "Benchmark.hpp"
+#include "GEK/Math/Common.hpp"
+#include "GEK/Math/Matrix4x4.hpp"
+#include "GEK/Math/Quaternion.hpp"
+#include "GEK/Math/Batch.hpp"
+#include "GEK/Math/SIMD.hpp"
+#include "GEK/Shapes/Frustum.hpp"
+#include "GEK/Utility/Allocator.hpp"
+#include "GEK/Utility/String.hpp"
+#include <random>
+
+using namespace Gek;
+
+using AlignedFloatList = std::vector<float, AlignedAllocator<float, 16>>;
+
+// Objects spread around a camera at the origin looking down +z, so roughly half of them are visible
+struct CullingScene
+{
+    size_t objectCount;
+    size_t bufferedObjectCount;
+    Math::Float4x4 viewMatrix = Math::Float4x4::Identity;
+    Math::Float4x4 projectionMatrix = Math::Float4x4::MakePerspective(Math::DegreesToRadians(90.0f), (16.0f / 9.0f), 0.1f, 200.0f);
+    AlignedFloatList positionXList, positionYList, positionZList;
+    AlignedFloatList radiusList;
+    AlignedFloatList halfSizeXList, halfSizeYList, halfSizeZList;
+    AlignedFloatList transformList[16];
+    std::vector<bool> visibilityList;
+
+    CullingScene(size_t objectCount)
+        : objectCount(objectCount)
+        , bufferedObjectCount((objectCount + 3) & ~3)
+    {
+        positionXList.resize(bufferedObjectCount);
+        positionYList.resize(bufferedObjectCount);
+        positionZList.resize(bufferedObjectCount);
+        radiusList.resize(bufferedObjectCount);
+        halfSizeXList.resize(bufferedObjectCount);
+        halfSizeYList.resize(bufferedObjectCount);
+        halfSizeZList.resize(bufferedObjectCount);
+        for (auto &elementList : transformList)
+        {
+            elementList.resize(bufferedObjectCount);
+        }
+
+        visibilityList.resize(bufferedObjectCount);
+
+        std::mt19937 mersineTwister(7151980);
+        std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> sizeDistribution(0.5f, 5.0f);
+        std::uniform_real_distribution<float> angleDistribution(0.0f, Math::Tau);
+        for (size_t objectIndex = 0; objectIndex < objectCount; ++objectIndex)
+        {
+            Math::Float3 position(positionDistribution(mersineTwister), positionDistribution(mersineTwister), positionDistribution(mersineTwister));
+            positionXList[objectIndex] = position.x;
+            positionYList[objectIndex] = position.y;
+            positionZList[objectIndex] = position.z;
+            radiusList[objectIndex] = sizeDistribution(mersineTwister);
+            halfSizeXList[objectIndex] = sizeDistribution(mersineTwister);
+            halfSizeYList[objectIndex] = sizeDistribution(mersineTwister);
+            halfSizeZList[objectIndex] = sizeDistribution(mersineTwister);
+
+            auto matrix(Math::Float4x4::MakeEulerRotation(angleDistribution(mersineTwister), angleDistribution(mersineTwister), angleDistribution(mersineTwister), position));
+            for (size_t element = 0; element < 16; ++element)
+            {
+                transformList[element][objectIndex] = matrix.data[element];
+            }
+        }
+    }
+};
+
+static void SIMD_CullSpheres(Benchmark::State &state)
+{
+    CullingScene scene(size_t(state.getArgument()));
+    Shapes::Frustum viewFrustum(scene.viewMatrix * scene.projectionMatrix);
+    auto frustum = Math::SIMD::loadFrustum((Math::Float4 *)viewFrustum.planeList);
+    for (auto _ : state)
+    {
+        Math::SIMD::cullSpheres(frustum, scene.bufferedObjectCount, scene.positionXList, scene.positionYList, scene.positionZList, scene.radiusList, scene.visibilityList);
+        Benchmark::DoNotOptimize(scene.visibilityList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.objectCount);
+}
+
+GEK_BENCHMARK(SIMD_CullSpheres)->arguments({ 1024, 100000 });
+
+static void SIMD_CullOrientedBoundingBoxes(Benchmark::State &state)
+{
+    CullingScene scene(size_t(state.getArgument()));
+    for (auto _ : state)
+    {
+        Math::SIMD::cullOrientedBoundingBoxes(scene.viewMatrix, scene.projectionMatrix, scene.bufferedObjectCount, scene.halfSizeXList, scene.halfSizeYList, scene.halfSizeZList, scene.transformList, scene.visibilityList);
+        Benchmark::DoNotOptimize(scene.visibilityList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.objectCount);
+}
+
+GEK_BENCHMARK(SIMD_CullOrientedBoundingBoxes)->arguments({ 1024, 100000 });
+
+// Transform streams in the layout the batch kernels read
+struct TransformScene
+{
+    std::vector<float> positionList[3];
+    std::vector<float> rotationList[4];
+    std::vector<float> scaleList[3];
+    Math::Batch::TransformStreams transformStreams;
+    std::vector<Math::Float4x4> matrixList;
+    std::vector<Math::Float4x4> resultList;
+
+    TransformScene(size_t count)
+        : matrixList(count)
+        , resultList(count)
+    {
+        std::mt19937 mersineTwister(7151980);
+        std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> scaleDistribution(0.5f, 2.0f);
+        std::uniform_real_distribution<float> angleDistribution(0.0f, Math::Tau);
+        for (auto &elementList : positionList)
+        {
+            elementList.resize(count);
+        }
+
+        for (auto &elementList : rotationList)
+        {
+            elementList.resize(count);
+        }
+
+        for (auto &elementList : scaleList)
+        {
+            elementList.resize(count);
+        }
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            auto rotation(Math::Quaternion::MakeEulerRotation(angleDistribution(mersineTwister), angleDistribution(mersineTwister), angleDistribution(mersineTwister)));
+            for (size_t axis = 0; axis < 3; ++axis)
+            {
+                positionList[axis][index] = positionDistribution(mersineTwister);
+                scaleList[axis][index] = scaleDistribution(mersineTwister);
+            }
+
+            rotationList[0][index] = rotation.x;
+            rotationList[1][index] = rotation.y;
+            rotationList[2][index] = rotation.z;
+            rotationList[3][index] = rotation.w;
+        }
+
+        transformStreams.positionX = positionList[0].data();
+        transformStreams.positionY = positionList[1].data();
+        transformStreams.positionZ = positionList[2].data();
+        transformStreams.rotationX = rotationList[0].data();
+        transformStreams.rotationY = rotationList[1].data();
+        transformStreams.rotationZ = rotationList[2].data();
+        transformStreams.rotationW = rotationList[3].data();
+        transformStreams.scaleX = scaleList[0].data();
+        transformStreams.scaleY = scaleList[1].data();
+        transformStreams.scaleZ = scaleList[2].data();
+    }
+};
+
+static void Batch_MakeMatrices(Benchmark::State &state, Math::Batch::Instructions instructions)
+{
+    TransformScene scene(size_t(state.getArgument()));
+    for (auto _ : state)
+    {
+        Math::Batch::MakeMatrices(scene.matrixList.size(), scene.transformStreams, scene.matrixList.data(), instructions);
+        Benchmark::DoNotOptimize(scene.matrixList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.matrixList.size());
+}
+
+static void Batch_MakeMatrices_Scalar(Benchmark::State &state)
+{
+    Batch_MakeMatrices(state, Math::Batch::Instructions::Scalar);
+}
+
+static void Batch_MakeMatrices_Best(Benchmark::State &state)
+{
+    Batch_MakeMatrices(state, Math::Batch::Instructions::Best);
+}
+
+GEK_BENCHMARK(Batch_MakeMatrices_Scalar)->arguments({ 1024, 100000 });
+GEK_BENCHMARK(Batch_MakeMatrices_Best)->arguments({ 1024, 100000 });
+
+static void Batch_Multiply(Benchmark::State &state, Math::Batch::Instructions instructions)
+{
+    TransformScene scene(size_t(state.getArgument()));
+    Math::Batch::MakeMatrices(scene.matrixList.size(), scene.transformStreams, scene.matrixList.data());
+    auto viewMatrix(Math::Float4x4::MakeTranslation(Math::Float3(0.0f, -10.0f, 50.0f)));
+    for (auto _ : state)
+    {
+        Math::Batch::Multiply(scene.matrixList.size(), scene.matrixList.data(), viewMatrix, scene.resultList.data(), instructions);
+        Benchmark::DoNotOptimize(scene.resultList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.matrixList.size());
+}
+
+static void Batch_Multiply_Scalar(Benchmark::State &state)
+{
+    Batch_Multiply(state, Math::Batch::Instructions::Scalar);
+}
+
+static void Batch_Multiply_Best(Benchmark::State &state)
+{
+    Batch_Multiply(state, Math::Batch::Instructions::Best);
+}
+
+GEK_BENCHMARK(Batch_Multiply_Scalar)->arguments({ 1024, 100000 });
+GEK_BENCHMARK(Batch_Multiply_Best)->arguments({ 1024, 100000 });
+
+static void Batch_Invert(Benchmark::State &state, Math::Batch::Instructions instructions)
+{
+    TransformScene scene(size_t(state.getArgument()));
+    Math::Batch::MakeMatrices(scene.matrixList.size(), scene.transformStreams, scene.matrixList.data());
+    for (auto _ : state)
+    {
+        Math::Batch::Invert(scene.matrixList.size(), scene.matrixList.data(), scene.resultList.data(), instructions);
+        Benchmark::DoNotOptimize(scene.resultList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.matrixList.size());
+}
+
+static void Batch_Invert_Scalar(Benchmark::State &state)
+{
+    Batch_Invert(state, Math::Batch::Instructions::Scalar);
+}
+
+static void Batch_Invert_Best(Benchmark::State &state)
+{
+    Batch_Invert(state, Math::Batch::Instructions::Best);
+}
+
+GEK_BENCHMARK(Batch_Invert_Scalar)->arguments({ 1024, 100000 });
+GEK_BENCHMARK(Batch_Invert_Best)->arguments({ 1024, 100000 });
+
+// Pairs of rotations to interpolate between, every fourth pair is identical, opposite or nearly identical
+// so the linear and perpendicular paths of slerp are covered along with the general one
+struct SlerpScene
+{
+    std::vector<float> fromList[4];
+    std::vector<float> toList[4];
+    std::vector<float> resultList[4];
+    std::vector<float> factorList;
+    Math::Batch::QuaternionStreams from, to, result;
+
+    SlerpScene(size_t count)
+        : factorList(count)
+    {
+        std::mt19937 mersineTwister(7151980);
+        std::uniform_real_distribution<float> angleDistribution(0.0f, Math::Tau);
+        std::uniform_real_distribution<float> factorDistribution(0.0f, 1.0f);
+        for (size_t axis = 0; axis < 4; ++axis)
+        {
+            fromList[axis].resize(count);
+            toList[axis].resize(count);
+            resultList[axis].resize(count);
+        }
+
+        for (size_t index = 0; index < count; ++index)
+        {
+            auto fromRotation(Math::Quaternion::MakeEulerRotation(angleDistribution(mersineTwister), angleDistribution(mersineTwister), angleDistribution(mersineTwister)));
+            auto toRotation(Math::Quaternion::MakeEulerRotation(angleDistribution(mersineTwister), angleDistribution(mersineTwister), angleDistribution(mersineTwister)));
+            switch (index % 4)
+            {
+            case 1:
+                toRotation = fromRotation;
+                break;
+
+            case 2:
+                toRotation = Math::Quaternion(-fromRotation.x, -fromRotation.y, -fromRotation.z, -fromRotation.w);
+                break;
+
+            case 3:
+                toRotation = (Math::Quaternion::MakeYawRotation(0.01f) * fromRotation);
+                break;
+            };
+
+            for (size_t axis = 0; axis < 4; ++axis)
+            {
+                fromList[axis][index] = fromRotation.data[axis];
+                toList[axis][index] = toRotation.data[axis];
+            }
+
+            factorList[index] = factorDistribution(mersineTwister);
+        }
+
+        from = { fromList[0].data(), fromList[1].data(), fromList[2].data(), fromList[3].data() };
+        to = { toList[0].data(), toList[1].data(), toList[2].data(), toList[3].data() };
+        result = { resultList[0].data(), resultList[1].data(), resultList[2].data(), resultList[3].data() };
+    }
+
+    Math::Quaternion getFrom(size_t index) const
+    {
+        return Math::Quaternion(fromList[0][index], fromList[1][index], fromList[2][index], fromList[3][index]);
+    }
+
+    Math::Quaternion getTo(size_t index) const
+    {
+        return Math::Quaternion(toList[0][index], toList[1][index], toList[2][index], toList[3][index]);
+    }
+};
+
+static void Batch_Slerp(Benchmark::State &state, Math::Batch::Instructions instructions)
+{
+    SlerpScene scene(size_t(state.getArgument()));
+    for (auto _ : state)
+    {
+        Math::Batch::Slerp(scene.factorList.size(), scene.from, scene.to, scene.factorList.data(), scene.result, instructions);
+        Benchmark::DoNotOptimize(scene.resultList);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * scene.factorList.size());
+}
+
+static void Batch_Slerp_Scalar(Benchmark::State &state)
+{
+    Batch_Slerp(state, Math::Batch::Instructions::Scalar);
+}
+
+static void Batch_Slerp_Best(Benchmark::State &state)
+{
+    Batch_Slerp(state, Math::Batch::Instructions::Best);
+}
+
+GEK_BENCHMARK(Batch_Slerp_Scalar)->arguments({ 1024, 100000 });
+GEK_BENCHMARK(Batch_Slerp_Best)->arguments({ 1024, 100000 });
+
+// Runs every batch kernel with each instruction set the processor supports, and compares the results
+// against the scalar Math types, which they're expected to match exactly
+static void Batch_Exactness(Benchmark::State &state)
+{
+    static char const * const InstructionsNameList[] =
+    {
+        "Scalar",
+        "SSE4",
+        "AVX2",
+    };
+
+    // Not a multiple of the block size, so the narrower lanes used for the tail are checked as well
+    size_t count = size_t(state.getArgument());
+    TransformScene scene(count);
+    SlerpScene slerpScene(count);
+
+    std::vector<Math::Float4x4> expectedMatrixList(count);
+    std::vector<Math::Float4x4> expectedMultiplyList(count);
+    std::vector<Math::Float4x4> expectedSharedMultiplyList(count);
+    std::vector<Math::Float4x4> expectedInverseList(count);
+    std::vector<Math::Quaternion> expectedSlerpList(count);
+    auto viewMatrix(Math::Float4x4::MakeTranslation(Math::Float3(0.0f, -10.0f, 50.0f)));
+    for (size_t index = 0; index < count; ++index)
+    {
+        Math::Float3 position(scene.positionList[0][index], scene.positionList[1][index], scene.positionList[2][index]);
+        Math::Quaternion rotation(scene.rotationList[0][index], scene.rotationList[1][index], scene.rotationList[2][index], scene.rotationList[3][index]);
+        Math::Float3 scale(scene.scaleList[0][index], scene.scaleList[1][index], scene.scaleList[2][index]);
+        expectedMatrixList[index] = (Math::Float4x4::MakeScaling(scale) * Math::Float4x4::MakeQuaternionRotation(rotation, position));
+        expectedInverseList[index] = expectedMatrixList[index].getInverse();
+        expectedSharedMultiplyList[index] = (expectedMatrixList[index] * viewMatrix);
+        expectedSlerpList[index] = slerpScene.getFrom(index).slerp(slerpScene.getTo(index), slerpScene.factorList[index]);
+    }
+
+    for (size_t index = 0; index < count; ++index)
+    {
+        expectedMultiplyList[index] = (expectedMatrixList[index] * expectedMatrixList[count - index - 1]);
+    }
+
+    std::vector<float> matrixStreamList[16];
+    float *matrixStreams[16];
+    for (size_t element = 0; element < 16; ++element)
+    {
+        matrixStreamList[element].resize(count);
+        matrixStreams[element] = matrixStreamList[element].data();
+    }
+
+    std::vector<Math::Float4x4> reversedMatrixList(expectedMatrixList.rbegin(), expectedMatrixList.rend());
+    auto supportedInstructions = Math::Batch::GetSupportedInstructions();
+    uint32_t checkedCount = 0;
+    for (auto _ : state)
+    {
+        checkedCount = 0;
+        for (auto instructions : { Math::Batch::Instructions::Scalar, Math::Batch::Instructions::SSE4, Math::Batch::Instructions::AVX2 })
+        {
+            if (instructions > supportedInstructions)
+            {
+                continue;
+            }
+
+            auto instructionsName = InstructionsNameList[static_cast<uint8_t>(instructions)];
+            auto compareMatrices = [&](char const *kernelName, std::vector<Math::Float4x4> const &resultList, std::vector<Math::Float4x4> const &expectedList) -> bool
+            {
+                for (size_t index = 0; index < count; ++index)
+                {
+                    for (size_t element = 0; element < 16; ++element)
+                    {
+                        if (resultList[index].data[element] != expectedList[index].data[element])
+                        {
+                            state.failWithError(String::Format("%v (%v) differs from the scalar types at matrix %v, element %v: %v, expected %v", kernelName, instructionsName, index, element, resultList[index].data[element], expectedList[index].data[element]));
+                            return false;
+                        }
+                    }
+                }
+
+                return true;
+            };
+
+            Math::Batch::MakeMatrices(count, scene.transformStreams, scene.matrixList.data(), instructions);
+            if (!compareMatrices("MakeMatrices", scene.matrixList, expectedMatrixList))
+            {
+                return;
+            }
+
+            Math::Batch::MakeMatrices(count, scene.transformStreams, matrixStreams, instructions);
+            for (size_t index = 0; index < count; ++index)
+            {
+                for (size_t element = 0; element < 16; ++element)
+                {
+                    scene.resultList[index].data[element] = matrixStreamList[element][index];
+                }
+            }
+
+            if (!compareMatrices("MakeMatrices to streams", scene.resultList, expectedMatrixList))
+            {
+                return;
+            }
+
+            Math::Batch::Multiply(count, expectedMatrixList.data(), reversedMatrixList.data(), scene.resultList.data(), instructions);
+            if (!compareMatrices("Multiply", scene.resultList, expectedMultiplyList))
+            {
+                return;
+            }
+
+            Math::Batch::Multiply(count, expectedMatrixList.data(), viewMatrix, scene.resultList.data(), instructions);
+            if (!compareMatrices("Multiply by shared matrix", scene.resultList, expectedSharedMultiplyList))
+            {
+                return;
+            }
+
+            Math::Batch::Invert(count, expectedMatrixList.data(), scene.resultList.data(), instructions);
+            if (!compareMatrices("Invert", scene.resultList, expectedInverseList))
+            {
+                return;
+            }
+
+            Math::Batch::Slerp(count, slerpScene.from, slerpScene.to, slerpScene.factorList.data(), slerpScene.result, instructions);
+            for (size_t index = 0; index < count; ++index)
+            {
+                for (size_t axis = 0; axis < 4; ++axis)
+                {
+                    if (slerpScene.resultList[axis][index] != expectedSlerpList[index].data[axis])
+                    {
+                        state.failWithError(String::Format("Slerp (%v) differs from the scalar types at quaternion %v, axis %v: %v, expected %v", instructionsName, index, axis, slerpScene.resultList[axis][index], expectedSlerpList[index].data[axis]));
+                        return;
+                    }
+                }
+            }
+
+            ++checkedCount;
+        }
+    }
+
+    state.counters["instructionSets"] = double(checkedCount);
+}
+
+GEK_BENCHMARK(Batch_Exactness)->arguments({ 1003 })->iterations(1);
@@ -0,0 +1,95 @@
+#include "Benchmark.hpp"
+#include "GEK/Math/Common.hpp"
+#include "GEK/Particles/Pool.hpp"
+#include <random>
+
+using namespace Gek;
+
+// A million particles split between emitter sized ranges, refilled between iterations so every step
+// integrates the whole pool, and kills the same share of it, however many iterations are run
+struct ParticleScene
+{
+    static const uint32_t RangeSize = 1000;
+
+    Particles::Pool pool;
+    std::vector<Particles::Pool::Range> rangeList;
+    std::mt19937 mersineTwister;
+    std::uniform_real_distribution<float> lifeDistribution;
+
+    ParticleScene(uint32_t particleCount)
+        : pool(particleCount)
+        , mersineTwister(7151980)
+        , lifeDistribution(0.5f, 2.0f)
+    {
+        rangeList.resize(particleCount / RangeSize);
+        for (auto &range : rangeList)
+        {
+            pool.allocate(range, RangeSize);
+        }
+
+        std::uniform_real_distribution<float> positionDistribution(-100.0f, 100.0f);
+        std::uniform_real_distribution<float> velocityDistribution(-1.0f, 1.0f);
+        for (auto &range : rangeList)
+        {
+            uint32_t count = range.capacity;
+            auto first = pool.spawn(range, count);
+            for (auto index = first; index < (first + count); ++index)
+            {
+                pool.getStream(Particles::Pool::PositionX)[index] = positionDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::PositionY)[index] = positionDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::PositionZ)[index] = positionDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::VelocityX)[index] = velocityDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::VelocityY)[index] = velocityDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::VelocityZ)[index] = velocityDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::Torque)[index] = velocityDistribution(mersineTwister);
+                pool.getStream(Particles::Pool::AccelerationY)[index] = -32.174f;
+                pool.getStream(Particles::Pool::Growth)[index] = 1.0f;
+                pool.getStream(Particles::Pool::SizeLimit)[index] = 1.0f;
+                pool.getStream(Particles::Pool::Age)[index] = 0.0f;
+                pool.getStream(Particles::Pool::Life)[index] = pool.getStream(Particles::Pool::KillAge)[index] = lifeDistribution(mersineTwister);
+            }
+        }
+    }
+
+    // Brings every range back to full, the new particles take the stream values left behind in the slots
+    void refill(void)
+    {
+        for (auto &range : rangeList)
+        {
+            uint32_t count = range.capacity;
+            auto first = pool.spawn(range, count);
+            for (auto index = first; index < (first + count); ++index)
+            {
+                pool.getStream(Particles::Pool::Age)[index] = 0.0f;
+                pool.getStream(Particles::Pool::Life)[index] = pool.getStream(Particles::Pool::KillAge)[index] = lifeDistribution(mersineTwister);
+            }
+        }
+    }
+};
+
+static void Particles_Pool_Update(Benchmark::State &state)
+{
+    static const float FrameTime = (1.0f / 60.0f);
+
+    ParticleScene scene(uint32_t(state.getArgument()));
+    uint64_t killedCount = 0;
+    for (auto _ : state)
+    {
+        for (auto &range : scene.rangeList)
+        {
+            auto liveCount = range.liveCount;
+            scene.pool.integrate(range, FrameTime);
+            scene.pool.kill(range);
+            killedCount += (liveCount - range.liveCount);
+        }
+
+        state.pauseTiming();
+        scene.refill();
+        state.resumeTiming();
+    }
+
+    state.counters["killed"] = (double(killedCount) / double(state.getIterationCount()));
+    state.setItemsProcessed(state.getIterationCount() * uint64_t(state.getArgument()));
+}
+
+GEK_BENCHMARK(Particles_Pool_Update)->arguments({ 1000000 });
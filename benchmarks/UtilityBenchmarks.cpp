@@ -0,0 +1,276 @@
+#include "Benchmark.hpp"
+#include "GEK/Utility/String.hpp"
+#include "GEK/Utility/FileSystem.hpp"
+#include "GEK/Utility/ShuntingYard.hpp"
+#include "GEK/Utility/ThreadPool.hpp"
+#include "GEK/Utility/JSON.hpp"
+#include "GEK/Utility/JSONView.hpp"
+#include <atomic>
+#include <thread>
+#include <sstream>
+#include <map>
+
+using namespace Gek;
+
+// Generated files are written once per run, in to the system's temporary directory
+static FileSystem::Path GetDataPath(void)
+{
+    static const FileSystem::Path dataPath(std::experimental::filesystem::temp_directory_path() / "gek_benchmarks");
+    return dataPath;
+}
+
+// Scene in the same layout as data/scenes, with one cube per entity
+static FileSystem::Path GetScenePath(uint32_t entityCount)
+{
+    static std::map<uint32_t, FileSystem::Path> scenePathMap;
+    auto sceneSearch = scenePathMap.find(entityCount);
+    if (sceneSearch != std::end(scenePathMap))
+    {
+        return sceneSearch->second;
+    }
+
+    std::ostringstream stream;
+    stream << "{\n";
+    stream << "    \"Seed\": 7151980,\n";
+    stream << "    \"Templates\": {\n";
+    stream << "        \"BasicCube\": {\n";
+    stream << "            \"Transform\": { \"rotation\": [ \"random(0,pi*2)\", \"random(0,pi*2)\", \"random(0,pi*2)\" ] },\n";
+    stream << "            \"Model\": \"cube\",\n";
+    stream << "            \"Physical\": { \"mass\": 100 }\n";
+    stream << "        }\n";
+    stream << "    },\n";
+    stream << "    \"Population\": [\n";
+    for (uint32_t entityIndex = 0; entityIndex < entityCount; ++entityIndex)
+    {
+        stream << "        { \"Template\": \"BasicCube\", \"Name\": \"cube_" << entityIndex << "\", ";
+        stream << "\"Transform\": { \"position\": [ " << float(entityIndex % 100) << ", " << float((entityIndex / 100) % 100) << ", " << float(entityIndex / 10000) << " ] }, ";
+        stream << "\"Color\": [ \"random(0, 1)\", \"random(0, 1)\", \"random(0, 1)\" ] }";
+        stream << ((entityIndex + 1) < entityCount ? ",\n" : "\n");
+    }
+
+    stream << "    ]\n";
+    stream << "}\n";
+
+    auto scenePath(FileSystem::GetFileName(GetDataPath(), String::Format("scene_%v.json", entityCount)));
+    FileSystem::Save(scenePath, stream.str());
+    scenePathMap[entityCount] = scenePath;
+    return scenePath;
+}
+
+static void ShuntingYard_Evaluate(Benchmark::State &state)
+{
+    ShuntingYard shuntingYard;
+    shuntingYard.setRandomSeed(7151980);
+    for (auto _ : state)
+    {
+        Benchmark::DoNotOptimize(shuntingYard.evaluate("random(-40, 40) * sin(pi / 4) + (2 ^ 3) / max(1, 2)"));
+    }
+
+    state.setItemsProcessed(state.getIterationCount());
+}
+
+GEK_BENCHMARK(ShuntingYard_Evaluate);
+
+static void ShuntingYard_GetTokenList(Benchmark::State &state)
+{
+    ShuntingYard shuntingYard;
+    for (auto _ : state)
+    {
+        Benchmark::DoNotOptimize(shuntingYard.getTokenList("random(-40, 40) * sin(pi / 4) + (2 ^ 3) / max(1, 2)"));
+    }
+
+    state.setItemsProcessed(state.getIterationCount());
+}
+
+GEK_BENCHMARK(ShuntingYard_GetTokenList);
+
+static void JSON_Parse(Benchmark::State &state)
+{
+    ShuntingYard shuntingYard;
+    shuntingYard.setRandomSeed(7151980);
+    JSON::Object expression("random(0, pi * 2)");
+    JSON::Object number(1.5f);
+    for (auto _ : state)
+    {
+        Benchmark::DoNotOptimize(JSON::Parse(shuntingYard, expression, 0.0f));
+        Benchmark::DoNotOptimize(JSON::Parse(shuntingYard, number, 0.0f));
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * 2);
+}
+
+GEK_BENCHMARK(JSON_Parse);
+
+// Full mutable tree, what scenes were loaded with before the read-only documents
+static void JSON_LoadObject(Benchmark::State &state)
+{
+    auto scenePath(GetScenePath(uint32_t(state.getArgument())));
+    for (auto _ : state)
+    {
+        auto object = JSON::Load(scenePath);
+        Benchmark::DoNotOptimize(object);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * state.getArgument());
+}
+
+GEK_BENCHMARK(JSON_LoadObject)->arguments({ 1000, 100000 });
+
+// Arena backed read-only document, the largest scene is about 100MB of text
+static void JSON_LoadDocument(Benchmark::State &state)
+{
+    auto scenePath(GetScenePath(uint32_t(state.getArgument())));
+    for (auto _ : state)
+    {
+        auto document = JSON::Document::Load(scenePath);
+        Benchmark::DoNotOptimize(document.getRoot().get("Population").getSize());
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * state.getArgument());
+}
+
+GEK_BENCHMARK(JSON_LoadDocument)->arguments({ 1000, 100000, 500000 });
+
+static void JSON_Reader(Benchmark::State &state)
+{
+    auto text(FileSystem::Load(GetScenePath(uint32_t(state.getArgument())), String::Empty));
+    for (auto _ : state)
+    {
+        uint64_t tokenCount = 0;
+        JSON::Reader reader(text);
+        for (auto token = reader.next(); token != JSON::Reader::Token::End && token != JSON::Reader::Token::Error; token = reader.next())
+        {
+            ++tokenCount;
+        }
+
+        Benchmark::DoNotOptimize(tokenCount);
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * text.size());
+}
+
+GEK_BENCHMARK(JSON_Reader)->arguments({ 1000, 100000, 500000 });
+
+// Tasks are enqueued in batches of the given size, and each batch is waited on before the next
+static void ThreadPool_Enqueue(Benchmark::State &state)
+{
+    ThreadPool threadPool(std::max(1U, std::thread::hardware_concurrency()));
+    std::atomic<uint64_t> taskCount = 0;
+    std::vector<std::future<void>> futureList(size_t(state.getArgument()));
+    for (auto _ : state)
+    {
+        for (auto &future : futureList)
+        {
+            future = threadPool.enqueue([&taskCount](void) -> void
+            {
+                ++taskCount;
+            });
+        }
+
+        for (auto &future : futureList)
+        {
+            future.wait();
+        }
+    }
+
+    Benchmark::DoNotOptimize(taskCount.load());
+    state.setItemsProcessed(state.getIterationCount() * state.getArgument());
+}
+
+GEK_BENCHMARK(ThreadPool_Enqueue)->arguments({ 1, 1000 });
+
+static std::vector<FileSystem::Path> const &GetSmallFilePathList(void)
+{
+    static std::vector<FileSystem::Path> filePathList;
+    if (filePathList.empty())
+    {
+        std::vector<uint8_t> buffer(4096);
+        for (uint32_t fileIndex = 0; fileIndex < 256; ++fileIndex)
+        {
+            std::fill(std::begin(buffer), std::end(buffer), uint8_t(fileIndex));
+            filePathList.push_back(FileSystem::GetFileName(GetDataPath(), "files", String::Format("small_%v.bin", fileIndex)));
+            FileSystem::Save(filePathList.back(), buffer);
+        }
+    }
+
+    return filePathList;
+}
+
+static FileSystem::Path const &GetLargeFilePath(void)
+{
+    static FileSystem::Path filePath;
+    if (filePath.empty())
+    {
+        std::vector<uint8_t> buffer(64 * 1024 * 1024);
+        for (size_t index = 0; index < buffer.size(); ++index)
+        {
+            buffer[index] = uint8_t(index * 31);
+        }
+
+        filePath = FileSystem::GetFileName(GetDataPath(), "files", "large.bin");
+        FileSystem::Save(filePath, buffer);
+    }
+
+    return filePath;
+}
+
+static void FileSystem_LoadSmall(Benchmark::State &state)
+{
+    auto const &filePathList = GetSmallFilePathList();
+    for (auto _ : state)
+    {
+        for (auto const &filePath : filePathList)
+        {
+            Benchmark::DoNotOptimize(FileSystem::Load(filePath, std::vector<uint8_t>()));
+        }
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * filePathList.size());
+}
+
+GEK_BENCHMARK(FileSystem_LoadSmall);
+
+static void FileSystem_AsyncReadSmall(Benchmark::State &state)
+{
+    auto const &filePathList = GetSmallFilePathList();
+    auto reader = FileSystem::AsyncReader::Create();
+    for (auto _ : state)
+    {
+        Benchmark::DoNotOptimize(reader->read(filePathList).get());
+    }
+
+    state.setItemsProcessed(state.getIterationCount() * filePathList.size());
+}
+
+GEK_BENCHMARK(FileSystem_AsyncReadSmall);
+
+static void FileSystem_LoadLarge(Benchmark::State &state)
+{
+    auto const &filePath = GetLargeFilePath();
+    for (auto _ : state)
+    {
+        auto buffer(FileSystem::Load(filePath, std::vector<uint8_t>()));
+        Benchmark::DoNotOptimize(buffer.back());
+    }
+}
+
+GEK_BENCHMARK(FileSystem_LoadLarge);
+
+// Touches one byte per page, so every page of the mapping is actually read
+static void FileSystem_MapLarge(Benchmark::State &state)
+{
+    auto const &filePath = GetLargeFilePath();
+    for (auto _ : state)
+    {
+        uint64_t total = 0;
+        FileSystem::MappedFile mappedFile(filePath);
+        for (size_t offset = 0; offset < mappedFile.getSize(); offset += 4096)
+        {
+            total += mappedFile.getData()[offset];
+        }
+
+        Benchmark::DoNotOptimize(total);
+    }
+}
+
+GEK_BENCHMARK(FileSystem_MapLarge);
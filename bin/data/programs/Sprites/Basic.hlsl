@@ -5,20 +5,35 @@
 
 namespace Sprite
 {
+    // The particle pool is uploaded one stream at a time, each stream holds Capacity elements
+    static const uint Capacity = 1000000;
+
     struct Data
     {
         float3 position;
-        float3 velocity;
         float angle;
-        float torque;
         float halfSize;
         float age;
         float life;
         uint frames;
     };
 
-    StructuredBuffer<Data> list : register(t0);
+    StructuredBuffer<float> list : register(t0);
     Texture2D<float4> colorMap : register(t1);
+
+    Data load(uint index)
+    {
+        Data data;
+        data.position.x = list[index];
+        data.position.y = list[index + (Capacity * 1)];
+        data.position.z = list[index + (Capacity * 2)];
+        data.angle = list[index + (Capacity * 3)];
+        data.halfSize = list[index + (Capacity * 4)];
+        data.age = list[index + (Capacity * 5)];
+        data.life = list[index + (Capacity * 6)];
+        data.frames = uint(list[index + (Capacity * 7)]);
+        return data;
+    }
 };
 
 static const uint indexBuffer[6] = 
@@ -32,7 +47,7 @@ OutputVertex mainVertexProgram(InputVertex inputVertex)
     uint spriteIndex = (inputVertex.vertexIndex / 6);
     uint cornerIndex = indexBuffer[inputVertex.vertexIndex % 6];
     
-    Sprite::Data spriteData = Sprite::list[spriteIndex];
+    Sprite::Data spriteData = Sprite::load(spriteIndex);
     float age = (spriteData.age / spriteData.life);
     uint frameIndex = floor(age * pow(spriteData.frames, 2.0));
     float2 texCoord00 = float2((frameIndex % spriteData.frames),